@@ -22,6 +22,7 @@ let package = Package(
                 .define("LIBREMIDI_COREMIDI", to: "1"),
                 .headerSearchPath("include/libremidi_flutter"),
                 .headerSearchPath("libremidi_headers"),
+                .headerSearchPath("lrm_headers"),
                 .unsafeFlags(["-std=c++20"])
             ],
             linkerSettings: [
@@ -5,9 +5,10 @@ import 'dart:convert' show utf8;
 import 'dart:ffi';
 import 'dart:io';
 import 'dart:typed_data';
-import 'dart:async' show Stream, StreamController;
+import 'dart:async' show Completer, Stream, StreamController, Timer;
 
 import 'package:ffi/ffi.dart';
+import 'package:flutter/foundation.dart' show visibleForTesting;
 
 import 'libremidi_flutter_bindings_generated.dart';
 
@@ -211,6 +212,70 @@ class MidiPort {
   int get hashCode => stableId.hashCode ^ isInput.hashCode;
 }
 
+/// Immutable copy of an observer's port lists.
+///
+/// See [MidiObserver.snapshot].
+class MidiPortSnapshot {
+  /// [MidiObserver.generation] when the snapshot was taken.
+  final int generation;
+
+  /// Input ports, in enumeration order.
+  final List<MidiPort> inputs;
+
+  /// Output ports, in enumeration order.
+  final List<MidiPort> outputs;
+
+  const MidiPortSnapshot._(this.generation, this.inputs, this.outputs);
+
+  /// Copies the port lists out of a native snapshot (see
+  /// `lrm_observer_snapshot`).
+  @visibleForTesting
+  factory MidiPortSnapshot.fromNative(LrmPortSnapshot native) {
+    final table =
+        native.strings.cast<Uint8>().asTypedList(native.strings_size);
+    // Records share deduplicated strings; decode each one once
+    final strings = <int, String>{0: ''};
+    String string(int offset) => strings[offset] ??= utf8.decode(
+          Uint8List.sublistView(table, offset, table.indexOf(0, offset)),
+          allowMalformed: true,
+        );
+
+    MidiPort port(LrmPortRecord record) => MidiPort._(
+          stableId: record.stable_id,
+          portId: record.port_id,
+          clientHandle: record.client_handle,
+          index: record.index,
+          displayName: string(record.display_name),
+          portName: string(record.port_name),
+          deviceName: string(record.device_name),
+          manufacturer: string(record.manufacturer),
+          product: string(record.product),
+          serial: string(record.serial),
+          transportType: MidiTransportType.fromValue(record.transport_type),
+          rawTransportType: record.transport_type,
+          isInput: record.is_input,
+          isVirtual: record.is_virtual,
+        );
+
+    final inputCount = native.input_count;
+    final outputCount = native.output_count;
+    return MidiPortSnapshot._(
+      native.generation,
+      List.unmodifiable([
+        for (var i = 0; i < inputCount; i++) port(native.ports[i]),
+      ]),
+      List.unmodifiable([
+        for (var i = 0; i < outputCount; i++)
+          port(native.ports[inputCount + i]),
+      ]),
+    );
+  }
+
+  @override
+  String toString() => 'MidiPortSnapshot(generation: $generation, '
+      '${inputs.length} inputs, ${outputs.length} outputs)';
+}
+
 // =============================================================================
 // MidiMessage - Represents a MIDI message
 // =============================================================================
@@ -220,13 +285,15 @@ class MidiMessage {
   /// The raw MIDI data bytes.
   final Uint8List data;
 
-  /// The timestamp of the message (in microseconds).
+  /// The timestamp of the message in nanoseconds.
   ///
-  /// The clock source is platform-dependent:
+  /// The clock domain is chosen when the input is opened (see
+  /// [MidiTimestampMode]). With the default [MidiTimestampMode.absolute] the
+  /// clock source is platform-dependent:
   /// - macOS/iOS: CoreMIDI host time (mach_absolute_time based)
-  /// - Windows: WinMM timeGetTime (milliseconds, converted to microseconds)
-  /// - Linux: ALSA sequencer timestamp
-  /// - Android: AMidi timestamp (nanoseconds, converted to microseconds)
+  /// - Windows: time since the port was opened
+  /// - Linux: time since the port's ALSA sequencer queue was created
+  /// - Android: AMidi timestamp
   final int timestamp;
 
   const MidiMessage(this.data, {this.timestamp = 0});
@@ -277,6 +344,29 @@ class MidiMessage {
   /// The value for Control Change messages.
   int get value => data.length >= 3 ? data[2] : 0;
 
+  /// Decodes a buffer of packed message records as produced by the native
+  /// batch APIs.
+  ///
+  /// Each record is an int64 timestamp, a uint32 length and then `length`
+  /// data bytes, in host byte order and without padding. A truncated trailing
+  /// record is ignored.
+  static List<MidiMessage> decodePacked(Uint8List packed) {
+    final view = ByteData.sublistView(packed);
+    final messages = <MidiMessage>[];
+    var offset = 0;
+    while (offset + LRM_PACKED_HEADER_SIZE <= packed.length) {
+      final timestamp = view.getInt64(offset, Endian.host);
+      final length = view.getUint32(offset + 8, Endian.host);
+      final start = offset + LRM_PACKED_HEADER_SIZE;
+      if (start + length > packed.length) break;
+      messages.add(
+        MidiMessage(packed.sublist(start, start + length), timestamp: timestamp),
+      );
+      offset = start + length;
+    }
+    return messages;
+  }
+
   @override
   String toString() {
     final hex = data.map((b) => b.toRadixString(16).padLeft(2, '0')).join(' ');
@@ -284,6 +374,825 @@ class MidiMessage {
   }
 }
 
+/// Clock domain of [MidiMessage.timestamp] for an input.
+enum MidiTimestampMode {
+  /// Nanoseconds on the backend's own reference, e.g. since the ALSA
+  /// sequencer queue of the port was created. Most precise ordering within
+  /// one port, but not comparable across ports.
+  absolute,
+
+  /// Nanoseconds on the [LibremidiFlutter.nowNanoseconds] clock, comparable
+  /// across ports and with timestamps taken in Dart.
+  monotonic,
+
+  /// Nanoseconds since the previous message of the same port (0 for the
+  /// first one).
+  relative,
+
+  /// No timestamps; every timestamp is 0.
+  none;
+
+  int get nativeValue {
+    switch (this) {
+      case MidiTimestampMode.absolute:
+        return LRM_TIMESTAMP_ABSOLUTE;
+      case MidiTimestampMode.monotonic:
+        return LRM_TIMESTAMP_MONOTONIC;
+      case MidiTimestampMode.relative:
+        return LRM_TIMESTAMP_RELATIVE;
+      case MidiTimestampMode.none:
+        return LRM_TIMESTAMP_NONE;
+    }
+  }
+}
+
+/// What a buffered [MidiInput] does when its native ring buffer is full.
+enum MidiOverflowPolicy {
+  /// Discard the oldest buffered messages to make room for new ones.
+  dropOldest,
+
+  /// Keep the buffered messages and discard the incoming one.
+  dropNewest;
+
+  int get nativeValue {
+    switch (this) {
+      case MidiOverflowPolicy.dropOldest:
+        return LRM_OVERFLOW_DROP_OLDEST;
+      case MidiOverflowPolicy.dropNewest:
+        return LRM_OVERFLOW_DROP_NEWEST;
+    }
+  }
+}
+
+/// What an asynchronous [MidiOutput] does when its send queue is full.
+enum MidiBackpressurePolicy {
+  /// Wait until the writer thread has made room.
+  block,
+
+  /// Discard the message and count it in [MidiOutputStats.queueOverflows].
+  drop,
+
+  /// Discard the message and throw a [MidiException].
+  fail;
+
+  int get nativeValue {
+    switch (this) {
+      case MidiBackpressurePolicy.block:
+        return LRM_BACKPRESSURE_BLOCK;
+      case MidiBackpressurePolicy.drop:
+        return LRM_BACKPRESSURE_DROP;
+      case MidiBackpressurePolicy.fail:
+        return LRM_BACKPRESSURE_FAIL;
+    }
+  }
+}
+
+/// How a streamed SysEx message that exceeds its size cap ends.
+enum MidiSysExOverflowPolicy {
+  /// End with a chunk flagged [SysExChunk.isAborted]; discard the message.
+  abort,
+
+  /// End with a chunk flagged [SysExChunk.isTruncated]; keep what arrived.
+  truncate;
+
+  int get nativeValue {
+    switch (this) {
+      case MidiSysExOverflowPolicy.abort:
+        return LRM_SYSEX_OVERFLOW_ABORT;
+      case MidiSysExOverflowPolicy.truncate:
+        return LRM_SYSEX_OVERFLOW_TRUNCATE;
+    }
+  }
+}
+
+/// One chunk of a SysEx message streamed by
+/// [MidiObserver.openSysExStreamInput].
+///
+/// Chunks of a message arrive in order. The first chunk starts with 0xF0 and,
+/// unless the message was cut short, the last one ends with 0xF7.
+class SysExChunk {
+  final Uint8List data;
+
+  /// Combination of the native `LRM_SYSEX_CHUNK_*` flags.
+  final int flags;
+
+  /// Timestamp of the start of the message.
+  final int timestamp;
+
+  const SysExChunk(this.data, {required this.flags, this.timestamp = 0});
+
+  /// Whether this is the first chunk of a message.
+  bool get isFirst => flags & LRM_SYSEX_CHUNK_BEGIN != 0;
+
+  /// Whether this is the last chunk of a message.
+  bool get isLast => flags & LRM_SYSEX_CHUNK_END != 0;
+
+  /// Whether the message was cut off and everything received for it should
+  /// be discarded.
+  bool get isAborted => flags & LRM_SYSEX_CHUNK_ABORTED != 0;
+
+  /// Whether the message exceeded its size cap and ends here without 0xF7.
+  bool get isTruncated => flags & LRM_SYSEX_CHUNK_TRUNCATED != 0;
+
+  @override
+  String toString() => 'SysExChunk(${data.length} bytes, flags: $flags)';
+}
+
+/// Snapshot of an incoming MIDI clock tracked by
+/// [MidiObserver.openClockInput], or of a [MidiClockGenerator].
+class MidiClockState {
+  /// Smoothed tempo in beats per minute, 0 until two ticks were received.
+  final double bpm;
+
+  /// Position within the current beat, from 0.0 to 1.0.
+  final double beatPhase;
+
+  /// Mean deviation of the tick interval in microseconds. For a generator,
+  /// the mean lateness of the ticks it sent.
+  final double jitterMicroseconds;
+
+  /// Clock ticks received since the input was opened, or sent.
+  final int tickCount;
+
+  /// Song position in sixteenth notes (MIDI beats).
+  final int songPosition;
+
+  /// Whether the transport is running (between Start/Continue and Stop).
+  final bool isRunning;
+
+  const MidiClockState({
+    required this.bpm,
+    required this.beatPhase,
+    required this.jitterMicroseconds,
+    required this.tickCount,
+    required this.songPosition,
+    required this.isRunning,
+  });
+
+  @override
+  String toString() => 'MidiClockState(bpm: ${bpm.toStringAsFixed(2)}, '
+      'phase: ${beatPhase.toStringAsFixed(3)}, position: $songPosition, '
+      'running: $isRunning)';
+}
+
+/// Frame rate of MIDI Time Code.
+enum MidiTimecodeRate {
+  /// 24 frames per second (film).
+  fps24,
+
+  /// 25 frames per second (PAL video).
+  fps25,
+
+  /// 29.97 frames per second drop-frame (NTSC video).
+  fps2997Drop,
+
+  /// 30 frames per second.
+  fps30;
+
+  int get nativeValue {
+    switch (this) {
+      case MidiTimecodeRate.fps24:
+        return LRM_MTC_24FPS;
+      case MidiTimecodeRate.fps25:
+        return LRM_MTC_25FPS;
+      case MidiTimecodeRate.fps2997Drop:
+        return LRM_MTC_30FPS_DROP;
+      case MidiTimecodeRate.fps30:
+        return LRM_MTC_30FPS;
+    }
+  }
+
+  static MidiTimecodeRate fromNative(int value) {
+    switch (value) {
+      case LRM_MTC_24FPS:
+        return MidiTimecodeRate.fps24;
+      case LRM_MTC_25FPS:
+        return MidiTimecodeRate.fps25;
+      case LRM_MTC_30FPS_DROP:
+        return MidiTimecodeRate.fps2997Drop;
+      default:
+        return MidiTimecodeRate.fps30;
+    }
+  }
+
+  /// Frames counted per second (30 for drop-frame).
+  int get framesPerSecond {
+    switch (this) {
+      case MidiTimecodeRate.fps24:
+        return 24;
+      case MidiTimecodeRate.fps25:
+        return 25;
+      case MidiTimecodeRate.fps2997Drop:
+      case MidiTimecodeRate.fps30:
+        return 30;
+    }
+  }
+}
+
+/// SMPTE position read from incoming MIDI Time Code
+/// ([MidiObserver.openTimecodeInput]) or sent by [MidiOutput.startTimecode].
+class MidiTimecode {
+  final int hours;
+  final int minutes;
+  final int seconds;
+  final int frames;
+  final MidiTimecodeRate rate;
+
+  /// For an input, whether quarter frames are arriving in sequence; for an
+  /// output, whether timecode is being sent.
+  final bool isLocked;
+
+  /// Quarter-frame messages received or sent.
+  final int quarterFrames;
+
+  const MidiTimecode({
+    required this.hours,
+    required this.minutes,
+    required this.seconds,
+    required this.frames,
+    required this.rate,
+    this.isLocked = false,
+    this.quarterFrames = 0,
+  });
+
+  @override
+  String toString() {
+    String two(int value) => value.toString().padLeft(2, '0');
+    final separator = rate == MidiTimecodeRate.fps2997Drop ? ';' : ':';
+    return '${two(hours)}:${two(minutes)}:${two(seconds)}$separator'
+        '${two(frames)}';
+  }
+
+  /// Reads a position reported by the native reader or generator.
+  @visibleForTesting
+  static MidiTimecode fromNative(LrmTimecode timecode) => MidiTimecode(
+        hours: timecode.hours,
+        minutes: timecode.minutes,
+        seconds: timecode.seconds,
+        frames: timecode.frames,
+        rate: MidiTimecodeRate.fromNative(timecode.rate),
+        isLocked: timecode.locked,
+        quarterFrames: timecode.quarter_frames,
+      );
+
+  /// Writes this position to [timecode] for the native generator.
+  @visibleForTesting
+  void fill(LrmTimecode timecode) {
+    timecode
+      ..hours = hours
+      ..minutes = minutes
+      ..seconds = seconds
+      ..frames = frames
+      ..rate = rate.nativeValue;
+  }
+}
+
+// =============================================================================
+// MidiInputFilter - Native input filtering
+// =============================================================================
+
+/// Kinds of MIDI messages that a [MidiInputFilter] can let through.
+enum MidiMessageKind {
+  noteOff,
+  noteOn,
+  polyAftertouch,
+  controlChange,
+  programChange,
+  channelPressure,
+  pitchBend,
+  sysEx,
+  systemCommon,
+  realtime;
+
+  /// The matching `LRM_FILTER_*` bit (declaration order follows the header).
+  int get nativeValue => 1 << index;
+}
+
+/// Filter evaluated natively before messages cross into Dart.
+///
+/// Unlike [MidiInput.messagesFiltered], rejected messages are never copied or
+/// posted to the isolate, so high-rate traffic you are not interested in
+/// (e.g. polyphonic aftertouch from MPE controllers) costs nothing on the
+/// Dart side. All criteria must match for a message to pass.
+class MidiInputFilter {
+  /// Accepted channels (0-15) for channel messages, or `null` for all.
+  final Set<int>? channels;
+
+  /// Accepted message kinds, or `null` for all.
+  final Set<MidiMessageKind>? kinds;
+
+  /// Accepted note range for Note On/Off and Polyphonic Aftertouch.
+  final int minNote;
+  final int maxNote;
+
+  /// Accepted controller range for Control Change.
+  final int minController;
+  final int maxController;
+
+  /// Largest accepted message in bytes, or `null` for no limit.
+  final int? maxBytes;
+
+  const MidiInputFilter({
+    this.channels,
+    this.kinds,
+    this.minNote = 0,
+    this.maxNote = 127,
+    this.minController = 0,
+    this.maxController = 127,
+    this.maxBytes,
+  });
+
+  /// Bit mask of accepted channels, bit n = channel n.
+  int get channelMask {
+    final selected = channels;
+    if (selected == null) return 0xFFFF;
+    var mask = 0;
+    for (final channel in selected) {
+      if (channel < 0 || channel > 15) {
+        throw ArgumentError.value(channel, 'channels', 'Must be 0-15');
+      }
+      mask |= 1 << channel;
+    }
+    return mask;
+  }
+
+  /// Bit mask of accepted message kinds (`LRM_FILTER_*`).
+  int get statusMask {
+    final selected = kinds;
+    if (selected == null) return LRM_FILTER_ALL;
+    return selected.fold(0, (mask, kind) => mask | kind.nativeValue);
+  }
+
+  void _fill(LrmMidiFilter filter) {
+    filter.status_mask = statusMask;
+    filter.channel_mask = channelMask;
+    filter.note_min = minNote.clamp(0, 127);
+    filter.note_max = maxNote.clamp(0, 127);
+    filter.controller_min = minController.clamp(0, 127);
+    filter.controller_max = maxController.clamp(0, 127);
+    filter.max_size = maxBytes ?? 0;
+  }
+}
+
+/// Number of messages a [MidiInputFilter] rejected, per criterion.
+class MidiFilterStats {
+  final int rejectedKind;
+  final int rejectedChannel;
+  final int rejectedNote;
+  final int rejectedController;
+  final int rejectedSize;
+
+  const MidiFilterStats({
+    required this.rejectedKind,
+    required this.rejectedChannel,
+    required this.rejectedNote,
+    required this.rejectedController,
+    required this.rejectedSize,
+  });
+
+  /// Total number of rejected messages.
+  int get total =>
+      rejectedKind +
+      rejectedChannel +
+      rejectedNote +
+      rejectedController +
+      rejectedSize;
+
+  @override
+  String toString() => 'MidiFilterStats(kind: $rejectedKind, '
+      'channel: $rejectedChannel, note: $rejectedNote, '
+      'controller: $rejectedController, size: $rejectedSize)';
+}
+
+// =============================================================================
+// Port statistics
+// =============================================================================
+
+/// Counters of a [MidiInput] since it was opened.
+///
+/// Latencies measure the time native code spends between receiving a message
+/// from the backend and handing it to its destination (callback, buffer or
+/// batch). Percentiles are accurate to within 25%.
+class MidiInputStats {
+  /// Messages received from the backend, including filtered ones.
+  final int messages;
+
+  /// Bytes received from the backend.
+  final int bytes;
+
+  /// SysEx messages received, or chunks delivered when streaming SysEx.
+  final int sysExFragments;
+
+  /// Messages discarded because the native buffer was full.
+  final int dropped;
+
+  /// Messages rejected by the filter or consumed by native decoding.
+  final int filtered;
+
+  /// Longest delivery latency in nanoseconds, from the backend handing the
+  /// message over (its timestamp with [MidiTimestampMode.monotonic]) until
+  /// it was delivered or buffered. Forwarding to routes is not included.
+  final int maxLatencyNanoseconds;
+
+  /// 99th percentile of the delivery latency in nanoseconds.
+  final int p99LatencyNanoseconds;
+
+  const MidiInputStats({
+    required this.messages,
+    required this.bytes,
+    required this.sysExFragments,
+    required this.dropped,
+    required this.filtered,
+    required this.maxLatencyNanoseconds,
+    required this.p99LatencyNanoseconds,
+  });
+
+  @override
+  String toString() => 'MidiInputStats(messages: $messages, bytes: $bytes, '
+      'sysex: $sysExFragments, dropped: $dropped, filtered: $filtered, '
+      'max: ${maxLatencyNanoseconds}ns, p99: ${p99LatencyNanoseconds}ns)';
+}
+
+/// Counters of a [MidiOutput] since it was opened.
+///
+/// Send times measure the backend send call only. Percentiles are accurate to
+/// within 25%.
+class MidiOutputStats {
+  /// Messages sent successfully.
+  final int messages;
+
+  /// Bytes sent successfully.
+  final int bytes;
+
+  /// SysEx messages sent successfully.
+  final int sysExMessages;
+
+  /// Sends rejected by the backend.
+  final int sendFailures;
+
+  /// Total time spent inside the backend send call in nanoseconds.
+  final int sendTimeNanoseconds;
+
+  /// Longest single send call in nanoseconds.
+  final int maxSendNanoseconds;
+
+  /// 99th percentile of the send call duration in nanoseconds.
+  final int p99SendNanoseconds;
+
+  /// Asynchronous sends still waiting for the writer thread.
+  final int queuePending;
+
+  /// Asynchronous sends the backend accepted.
+  final int queueCompleted;
+
+  /// Asynchronous sends the backend rejected.
+  final int queueFailed;
+
+  /// Sends refused because the asynchronous queue was full.
+  final int queueOverflows;
+
+  const MidiOutputStats({
+    required this.messages,
+    required this.bytes,
+    required this.sysExMessages,
+    required this.sendFailures,
+    required this.sendTimeNanoseconds,
+    required this.maxSendNanoseconds,
+    required this.p99SendNanoseconds,
+    this.queuePending = 0,
+    this.queueCompleted = 0,
+    this.queueFailed = 0,
+    this.queueOverflows = 0,
+  });
+
+  @override
+  String toString() => 'MidiOutputStats(messages: $messages, bytes: $bytes, '
+      'sysex: $sysExMessages, failures: $sendFailures, '
+      'max: ${maxSendNanoseconds}ns, p99: ${p99SendNanoseconds}ns, '
+      'queued: $queuePending, overflows: $queueOverflows)';
+}
+
+// =============================================================================
+// Output optimizer
+// =============================================================================
+
+/// Settings of the native output optimizer (see [MidiOutput.optimizer]).
+///
+/// Applies to continuous controller traffic: Control Change, Pitch Bend,
+/// Channel Pressure and Polyphonic Aftertouch, tracked per channel and
+/// controller (or note). Other messages are never dropped and keep their
+/// order relative to everything sent before and after them.
+class MidiOutputOptimizer {
+  /// Drop a value equal to the last one sent for the same controller.
+  final bool dropDuplicates;
+
+  /// Send at most one value per controller within this interval; values
+  /// arriving in between replace the one waiting. [Duration.zero] disables
+  /// coalescing.
+  final Duration coalesceInterval;
+
+  /// Pace all output to this many bytes per second, or `null` for no limit.
+  /// 3125 matches a 5-pin DIN MIDI cable.
+  final int? maxBytesPerSecond;
+
+  const MidiOutputOptimizer({
+    this.dropDuplicates = true,
+    this.coalesceInterval = Duration.zero,
+    this.maxBytesPerSecond,
+  });
+
+  /// Writes these settings to [settings].
+  @visibleForTesting
+  void fill(LrmMidiOptimizer settings) {
+    final rate = maxBytesPerSecond ?? 0;
+    if (rate < 0) {
+      throw ArgumentError.value(rate, 'maxBytesPerSecond', 'Must be positive');
+    }
+    if (coalesceInterval.isNegative) {
+      throw ArgumentError.value(
+        coalesceInterval,
+        'coalesceInterval',
+        'Must not be negative',
+      );
+    }
+    settings.drop_duplicates = dropDuplicates;
+    settings.coalesce_interval_us =
+        coalesceInterval.inMicroseconds.clamp(0, 0xFFFFFFFF);
+    settings.max_bytes_per_second = rate.clamp(0, 0xFFFFFFFF);
+  }
+}
+
+/// Counters of a [MidiOutputOptimizer] since it was installed.
+class MidiOptimizerStats {
+  /// Messages dropped as repeated values.
+  final int duplicates;
+
+  /// Messages replaced by a newer value before being sent.
+  final int coalesced;
+
+  /// Messages held back by the coalescing interval or the byte rate.
+  final int delayed;
+
+  /// Messages waiting to be sent.
+  final int pending;
+
+  const MidiOptimizerStats({
+    required this.duplicates,
+    required this.coalesced,
+    required this.delayed,
+    required this.pending,
+  });
+
+  @override
+  String toString() => 'MidiOptimizerStats(duplicates: $duplicates, '
+      'coalesced: $coalesced, delayed: $delayed, pending: $pending)';
+}
+
+// =============================================================================
+// Paced SysEx output
+// =============================================================================
+
+/// State of a [MidiSysExTransfer].
+enum MidiSysExTransferState {
+  /// Waiting for earlier transfers on the same output.
+  queued,
+
+  /// Being sent.
+  sending,
+
+  /// Every byte was handed to the driver.
+  done,
+
+  /// The driver rejected part of the transfer.
+  failed,
+
+  /// Cancelled, or the output was closed before the transfer finished.
+  cancelled;
+
+  static MidiSysExTransferState fromNative(int value) {
+    switch (value) {
+      case LRM_SYSEX_TX_QUEUED:
+        return MidiSysExTransferState.queued;
+      case LRM_SYSEX_TX_SENDING:
+        return MidiSysExTransferState.sending;
+      case LRM_SYSEX_TX_DONE:
+        return MidiSysExTransferState.done;
+      case LRM_SYSEX_TX_FAILED:
+        return MidiSysExTransferState.failed;
+      default:
+        return MidiSysExTransferState.cancelled;
+    }
+  }
+
+  /// Whether the transfer has ended.
+  bool get isFinished =>
+      this != MidiSysExTransferState.queued &&
+      this != MidiSysExTransferState.sending;
+}
+
+/// A SysEx transfer started by [MidiOutput.sendSysExPaced].
+///
+/// The transfer runs on a native thread; its progress is read on demand.
+class MidiSysExTransfer {
+  final MidiOutput _output;
+
+  /// Native transfer id, unique per output.
+  final int id;
+
+  /// Size of the transfer in bytes.
+  final int totalBytes;
+
+  // Last polled values; frozen once the transfer has ended
+  MidiSysExTransferState _state = MidiSysExTransferState.queued;
+  int _bytesSent = 0;
+  bool _finished = false;
+
+  MidiSysExTransfer._(this._output, this.id, this.totalBytes);
+
+  /// Current state.
+  MidiSysExTransferState get state {
+    _poll();
+    return _state;
+  }
+
+  /// Bytes handed to the driver so far.
+  int get bytesSent {
+    _poll();
+    return _bytesSent;
+  }
+
+  /// Fraction of the transfer sent, from 0 to 1.
+  double get progress => totalBytes == 0 ? 1 : bytesSent / totalBytes;
+
+  void _poll() {
+    if (_finished) return;
+    final handle = _output._disposed ? null : _output._handle;
+    if (handle == null) {
+      _state = MidiSysExTransferState.cancelled;
+      _finished = true;
+      return;
+    }
+    final status = calloc<LrmSysexTransferStatus>();
+    try {
+      final result =
+          _bindings.lrm_midi_out_get_sysex_transfer(handle, id, status);
+      if (result != LRM_OK) {
+        // Only the most recent finished transfers are remembered natively
+        _state = MidiSysExTransferState.cancelled;
+        _finished = true;
+        return;
+      }
+      _state = MidiSysExTransferState.fromNative(status.ref.state);
+      _bytesSent = status.ref.bytes_sent;
+      _finished = _state.isFinished;
+    } finally {
+      calloc.free(status);
+    }
+  }
+
+  /// Completes with the final state once the transfer has ended, checking
+  /// every [pollInterval].
+  Future<MidiSysExTransferState> done({
+    Duration pollInterval = const Duration(milliseconds: 20),
+  }) {
+    final current = state;
+    if (current.isFinished) return Future.value(current);
+    final completer = Completer<MidiSysExTransferState>();
+    Timer.periodic(pollInterval, (timer) {
+      final current = state;
+      if (current.isFinished) {
+        timer.cancel();
+        completer.complete(current);
+      }
+    });
+    return completer.future;
+  }
+
+  /// Stops the transfer. A SysEx message cut short is terminated with 0xF7.
+  void cancel() {
+    if (_finished || _output._disposed) return;
+    _bindings.lrm_midi_out_cancel_sysex(_output._handle!, id);
+  }
+
+  @override
+  String toString() =>
+      'MidiSysExTransfer($id, $state, $bytesSent/$totalBytes)';
+}
+
+// =============================================================================
+// Automation curves
+// =============================================================================
+
+/// What a [MidiAutomation] curve drives.
+enum MidiAutomationTarget {
+  /// A 7-bit Control Change (number 0-127).
+  controlChange,
+
+  /// A 14-bit Control Change pair: number 0-31 and number + 32.
+  controlChange14,
+
+  /// Pitch bend; 0.5 is the centre.
+  pitchBend,
+
+  /// A 14-bit NRPN parameter (number 0-16383).
+  nrpn;
+
+  int get nativeValue {
+    switch (this) {
+      case MidiAutomationTarget.controlChange:
+        return LRM_AUTOMATION_CC;
+      case MidiAutomationTarget.controlChange14:
+        return LRM_AUTOMATION_CC14;
+      case MidiAutomationTarget.pitchBend:
+        return LRM_AUTOMATION_PITCH_BEND;
+      case MidiAutomationTarget.nrpn:
+        return LRM_AUTOMATION_NRPN;
+    }
+  }
+}
+
+/// Shape of the segment leading to a [MidiAutomationPoint].
+enum MidiCurveShape {
+  linear,
+  exponential;
+
+  int get nativeValue => this == MidiCurveShape.linear
+      ? LRM_SEGMENT_LINEAR
+      : LRM_SEGMENT_EXPONENTIAL;
+}
+
+/// Breakpoint of an automation curve.
+class MidiAutomationPoint {
+  /// Value from 0.0 to 1.0 of the target's range.
+  final double value;
+
+  /// Time from the previous point; for the first point, a delay before the
+  /// curve starts.
+  final Duration after;
+
+  /// Shape of the segment ending at this point.
+  final MidiCurveShape shape;
+
+  /// Steepness of an exponential segment: positive values start slowly,
+  /// negative ones quickly. 0 uses a default of 4.
+  final double curvature;
+
+  const MidiAutomationPoint(
+    this.value, {
+    this.after = Duration.zero,
+    this.shape = MidiCurveShape.linear,
+    this.curvature = 0,
+  });
+}
+
+/// Counters of an output's automation curves.
+class MidiAutomationStats {
+  /// Values sent.
+  final int updates;
+
+  /// Samples not sent because the value had not changed.
+  final int unchanged;
+
+  /// Curves currently running.
+  final int running;
+
+  const MidiAutomationStats({
+    required this.updates,
+    required this.unchanged,
+    required this.running,
+  });
+
+  @override
+  String toString() => 'MidiAutomationStats(updates: $updates, '
+      'unchanged: $unchanged, running: $running)';
+}
+
+/// A curve rendered natively by [MidiOutput.automate].
+class MidiAutomation {
+  final MidiOutput _output;
+
+  /// Native curve id, unique per output.
+  final int id;
+
+  MidiAutomation._(this._output, this.id);
+
+  /// Whether the curve is still being sent. It stops when it reaches its
+  /// last point, is cancelled, or another curve takes over its target.
+  bool get isRunning {
+    final handle = _output._disposed ? null : _output._handle;
+    return handle != null && _bindings.lrm_midi_out_is_automating(handle, id);
+  }
+
+  /// Stops the curve where it is.
+  void cancel() {
+    if (_output._disposed) return;
+    _bindings.lrm_midi_out_cancel_automation(_output._handle!, id);
+  }
+
+  @override
+  String toString() => 'MidiAutomation($id)';
+}
+
 // =============================================================================
 // RPN / NRPN parsing
 // =============================================================================
@@ -523,19 +1432,96 @@ class RpnNrpnParser {
   }
 }
 
-// =============================================================================
-// MidiException - MIDI-related errors
-// =============================================================================
-
-/// Exception thrown when a MIDI operation fails.
-class MidiException implements Exception {
-  final String message;
-  final int? errorCode;
-  final String? nativeFunction;
+/// A 14-bit Control Change value decoded from an MSB/LSB controller pair.
+///
+/// Controllers 0-31 carry the MSB and controllers 32-63 the matching LSB.
+/// [controller] is the MSB controller number and [value] is on the 14-bit
+/// scale (0-16383) even when only the MSB has been received so far.
+class ControlChange14Message {
+  final int channel;
+  final int controller;
+  final int value;
 
-  const MidiException(this.message, {this.errorCode, this.nativeFunction});
+  /// Timestamp of the completing Control Change message.
+  final int timestamp;
 
-  @override
+  const ControlChange14Message({
+    required this.channel,
+    required this.controller,
+    required this.value,
+    this.timestamp = 0,
+  });
+
+  @override
+  String toString() =>
+      'ControlChange14Message(channel: $channel, controller: $controller, value: $value)';
+}
+
+/// Settings for decoding RPN/NRPN and 14-bit controllers natively.
+///
+/// Decoded events are delivered on [MidiInput.rpnNrpnMessages] and
+/// [MidiInput.controlChange14Messages]. With [suppressRaw] the Control Change
+/// messages consumed by the decoder are not delivered on [MidiInput.messages],
+/// which cuts the number of messages crossing into Dart by 3-4x for devices
+/// that send high-resolution parameters.
+class MidiParameterDecoding {
+  /// Decode RPN and NRPN sequences.
+  final bool rpnNrpn;
+
+  /// MSB controllers (0-31) to pair with their LSB (controller + 32).
+  final Set<int> fourteenBitControllers;
+
+  /// Drop the raw Control Change messages consumed by the decoder.
+  final bool suppressRaw;
+
+  /// Report Data Entry and 14-bit controller values only once the LSB
+  /// arrives, instead of once for the MSB and again for the LSB. Only use
+  /// this with devices that always send both halves.
+  final bool waitForLsb;
+
+  const MidiParameterDecoding({
+    this.rpnNrpn = true,
+    this.fourteenBitControllers = const {},
+    this.suppressRaw = true,
+    this.waitForLsb = false,
+  });
+
+  /// Decoder options (`LRM_DECODE_*`).
+  int get flags =>
+      (rpnNrpn ? LRM_DECODE_RPN : 0) |
+      (suppressRaw ? LRM_DECODE_SUPPRESS_RAW : 0) |
+      (waitForLsb ? LRM_DECODE_WAIT_FOR_LSB : 0);
+
+  /// Bit mask of paired MSB controllers, bit n = controller n.
+  int get fourteenBitMask {
+    var mask = 0;
+    for (final controller in fourteenBitControllers) {
+      if (controller < 0 || controller > 31) {
+        throw ArgumentError.value(
+          controller,
+          'fourteenBitControllers',
+          'Must be 0-31',
+        );
+      }
+      mask |= 1 << controller;
+    }
+    return mask;
+  }
+}
+
+// =============================================================================
+// MidiException - MIDI-related errors
+// =============================================================================
+
+/// Exception thrown when a MIDI operation fails.
+class MidiException implements Exception {
+  final String message;
+  final int? errorCode;
+  final String? nativeFunction;
+
+  const MidiException(this.message, {this.errorCode, this.nativeFunction});
+
+  @override
   String toString() {
     final parts = <String>['MidiException: $message'];
     if (nativeFunction != null) {
@@ -582,6 +1568,36 @@ enum HotplugEventType {
   }
 }
 
+/// A hotplug event together with the port it is about.
+class HotplugEvent {
+  /// What happened.
+  final HotplugEventType type;
+
+  /// [MidiPort.portId] of the port that was added or removed, or 0 when the
+  /// backend cannot tell (always for [HotplugEventType.setupChanged]).
+  final int portId;
+
+  const HotplugEvent(this.type, this.portId);
+
+  /// Whether [portId] identifies the port; otherwise re-enumerate.
+  bool get hasPort => portId != 0;
+
+  /// Native event type sent once by an observer from
+  /// [MidiObserver.startAsync].
+  static const int _readyEvent = 5;
+
+  /// Converts a native hotplug callback, or returns `null` for the ready
+  /// notification of [MidiObserver.startAsync].
+  @visibleForTesting
+  static HotplugEvent? fromNative(int eventType, int portId) {
+    if (eventType == _readyEvent) return null;
+    return HotplugEvent(HotplugEventType.fromValue(eventType), portId);
+  }
+
+  @override
+  String toString() => 'HotplugEvent($type, portId: $portId)';
+}
+
 // =============================================================================
 // MidiObserver - Enumerate MIDI ports
 // =============================================================================
@@ -590,11 +1606,16 @@ enum HotplugEventType {
 class MidiObserver {
   Pointer<LrmObserver>? _handle;
   bool _disposed = false;
-  NativeCallable<Void Function(Pointer<Void>, Int32)>? _hotplugCallable;
-  final StreamController<HotplugEventType> _hotplugController =
-      StreamController<HotplugEventType>.broadcast();
+  NativeCallable<Void Function(Pointer<Void>, Int32, Uint64)>?
+      _hotplugCallable;
+  final StreamController<HotplugEvent> _hotplugController =
+      StreamController<HotplugEvent>.broadcast();
+  MidiPortSnapshot? _snapshot;
+  Completer<MidiObserver>? _ready;
 
   /// Creates a new MIDI observer without hotplug detection.
+  ///
+  /// The port lists only change when [refresh] is called.
   MidiObserver() {
     _handle = _bindings.lrm_observer_new();
     if (_handle == nullptr) {
@@ -605,7 +1626,7 @@ class MidiObserver {
   /// Creates a new MIDI observer with hotplug detection.
   MidiObserver.withHotplug() {
     _hotplugCallable =
-        NativeCallable<Void Function(Pointer<Void>, Int32)>.listener(
+        NativeCallable<Void Function(Pointer<Void>, Int32, Uint64)>.listener(
       _onHotplugEvent,
     );
 
@@ -620,10 +1641,64 @@ class MidiObserver {
     }
   }
 
-  void _onHotplugEvent(Pointer<Void> context, int eventType) {
-    if (!_disposed) {
-      _hotplugController.add(HotplugEventType.fromValue(eventType));
+  /// Starts a MIDI observer without blocking the calling isolate.
+  ///
+  /// Connecting to the MIDI backend and enumerating the ports run on a
+  /// native thread; the future completes once the port lists are filled.
+  /// With [hotplug] false the observer only enumerates, like [MidiObserver],
+  /// and [onHotplug] never fires.
+  ///
+  /// Completes with a [MidiException] if the observer could not be started.
+  static Future<MidiObserver> startAsync({bool hotplug = true}) async {
+    return MidiObserver._async(hotplug)._ready!.future;
+  }
+
+  MidiObserver._async(bool hotplug) : _ready = Completer<MidiObserver>() {
+    _hotplugCallable =
+        NativeCallable<Void Function(Pointer<Void>, Int32, Uint64)>.listener(
+      _onHotplugEvent,
+    );
+
+    _handle = _bindings.lrm_observer_new_async(
+      _hotplugCallable!.nativeFunction,
+      nullptr,
+      hotplug,
+    );
+
+    if (_handle == nullptr) {
+      _hotplugCallable?.close();
+      throw const MidiException(
+        'Failed to create MIDI observer',
+        nativeFunction: 'lrm_observer_new_async',
+      );
+    }
+  }
+
+  void _onReady() {
+    final ready = _ready;
+    if (ready == null || ready.isCompleted || _disposed) return;
+    final status = _bindings.lrm_observer_get_status(_handle!);
+    if (status == LRM_OK) {
+      ready.complete(this);
+      return;
+    }
+    dispose();
+    ready.completeError(
+      MidiException(
+        'Failed to create MIDI observer',
+        errorCode: status,
+        nativeFunction: 'lrm_observer_new_async',
+      ),
+    );
+  }
+
+  void _onHotplugEvent(Pointer<Void> context, int eventType, int portId) {
+    final event = HotplugEvent.fromNative(eventType, portId);
+    if (event == null) {
+      _onReady();
+      return;
     }
+    if (!_disposed) _hotplugController.add(event);
   }
 
   /// Stream of hotplug events (device added/removed).
@@ -631,7 +1706,17 @@ class MidiObserver {
   /// Note: Events originate from native callbacks which may be invoked on
   /// a different thread. The stream delivers events asynchronously to the
   /// Dart isolate, so UI updates should be safe.
-  Stream<HotplugEventType> get onHotplug => _hotplugController.stream;
+  Stream<HotplugEventType> get onHotplug =>
+      _hotplugController.stream.map((event) => event.type);
+
+  /// Stream of hotplug events with the id of the port that changed.
+  ///
+  /// The native port list is updated incrementally before each event, so a
+  /// port list kept in Dart can be updated the same way: look an added port
+  /// up with [findInputPort] or [findOutputPort] and drop a removed one by
+  /// [MidiPort.portId], instead of calling [getInputPorts] again. Fall back
+  /// to re-enumerating when [HotplugEvent.hasPort] is false.
+  Stream<HotplugEvent> get onHotplugEvent => _hotplugController.stream;
 
   void _checkDisposed() {
     if (_disposed) {
@@ -640,45 +1725,93 @@ class MidiObserver {
   }
 
   /// Gets all available MIDI input ports.
-  List<MidiPort> getInputPorts() {
+  List<MidiPort> getInputPorts() => List.of(snapshot().inputs);
+
+  /// Gets all available MIDI output ports.
+  List<MidiPort> getOutputPorts() => List.of(snapshot().outputs);
+
+  /// Number that changes whenever the native port lists change.
+  int get generation {
     _checkDisposed();
-    final count = _bindings.lrm_observer_get_input_count(_handle!);
-    final ports = <MidiPort>[];
+    return _bindings.lrm_observer_get_generation(_handle!);
+  }
 
-    final info = calloc<LrmPortInfo>();
+  /// Gets both port lists at once.
+  ///
+  /// The lists are copied out of a single native buffer, with one FFI call
+  /// for all ports. While [generation] is unchanged, the previous snapshot
+  /// is returned without reading anything.
+  MidiPortSnapshot snapshot() {
+    _checkDisposed();
+    final cached = _snapshot;
+    if (cached != null && cached.generation == generation) return cached;
+
+    final native = _bindings.lrm_observer_snapshot(_handle!);
+    if (native == nullptr) {
+      throw const MidiException(
+        'Failed to read MIDI ports',
+        nativeFunction: 'lrm_observer_snapshot',
+      );
+    }
     try {
-      for (var i = 0; i < count; i++) {
-        final result = _bindings.lrm_observer_get_input(_handle!, i, info);
-        if (result == LRM_OK) {
-          ports.add(_portInfoToMidiPort(info.ref));
-        }
-      }
+      return _snapshot = MidiPortSnapshot.fromNative(native.ref);
     } finally {
-      calloc.free(info);
+      _bindings.lrm_port_snapshot_free(native);
     }
+  }
 
-    return ports;
+  /// Gets the input port with [portId], or null if there is none.
+  MidiPort? findInputPort(int portId) {
+    return _findPort(
+      (info) => _bindings.lrm_observer_get_input_by_id(_handle!, portId, info),
+    );
   }
 
-  /// Gets all available MIDI output ports.
-  List<MidiPort> getOutputPorts() {
-    _checkDisposed();
-    final count = _bindings.lrm_observer_get_output_count(_handle!);
-    final ports = <MidiPort>[];
+  /// Gets the output port with [portId], or null if there is none.
+  MidiPort? findOutputPort(int portId) {
+    return _findPort(
+      (info) => _bindings.lrm_observer_get_output_by_id(_handle!, portId, info),
+    );
+  }
+
+  /// Gets the input port with [stableId], or null if there is none.
+  ///
+  /// Use it to find a device again after it was reconnected, as its
+  /// [MidiPort.portId] may have changed. Identical devices without a serial
+  /// number share a stable id; the first of them is returned.
+  MidiPort? findInputPortByStableId(int stableId) {
+    return _findPort(
+      (info) => _bindings.lrm_observer_find_by_stable_id(
+        _handle!,
+        stableId,
+        true,
+        info,
+      ),
+    );
+  }
+
+  /// Gets the output port with [stableId], or null if there is none.
+  ///
+  /// See [findInputPortByStableId].
+  MidiPort? findOutputPortByStableId(int stableId) {
+    return _findPort(
+      (info) => _bindings.lrm_observer_find_by_stable_id(
+        _handle!,
+        stableId,
+        false,
+        info,
+      ),
+    );
+  }
 
+  MidiPort? _findPort(int Function(Pointer<LrmPortInfo> info) lookup) {
+    _checkDisposed();
     final info = calloc<LrmPortInfo>();
     try {
-      for (var i = 0; i < count; i++) {
-        final result = _bindings.lrm_observer_get_output(_handle!, i, info);
-        if (result == LRM_OK) {
-          ports.add(_portInfoToMidiPort(info.ref));
-        }
-      }
+      return lookup(info) == LRM_OK ? _portInfoToMidiPort(info.ref) : null;
     } finally {
       calloc.free(info);
     }
-
-    return ports;
   }
 
   /// Converts native LrmPortInfo to MidiPort.
@@ -713,6 +1846,31 @@ class MidiObserver {
     return MidiOutput._byId(_handle!, port.portId);
   }
 
+  /// Opens a MIDI output whose sends never block on the backend.
+  ///
+  /// [MidiOutput.send] and [MidiOutput.sendBatch] copy the data into a native
+  /// queue of [queueDepth] entries and return immediately; a dedicated writer
+  /// thread sends it in order. Slow drivers or large SysEx therefore no longer
+  /// stall the calling isolate, and several isolates can share the output.
+  /// When the queue is full, [backpressure] decides what happens. Backend
+  /// failures show up in [MidiOutput.stats] rather than as exceptions.
+  MidiOutput openAsyncOutput(
+    MidiPort port, {
+    int queueDepth = 256,
+    MidiBackpressurePolicy backpressure = MidiBackpressurePolicy.block,
+  }) {
+    _checkDisposed();
+    if (port.isInput) {
+      throw ArgumentError('Port must be an output port');
+    }
+    return MidiOutput._async(
+      _handle!,
+      port.portId,
+      queueDepth: queueDepth,
+      backpressure: backpressure,
+    );
+  }
+
   /// Opens a MIDI input connection to the specified port.
   ///
   /// The port is resolved by [MidiPort.portId], which is stable across
@@ -720,11 +1878,20 @@ class MidiObserver {
   ///
   /// By default, SysEx messages are received, while timing (MIDI clock) and
   /// active sensing messages are filtered out.
+  ///
+  /// Pass a [filter] to drop unwanted messages natively, before they are
+  /// copied into Dart. See [MidiInput.filterStats].
+  ///
+  /// Pass [decoding] to decode RPN/NRPN and 14-bit controllers natively
+  /// instead of in Dart. See [MidiParameterDecoding].
   MidiInput openInput(
     MidiPort port, {
     bool receiveSysex = true,
     bool receiveTiming = false,
     bool receiveSensing = false,
+    MidiTimestampMode timestampMode = MidiTimestampMode.absolute,
+    MidiInputFilter? filter,
+    MidiParameterDecoding? decoding,
   }) {
     _checkDisposed();
     if (!port.isInput) {
@@ -733,9 +1900,175 @@ class MidiObserver {
     return MidiInput._byId(
       _handle!,
       port.portId,
+      filter: filter,
+      decoding: decoding,
+      receiveSysex: receiveSysex,
+      receiveTiming: receiveTiming,
+      receiveSensing: receiveSensing,
+      timestampMode: timestampMode,
+    );
+  }
+
+  /// Opens a MIDI input whose messages are buffered natively.
+  ///
+  /// Instead of one isolate message per MIDI event, the native backend thread
+  /// writes into a bounded lock-free ring of [capacity] bytes. Every
+  /// [pollInterval] the ring is drained in one FFI call and the messages are
+  /// added to [MidiInput.messages]. Pass `null` for [pollInterval] to drain
+  /// manually with [MidiInput.readBatch] instead.
+  ///
+  /// When the ring is full, messages are discarded according to
+  /// [overflowPolicy] and counted in [MidiInput.droppedCount], so memory use
+  /// stays bounded even if the listener falls behind.
+  MidiInput openBufferedInput(
+    MidiPort port, {
+    int capacity = 64 * 1024,
+    MidiOverflowPolicy overflowPolicy = MidiOverflowPolicy.dropOldest,
+    Duration? pollInterval = const Duration(milliseconds: 5),
+    bool receiveSysex = true,
+    bool receiveTiming = false,
+    bool receiveSensing = false,
+    MidiTimestampMode timestampMode = MidiTimestampMode.absolute,
+  }) {
+    _checkDisposed();
+    if (!port.isInput) {
+      throw ArgumentError('Port must be an input port');
+    }
+    return MidiInput._ring(
+      _handle!,
+      port.portId,
+      capacity: capacity,
+      overflowPolicy: overflowPolicy,
+      pollInterval: pollInterval,
+      receiveSysex: receiveSysex,
+      receiveTiming: receiveTiming,
+      receiveSensing: receiveSensing,
+      timestampMode: timestampMode,
+    );
+  }
+
+  /// Opens a MIDI input that delivers messages in time-windowed batches.
+  ///
+  /// Messages are coalesced natively and posted to Dart as one packed buffer
+  /// when [window] has elapsed since the first message of the batch, or
+  /// earlier once [maxMessages] messages or [maxBytes] bytes are collected.
+  /// This trades up to [window] of extra latency for far fewer isolate
+  /// messages during dense traffic. The batches are unpacked into
+  /// [MidiInput.messages] in arrival order.
+  MidiInput openBatchedInput(
+    MidiPort port, {
+    Duration window = const Duration(milliseconds: 1),
+    int maxMessages = 256,
+    int maxBytes = 16 * 1024,
+    bool receiveSysex = true,
+    bool receiveTiming = false,
+    bool receiveSensing = false,
+    MidiTimestampMode timestampMode = MidiTimestampMode.absolute,
+  }) {
+    _checkDisposed();
+    if (!port.isInput) {
+      throw ArgumentError('Port must be an input port');
+    }
+    return MidiInput._batched(
+      _handle!,
+      port.portId,
+      window: window,
+      maxMessages: maxMessages,
+      maxBytes: maxBytes,
       receiveSysex: receiveSysex,
       receiveTiming: receiveTiming,
       receiveSensing: receiveSensing,
+      timestampMode: timestampMode,
+    );
+  }
+
+  /// Opens a MIDI input that streams SysEx in chunks.
+  ///
+  /// SysEx messages are not reassembled into one buffer. They are delivered on
+  /// [MidiInput.sysExChunks] in chunks of at most [chunkSize] bytes as they
+  /// arrive, so multi-megabyte dumps stream with bounded memory. All other
+  /// messages are delivered on [MidiInput.messages] as usual.
+  ///
+  /// A message longer than [maxSysExSize] bytes is cut off natively and ended
+  /// according to [overflowPolicy]; `null` means no limit.
+  MidiInput openSysExStreamInput(
+    MidiPort port, {
+    int chunkSize = 4096,
+    int? maxSysExSize,
+    MidiSysExOverflowPolicy overflowPolicy = MidiSysExOverflowPolicy.abort,
+    bool receiveTiming = false,
+    bool receiveSensing = false,
+    MidiTimestampMode timestampMode = MidiTimestampMode.absolute,
+  }) {
+    _checkDisposed();
+    if (!port.isInput) {
+      throw ArgumentError('Port must be an input port');
+    }
+    return MidiInput._sysExStream(
+      _handle!,
+      port.portId,
+      chunkSize: chunkSize,
+      maxSysExSize: maxSysExSize ?? 0,
+      overflowPolicy: overflowPolicy,
+      receiveTiming: receiveTiming,
+      receiveSensing: receiveSensing,
+      timestampMode: timestampMode,
+    );
+  }
+
+  /// Opens a MIDI input that follows the incoming MIDI clock natively.
+  ///
+  /// Clock ticks, Start/Continue/Stop and Song Position Pointer are analysed
+  /// in native code; poll [MidiInput.clockState] for the tempo, beat phase,
+  /// song position and jitter. With [suppressTicks] the 24-per-beat clock
+  /// ticks are not delivered on [MidiInput.messages], so following a clock
+  /// costs no per-tick isolate messages.
+  MidiInput openClockInput(
+    MidiPort port, {
+    bool suppressTicks = true,
+    bool receiveSysex = true,
+    bool receiveSensing = false,
+    MidiTimestampMode timestampMode = MidiTimestampMode.absolute,
+  }) {
+    _checkDisposed();
+    if (!port.isInput) {
+      throw ArgumentError('Port must be an input port');
+    }
+    return MidiInput._clock(
+      _handle!,
+      port.portId,
+      suppressTicks: suppressTicks,
+      receiveSysex: receiveSysex,
+      receiveSensing: receiveSensing,
+      timestampMode: timestampMode,
+    );
+  }
+
+  /// Opens a MIDI input that reads incoming MIDI Time Code natively.
+  ///
+  /// Quarter frames and full-frame messages are decoded in native code; poll
+  /// [MidiInput.timecode] for the SMPTE position and lock status. With
+  /// [suppressQuarterFrames] the 100-odd quarter frames per second are not
+  /// delivered on [MidiInput.messages]. Timing messages are enabled for this
+  /// input, so incoming clock ticks are delivered.
+  MidiInput openTimecodeInput(
+    MidiPort port, {
+    bool suppressQuarterFrames = true,
+    bool receiveSysex = true,
+    bool receiveSensing = false,
+    MidiTimestampMode timestampMode = MidiTimestampMode.absolute,
+  }) {
+    _checkDisposed();
+    if (!port.isInput) {
+      throw ArgumentError('Port must be an input port');
+    }
+    return MidiInput._timecode(
+      _handle!,
+      port.portId,
+      suppressQuarterFrames: suppressQuarterFrames,
+      receiveSysex: receiveSysex,
+      receiveSensing: receiveSensing,
+      timestampMode: timestampMode,
     );
   }
 
@@ -785,6 +2118,14 @@ class MidiObserver {
 class MidiOutput {
   Pointer<LrmMidiOut>? _handle;
   bool _disposed = false;
+  MidiOutputOptimizer? _optimizer;
+  final List<MidiRoute> _routes = [];
+  final List<MidiClockGenerator> _clocks = [];
+  final List<MidiOutputGroup> _groups = [];
+
+  // Native staging buffer, owned and freed by the output
+  Pointer<Uint8> _stagingPtr = nullptr;
+  Uint8List? _staging;
 
   MidiOutput._byId(Pointer<LrmObserver> observer, int portId) {
     _handle = _bindings.lrm_midi_out_open_by_id(observer, portId);
@@ -793,6 +2134,33 @@ class MidiOutput {
     }
   }
 
+  MidiOutput._async(
+    Pointer<LrmObserver> observer,
+    int portId, {
+    required int queueDepth,
+    required MidiBackpressurePolicy backpressure,
+  }) {
+    if (queueDepth < 0) {
+      throw ArgumentError.value(
+        queueDepth,
+        'queueDepth',
+        'Must not be negative',
+      );
+    }
+    _handle = _bindings.lrm_midi_out_open_async(
+      observer,
+      portId,
+      queueDepth,
+      backpressure.nativeValue,
+    );
+    if (_handle == nullptr) {
+      throw const MidiException(
+        'Failed to open MIDI output',
+        nativeFunction: 'lrm_midi_out_open_async',
+      );
+    }
+  }
+
   /// The raw native pointer address for cross-plugin bridging.
   ///
   /// Use with `Pointer<LrmMidiOut>.fromAddress(address)` in another
@@ -812,61 +2180,274 @@ class MidiOutput {
     return _bindings.lrm_midi_out_is_connected(_handle!);
   }
 
-  /// Sends a raw MIDI message.
-  void send(Uint8List data) {
+  /// Counters of this output since it was opened.
+  MidiOutputStats get stats {
     _checkDisposed();
-    if (data.isEmpty) return; // Guard: don't send empty messages
-    final ptr = calloc<Uint8>(data.length);
+    final stats = calloc<LrmMidiOutStats>();
     try {
-      for (var i = 0; i < data.length; i++) {
-        ptr[i] = data[i];
-      }
-      final result = _bindings.lrm_midi_out_send(_handle!, ptr, data.length);
+      final result = _bindings.lrm_midi_out_get_stats(_handle!, stats);
       if (result != LRM_OK) {
-        throw MidiException('Failed to send MIDI message', errorCode: result);
+        throw MidiException(
+          'Failed to read output statistics',
+          errorCode: result,
+          nativeFunction: 'lrm_midi_out_get_stats',
+        );
       }
+      return MidiOutputStats(
+        messages: stats.ref.messages,
+        bytes: stats.ref.bytes,
+        sysExMessages: stats.ref.sysex_messages,
+        sendFailures: stats.ref.send_failures,
+        sendTimeNanoseconds: stats.ref.send_time_ns,
+        maxSendNanoseconds: stats.ref.max_send_ns,
+        p99SendNanoseconds: stats.ref.p99_send_ns,
+        queuePending: stats.ref.queue_pending,
+        queueCompleted: stats.ref.queue_completed,
+        queueFailed: stats.ref.queue_failed,
+        queueOverflows: stats.ref.queue_overflows,
+      );
     } finally {
-      calloc.free(ptr);
+      calloc.free(stats);
     }
   }
 
-  /// Sends a Note On message.
-  void sendNoteOn({
-    required int channel,
-    required int note,
-    required int velocity,
-  }) {
-    RangeError.checkValueInInterval(channel, 0, 15, 'channel');
-    RangeError.checkValueInInterval(note, 0, 127, 'note');
-    RangeError.checkValueInInterval(velocity, 0, 127, 'velocity');
-    send(Uint8List.fromList([0x90 | channel, note, velocity]));
-  }
+  /// The native optimizer applied to [send] and [sendBatch], or `null`.
+  MidiOutputOptimizer? get optimizer => _optimizer;
 
-  /// Sends a Note Off message.
-  void sendNoteOff({
-    required int channel,
-    required int note,
-    int velocity = 0,
-  }) {
-    RangeError.checkValueInInterval(channel, 0, 15, 'channel');
-    RangeError.checkValueInInterval(note, 0, 127, 'note');
-    RangeError.checkValueInInterval(velocity, 0, 127, 'velocity');
-    send(Uint8List.fromList([0x80 | channel, note, velocity]));
+  /// Installs a native optimizer that drops repeated controller values,
+  /// coalesces fast controller movements and paces output to a byte rate.
+  ///
+  /// Messages it delays are sent from a native pacing thread. Setting `null`
+  /// removes it after sending whatever it still holds. Scheduled messages
+  /// ([schedule]) bypass the optimizer. It can be changed while routes,
+  /// clocks or timecode send to this output from native threads.
+  set optimizer(MidiOutputOptimizer? value) {
+    _checkDisposed();
+    var result = LRM_OK;
+    if (value == null) {
+      result = _bindings.lrm_midi_out_set_optimizer(_handle!, nullptr);
+    } else {
+      final settings = calloc<LrmMidiOptimizer>();
+      try {
+        value.fill(settings.ref);
+        result = _bindings.lrm_midi_out_set_optimizer(_handle!, settings);
+      } finally {
+        calloc.free(settings);
+      }
+    }
+    if (result != LRM_OK) {
+      _optimizer = null;
+      throw MidiException(
+        'Failed to set the output optimizer',
+        errorCode: result,
+        nativeFunction: 'lrm_midi_out_set_optimizer',
+      );
+    }
+    _optimizer = value;
   }
 
-  /// Sends a Control Change message.
-  void sendControlChange({
-    required int channel,
-    required int controller,
-    required int value,
-  }) {
-    RangeError.checkValueInInterval(channel, 0, 15, 'channel');
-    RangeError.checkValueInInterval(controller, 0, 127, 'controller');
-    RangeError.checkValueInInterval(value, 0, 127, 'value');
-    send(Uint8List.fromList([0xB0 | channel, controller, value]));
+  /// Counters of the current [optimizer] (all zero without one).
+  MidiOptimizerStats get optimizerStats {
+    _checkDisposed();
+    final stats = calloc<LrmMidiOptimizerStats>();
+    try {
+      final result = _bindings.lrm_midi_out_get_optimizer_stats(
+        _handle!,
+        stats,
+      );
+      if (result != LRM_OK) {
+        throw MidiException(
+          'Failed to read optimizer statistics',
+          errorCode: result,
+          nativeFunction: 'lrm_midi_out_get_optimizer_stats',
+        );
+      }
+      return MidiOptimizerStats(
+        duplicates: stats.ref.duplicates,
+        coalesced: stats.ref.coalesced,
+        delayed: stats.ref.delayed,
+        pending: stats.ref.pending,
+      );
+    } finally {
+      calloc.free(stats);
+    }
   }
 
-  /// Sends a Program Change message.
+  /// Starts sending MIDI Time Code from [from].
+  ///
+  /// A full-frame message is sent first so receivers locate, then a native
+  /// thread sends four quarter frames per frame at [MidiTimecode.rate].
+  /// Calling it again while running restarts from the new position.
+  void startTimecode(MidiTimecode from) {
+    _checkDisposed();
+    final position = calloc<LrmTimecode>();
+    try {
+      from.fill(position.ref);
+      final result = _bindings.lrm_midi_out_start_timecode(_handle!, position);
+      if (result != LRM_OK) {
+        throw MidiException(
+          result == LRM_ERR_INVALID
+              ? 'Invalid timecode position $from'
+              : 'Failed to start timecode',
+          errorCode: result,
+          nativeFunction: 'lrm_midi_out_start_timecode',
+        );
+      }
+    } finally {
+      calloc.free(position);
+    }
+  }
+
+  /// Stops sending MIDI Time Code.
+  void stopTimecode() {
+    _checkDisposed();
+    _bindings.lrm_midi_out_stop_timecode(_handle!);
+  }
+
+  /// Position of the timecode being sent, or `null` if [startTimecode] was
+  /// never called.
+  MidiTimecode? get timecode {
+    _checkDisposed();
+    final position = calloc<LrmTimecode>();
+    try {
+      final result = _bindings.lrm_midi_out_get_timecode(_handle!, position);
+      if (result != LRM_OK) return null;
+      return MidiTimecode.fromNative(position.ref);
+    } finally {
+      calloc.free(position);
+    }
+  }
+
+  /// Sends a raw MIDI message.
+  void send(Uint8List data) {
+    _checkDisposed();
+    if (data.isEmpty) return; // Guard: don't send empty messages
+    _stage(data.length).setAll(0, data);
+    _commit(data.length);
+  }
+
+  /// Sends several complete MIDI messages with a single native call.
+  ///
+  /// Each message must start with its status byte; SysEx must include its
+  /// 0xF0/0xF7 framing. On Linux the whole batch is submitted to ALSA at once,
+  /// which is considerably cheaper than calling [send] per message for
+  /// chords, scene recalls or RPN sequences.
+  void sendBatch(Iterable<Uint8List> messages) {
+    _checkDisposed();
+    final list = messages is List<Uint8List> ? messages : messages.toList();
+    var length = 0;
+    var count = 0;
+    for (final message in list) {
+      if (message.isEmpty) continue;
+      length += message.length;
+      count++;
+    }
+    if (count == 0) return;
+    final staging = _stage(length);
+    var offset = 0;
+    for (final message in list) {
+      staging.setAll(offset, message);
+      offset += message.length;
+    }
+    _commitBatch(length, count);
+  }
+
+  /// Returns the output's native staging buffer, at least [length] bytes.
+  ///
+  /// Messages are written into it in place and sent with [_commit] or
+  /// [_commitBatch], so sending does not allocate or copy through a
+  /// temporary native buffer.
+  Uint8List _stage(int length) {
+    final staging = _staging;
+    if (staging != null && staging.length >= length) return staging;
+    final doubled = (staging?.length ?? 128) * 2;
+    final capacity = length > doubled ? length : doubled;
+    final ptr = _bindings.lrm_midi_out_acquire(_handle!, capacity);
+    if (ptr == nullptr) {
+      throw MidiException(
+        'Failed to allocate a $capacity byte send buffer',
+        errorCode: LRM_ERR_INVALID,
+        nativeFunction: 'lrm_midi_out_acquire',
+      );
+    }
+    _stagingPtr = ptr;
+    return _staging = ptr.asTypedList(capacity);
+  }
+
+  void _commit(int length) {
+    final result = _bindings.lrm_midi_out_commit(_handle!, length);
+    if (result != LRM_OK) {
+      throw MidiException('Failed to send MIDI message', errorCode: result);
+    }
+  }
+
+  void _commitBatch(int length, int count) {
+    final result = _bindings.lrm_midi_out_commit_batch(_handle!, length);
+    if (result < 0) {
+      throw MidiException(
+        'Failed to send MIDI messages',
+        errorCode: result,
+        nativeFunction: 'lrm_midi_out_commit_batch',
+      );
+    }
+    if (result < count) {
+      throw MidiException(
+        'Sent only $result of $count MIDI messages',
+        errorCode: LRM_ERR_SEND_FAILED,
+        nativeFunction: 'lrm_midi_out_commit_batch',
+      );
+    }
+  }
+
+  /// Sends a sequence of Control Change messages on one channel as a batch.
+  void _sendControlChanges(int channel, List<(int, int)> changes) {
+    _checkDisposed();
+    final staging = _stage(changes.length * 3);
+    for (var i = 0; i < changes.length; i++) {
+      staging[i * 3] = 0xB0 | channel;
+      staging[i * 3 + 1] = changes[i].$1;
+      staging[i * 3 + 2] = changes[i].$2;
+    }
+    _commitBatch(changes.length * 3, changes.length);
+  }
+
+  /// Sends a Note On message.
+  void sendNoteOn({
+    required int channel,
+    required int note,
+    required int velocity,
+  }) {
+    RangeError.checkValueInInterval(channel, 0, 15, 'channel');
+    RangeError.checkValueInInterval(note, 0, 127, 'note');
+    RangeError.checkValueInInterval(velocity, 0, 127, 'velocity');
+    send(Uint8List.fromList([0x90 | channel, note, velocity]));
+  }
+
+  /// Sends a Note Off message.
+  void sendNoteOff({
+    required int channel,
+    required int note,
+    int velocity = 0,
+  }) {
+    RangeError.checkValueInInterval(channel, 0, 15, 'channel');
+    RangeError.checkValueInInterval(note, 0, 127, 'note');
+    RangeError.checkValueInInterval(velocity, 0, 127, 'velocity');
+    send(Uint8List.fromList([0x80 | channel, note, velocity]));
+  }
+
+  /// Sends a Control Change message.
+  void sendControlChange({
+    required int channel,
+    required int controller,
+    required int value,
+  }) {
+    RangeError.checkValueInInterval(channel, 0, 15, 'channel');
+    RangeError.checkValueInInterval(controller, 0, 127, 'controller');
+    RangeError.checkValueInInterval(value, 0, 127, 'value');
+    send(Uint8List.fromList([0xB0 | channel, controller, value]));
+  }
+
+  /// Sends a Program Change message.
   void sendProgramChange({required int channel, required int program}) {
     RangeError.checkValueInInterval(channel, 0, 15, 'channel');
     RangeError.checkValueInInterval(program, 0, 127, 'program');
@@ -898,9 +2479,11 @@ class MidiOutput {
     RangeError.checkValueInInterval(program, 0, 127, 'program');
     final msb = (bank >> 7) & 0x7F;
     final lsb = bank & 0x7F;
-    sendControlChange(channel: channel, controller: 0, value: msb);
-    sendControlChange(channel: channel, controller: 32, value: lsb);
-    sendProgramChange(channel: channel, program: program);
+    sendBatch([
+      Uint8List.fromList([0xB0 | channel, 0, msb]),
+      Uint8List.fromList([0xB0 | channel, 32, lsb]),
+      Uint8List.fromList([0xC0 | channel, program]),
+    ]);
   }
 
   /// Sends a Registered Parameter Number (RPN) value.
@@ -930,22 +2513,16 @@ class MidiOutput {
 
     final parameterMsb = (parameter >> 7) & 0x7F;
     final parameterLsb = parameter & 0x7F;
-    sendControlChange(channel: channel, controller: 101, value: parameterMsb);
-    sendControlChange(channel: channel, controller: 100, value: parameterLsb);
-
-    if (fourteenBit) {
-      final valueMsb = (value >> 7) & 0x7F;
-      final valueLsb = value & 0x7F;
-      sendControlChange(channel: channel, controller: 6, value: valueMsb);
-      sendControlChange(channel: channel, controller: 38, value: valueLsb);
-    } else {
-      sendControlChange(channel: channel, controller: 6, value: value);
-    }
-
-    if (deselect) {
-      sendControlChange(channel: channel, controller: 101, value: 127);
-      sendControlChange(channel: channel, controller: 100, value: 127);
-    }
+    _sendControlChanges(channel, [
+      (101, parameterMsb),
+      (100, parameterLsb),
+      if (fourteenBit) ...[
+        (6, (value >> 7) & 0x7F),
+        (38, value & 0x7F),
+      ] else
+        (6, value),
+      if (deselect) ...[(101, 127), (100, 127)],
+    ]);
   }
 
   /// Sends a Data Increment for a Registered Parameter Number (RPN).
@@ -1015,22 +2592,16 @@ class MidiOutput {
 
     final parameterMsb = (parameter >> 7) & 0x7F;
     final parameterLsb = parameter & 0x7F;
-    sendControlChange(channel: channel, controller: 99, value: parameterMsb);
-    sendControlChange(channel: channel, controller: 98, value: parameterLsb);
-
-    if (fourteenBit) {
-      final valueMsb = (value >> 7) & 0x7F;
-      final valueLsb = value & 0x7F;
-      sendControlChange(channel: channel, controller: 6, value: valueMsb);
-      sendControlChange(channel: channel, controller: 38, value: valueLsb);
-    } else {
-      sendControlChange(channel: channel, controller: 6, value: value);
-    }
-
-    if (deselect) {
-      sendControlChange(channel: channel, controller: 99, value: 127);
-      sendControlChange(channel: channel, controller: 98, value: 127);
-    }
+    _sendControlChanges(channel, [
+      (99, parameterMsb),
+      (98, parameterLsb),
+      if (fourteenBit) ...[
+        (6, (value >> 7) & 0x7F),
+        (38, value & 0x7F),
+      ] else
+        (6, value),
+      if (deselect) ...[(99, 127), (98, 127)],
+    ]);
   }
 
   /// Sends a Data Increment for a Non-Registered Parameter Number (NRPN).
@@ -1086,14 +2657,12 @@ class MidiOutput {
 
     final parameterMsb = (parameter >> 7) & 0x7F;
     final parameterLsb = parameter & 0x7F;
-    sendControlChange(channel: channel, controller: 101, value: parameterMsb);
-    sendControlChange(channel: channel, controller: 100, value: parameterLsb);
-    sendControlChange(channel: channel, controller: controller, value: amount);
-
-    if (deselect) {
-      sendControlChange(channel: channel, controller: 101, value: 127);
-      sendControlChange(channel: channel, controller: 100, value: 127);
-    }
+    _sendControlChanges(channel, [
+      (101, parameterMsb),
+      (100, parameterLsb),
+      (controller, amount),
+      if (deselect) ...[(101, 127), (100, 127)],
+    ]);
   }
 
   void _sendNrpnRelative({
@@ -1109,14 +2678,12 @@ class MidiOutput {
 
     final parameterMsb = (parameter >> 7) & 0x7F;
     final parameterLsb = parameter & 0x7F;
-    sendControlChange(channel: channel, controller: 99, value: parameterMsb);
-    sendControlChange(channel: channel, controller: 98, value: parameterLsb);
-    sendControlChange(channel: channel, controller: controller, value: amount);
-
-    if (deselect) {
-      sendControlChange(channel: channel, controller: 99, value: 127);
-      sendControlChange(channel: channel, controller: 98, value: 127);
-    }
+    _sendControlChanges(channel, [
+      (99, parameterMsb),
+      (98, parameterLsb),
+      (controller, amount),
+      if (deselect) ...[(99, 127), (98, 127)],
+    ]);
   }
 
   /// Sends a SysEx message.
@@ -1128,11 +2695,199 @@ class MidiOutput {
     if (alreadyFramed) {
       send(data);
     } else {
-      final message = Uint8List(data.length + 2);
-      message[0] = 0xF0;
-      message.setRange(1, data.length + 1, data);
-      message[data.length + 1] = 0xF7;
-      send(message);
+      _checkDisposed();
+      final staging = _stage(data.length + 2);
+      staging[0] = 0xF0;
+      staging.setRange(1, data.length + 1, data);
+      staging[data.length + 1] = 0xF7;
+      _commit(data.length + 2);
+    }
+  }
+
+  /// Sends one or more complete SysEx messages (each framed with 0xF0/0xF7,
+  /// e.g. the contents of a .syx file) in paced pieces, for devices that lose
+  /// data when a large dump arrives at full speed.
+  ///
+  /// Each message is split into pieces of at most [chunkSize] bytes (`null`
+  /// keeps messages whole). After each piece a native thread waits
+  /// [chunkDelay], and keeps the average rate under [maxBytesPerSecond] when
+  /// set. Transfers on the same output run one after the other.
+  ///
+  /// Returns at once; follow the returned transfer with
+  /// [MidiSysExTransfer.progress] and [MidiSysExTransfer.done]. Avoid sending
+  /// other messages than real-time ones on this output until it is done, as
+  /// they would end up inside the SysEx. Closing the output cancels the rest.
+  ///
+  /// Backends that only accept whole SysEx messages ignore [chunkSize].
+  MidiSysExTransfer sendSysExPaced(
+    Uint8List data, {
+    int? chunkSize,
+    Duration chunkDelay = Duration.zero,
+    int? maxBytesPerSecond,
+  }) {
+    _checkDisposed();
+    if (chunkSize != null && chunkSize <= 0) {
+      throw ArgumentError.value(chunkSize, 'chunkSize', 'Must be positive');
+    }
+    if (maxBytesPerSecond != null && maxBytesPerSecond <= 0) {
+      throw ArgumentError.value(
+        maxBytesPerSecond,
+        'maxBytesPerSecond',
+        'Must be positive',
+      );
+    }
+    if (chunkDelay.isNegative) {
+      throw ArgumentError.value(
+        chunkDelay,
+        'chunkDelay',
+        'Must not be negative',
+      );
+    }
+
+    // A one-off copy: a firmware image should not grow the staging buffer
+    final buffer = calloc<Uint8>(data.isEmpty ? 1 : data.length);
+    final pacing = calloc<LrmSysexPacing>();
+    try {
+      buffer.asTypedList(data.length).setAll(0, data);
+      pacing.ref.chunk_size = (chunkSize ?? 0).clamp(0, 0xFFFFFFFF);
+      pacing.ref.chunk_delay_us =
+          chunkDelay.inMicroseconds.clamp(0, 0xFFFFFFFF);
+      pacing.ref.max_bytes_per_second =
+          (maxBytesPerSecond ?? 0).clamp(0, 0xFFFFFFFF);
+      final id = _bindings.lrm_midi_out_send_sysex_paced(
+        _handle!,
+        buffer,
+        data.length,
+        pacing,
+      );
+      if (id <= 0) {
+        throw MidiException(
+          'Failed to start SysEx transfer',
+          errorCode: id,
+          nativeFunction: 'lrm_midi_out_send_sysex_paced',
+        );
+      }
+      return MidiSysExTransfer._(this, id, data.length);
+    } finally {
+      calloc.free(pacing);
+      calloc.free(buffer);
+    }
+  }
+
+  /// Sends an automation curve rendered by a native thread.
+  ///
+  /// The curve goes from the first point's value through each later point.
+  /// It is sampled [rateHz] times per second (at most 2000), and a message
+  /// is only sent when the value at the target's resolution changes. For
+  /// [MidiAutomationTarget.nrpn] each update selects the parameter again.
+  /// A curve already running on the same target (channel and [number], or
+  /// the channel's pitch bend) is cancelled.
+  ///
+  /// ```dart
+  /// // Open the filter over two seconds, then fall back quickly
+  /// output.automate(
+  ///   target: MidiAutomationTarget.controlChange,
+  ///   channel: 0,
+  ///   number: 74,
+  ///   points: const [
+  ///     MidiAutomationPoint(0.1),
+  ///     MidiAutomationPoint(1.0, after: Duration(seconds: 2)),
+  ///     MidiAutomationPoint(0.3,
+  ///         after: Duration(milliseconds: 300),
+  ///         shape: MidiCurveShape.exponential,
+  ///         curvature: -4),
+  ///   ],
+  /// );
+  /// ```
+  MidiAutomation automate({
+    required MidiAutomationTarget target,
+    required int channel,
+    int number = 0,
+    required List<MidiAutomationPoint> points,
+    int rateHz = 100,
+  }) {
+    _checkDisposed();
+    RangeError.checkValueInInterval(channel, 0, 15, 'channel');
+    RangeError.checkValueInInterval(rateHz, 1, 2000, 'rateHz');
+    switch (target) {
+      case MidiAutomationTarget.controlChange:
+        RangeError.checkValueInInterval(number, 0, 127, 'number');
+      case MidiAutomationTarget.controlChange14:
+        RangeError.checkValueInInterval(number, 0, 31, 'number');
+      case MidiAutomationTarget.pitchBend:
+        break;
+      case MidiAutomationTarget.nrpn:
+        RangeError.checkValueInInterval(number, 0, 16383, 'number');
+    }
+    if (points.isEmpty) {
+      throw ArgumentError.value(points, 'points', 'Must not be empty');
+    }
+
+    final settings = calloc<LrmAutomation>();
+    final native = calloc<LrmAutomationPoint>(points.length);
+    try {
+      settings.ref
+        ..target = target.nativeValue
+        ..channel = channel
+        ..number = number
+        ..rate_hz = rateHz;
+      for (var i = 0; i < points.length; i++) {
+        final point = points[i];
+        if (point.value.isNaN || point.value < 0 || point.value > 1) {
+          throw RangeError.range(point.value, 0, 1, 'points[$i].value');
+        }
+        if (point.after.isNegative) {
+          throw ArgumentError.value(
+            point.after,
+            'points[$i].after',
+            'Must not be negative',
+          );
+        }
+        native[i]
+          ..duration_us = point.after.inMicroseconds.clamp(0, 0xFFFFFFFF)
+          ..value = point.value
+          ..shape = point.shape.nativeValue
+          ..curvature = point.curvature;
+      }
+      final id = _bindings.lrm_midi_out_automate(
+        _handle!,
+        settings,
+        native,
+        points.length,
+      );
+      if (id <= 0) {
+        throw MidiException(
+          'Failed to start automation',
+          errorCode: id,
+          nativeFunction: 'lrm_midi_out_automate',
+        );
+      }
+      return MidiAutomation._(this, id);
+    } finally {
+      calloc.free(native);
+      calloc.free(settings);
+    }
+  }
+
+  /// Stops every automation curve on this output where it is.
+  void cancelAutomation() {
+    _checkDisposed();
+    _bindings.lrm_midi_out_cancel_automation(_handle!, 0);
+  }
+
+  /// Counters of the automation curves sent on this output.
+  MidiAutomationStats get automationStats {
+    _checkDisposed();
+    final stats = calloc<LrmAutomationStats>();
+    try {
+      _bindings.lrm_midi_out_get_automation_stats(_handle!, stats);
+      return MidiAutomationStats(
+        updates: stats.ref.updates,
+        unchanged: stats.ref.unchanged,
+        running: stats.ref.running,
+      );
+    } finally {
+      calloc.free(stats);
     }
   }
 
@@ -1155,11 +2910,75 @@ class MidiOutput {
     send(Uint8List.fromList([0xA0 | channel, note, pressure]));
   }
 
+  /// Schedules one or more complete MIDI messages to be sent at
+  /// [timestampNanoseconds] on the [LibremidiFlutter.nowNanoseconds] clock.
+  ///
+  /// A native thread sends the messages at the requested time, independent of
+  /// the Dart event loop. Messages with the same timestamp keep their order;
+  /// a timestamp in the past sends immediately.
+  ///
+  /// On Linux (ALSA sequencer) messages are handed to a kernel queue 10 ms
+  /// before they are due, and the kernel delivers them on time. From then on
+  /// they are no longer counted by [scheduledCount] and cannot be cancelled.
+  void schedule(int timestampNanoseconds, Uint8List data) {
+    _checkDisposed();
+    _stage(data.length).setAll(0, data);
+    final result = _bindings.lrm_midi_out_schedule(
+      _handle!,
+      timestampNanoseconds,
+      _stagingPtr,
+      data.length,
+    );
+    if (result != LRM_OK) {
+      throw MidiException(
+        'Failed to schedule MIDI message',
+        errorCode: result,
+        nativeFunction: 'lrm_midi_out_schedule',
+      );
+    }
+  }
+
+  /// Number of scheduled messages that have not been sent yet.
+  int get scheduledCount {
+    if (_disposed || _handle == null) return 0;
+    return _bindings.lrm_midi_out_get_scheduled_count(_handle!);
+  }
+
+  /// Discards all scheduled messages and returns how many there were.
+  int cancelScheduled() {
+    _checkDisposed();
+    return _bindings.lrm_midi_out_cancel_scheduled(_handle!);
+  }
+
+  /// Sends all scheduled messages now, in timestamp order, and returns how
+  /// many were sent.
+  int flushScheduled() {
+    _checkDisposed();
+    return _bindings.lrm_midi_out_flush_scheduled(_handle!);
+  }
+
   /// Closes the output connection and releases resources.
-  void dispose() {
+  ///
+  /// Scheduled messages that have not been sent yet are discarded, unless
+  /// [flushScheduled] is true, in which case they are sent immediately first.
+  void dispose({bool flushScheduled = false}) {
     if (!_disposed && _handle != null) {
+      for (final route in List.of(_routes)) {
+        route.dispose();
+      }
+      for (final clock in List.of(_clocks)) {
+        clock.removeOutput(this);
+      }
+      for (final group in List.of(_groups)) {
+        group.remove(this);
+      }
+      if (flushScheduled) {
+        _bindings.lrm_midi_out_flush_scheduled(_handle!);
+      }
       _bindings.lrm_midi_out_close(_handle!);
       _handle = null;
+      _stagingPtr = nullptr;
+      _staging = null;
       _disposed = true;
     }
   }
@@ -1175,86 +2994,476 @@ class MidiInput {
   bool _disposed = false;
   NativeCallable<Void Function(Pointer<Void>, Pointer<Uint8>, Size, Int64)>?
       _callback;
+  NativeCallable<Void Function(Pointer<Void>, Pointer<Uint8>, Size, Int32)>?
+      _batchCallback;
   final StreamController<MidiMessage> _messageController =
       StreamController<MidiMessage>.broadcast();
+  Pointer<Uint8>? _batchBuffer;
+  int _batchCapacity = 0;
+  Timer? _pollTimer;
+  bool _filtered = false;
+  bool _decoded = false;
+  NativeCallable<
+      Void Function(
+          Pointer<Void>, Int32, Int32, Int32, Int32, Int32, Int64)>?
+      _parameterCallback;
+  final StreamController<RpnNrpnMessage> _rpnNrpnController =
+      StreamController<RpnNrpnMessage>.broadcast();
+  final StreamController<ControlChange14Message> _cc14Controller =
+      StreamController<ControlChange14Message>.broadcast();
+  NativeCallable<
+      Void Function(Pointer<Void>, Pointer<Uint8>, Size, Int32, Int64)>?
+      _chunkCallback;
+  final StreamController<SysExChunk> _sysExChunkController =
+      StreamController<SysExChunk>.broadcast();
+  final List<MidiRoute> _routes = [];
 
   MidiInput._byId(
     Pointer<LrmObserver> observer,
     int portId, {
+    MidiInputFilter? filter,
+    MidiParameterDecoding? decoding,
     required bool receiveSysex,
     required bool receiveTiming,
     required bool receiveSensing,
+    required MidiTimestampMode timestampMode,
   }) {
+    // Validate the settings before any native resources are created.
+    filter?.channelMask;
+    decoding?.fourteenBitMask;
+
     _callback = NativeCallable<
         Void Function(Pointer<Void>, Pointer<Uint8>, Size,
             Int64)>.listener(_onMidiMessage);
 
-    _handle = _bindings.lrm_midi_in_open_by_id(
+    if (decoding != null) {
+      _openDecoded(
+        observer,
+        portId,
+        filter,
+        decoding,
+        timestampMode,
+        receiveSysex,
+        receiveTiming,
+        receiveSensing,
+      );
+    } else if (filter == null) {
+      _handle = _bindings.lrm_midi_in_open_timestamped(
+        observer,
+        portId,
+        _callback!.nativeFunction,
+        nullptr,
+        timestampMode.nativeValue,
+        receiveSysex,
+        receiveTiming,
+        receiveSensing,
+      );
+    } else {
+      final nativeFilter = calloc<LrmMidiFilter>();
+      try {
+        filter._fill(nativeFilter.ref);
+        _handle = _bindings.lrm_midi_in_open_filtered(
+          observer,
+          portId,
+          _callback!.nativeFunction,
+          nullptr,
+          nativeFilter,
+          timestampMode.nativeValue,
+          receiveSysex,
+          receiveTiming,
+          receiveSensing,
+        );
+      } finally {
+        calloc.free(nativeFilter);
+      }
+      _filtered = true;
+    }
+
+    if (_handle == nullptr) {
+      _callback?.close();
+      throw const MidiException('Failed to open MIDI input');
+    }
+  }
+
+  void _openDecoded(
+    Pointer<LrmObserver> observer,
+    int portId,
+    MidiInputFilter? filter,
+    MidiParameterDecoding decoding,
+    MidiTimestampMode timestampMode,
+    bool receiveSysex,
+    bool receiveTiming,
+    bool receiveSensing,
+  ) {
+    _parameterCallback = NativeCallable<
+        Void Function(Pointer<Void>, Int32, Int32, Int32, Int32, Int32,
+            Int64)>.listener(_onParameter);
+
+    final nativeFilter = filter == null ? nullptr : calloc<LrmMidiFilter>();
+    try {
+      if (filter != null) filter._fill(nativeFilter.ref);
+      _handle = _bindings.lrm_midi_in_open_decoded(
+        observer,
+        portId,
+        _callback!.nativeFunction,
+        _parameterCallback!.nativeFunction,
+        nullptr,
+        nativeFilter,
+        decoding.flags,
+        decoding.fourteenBitMask,
+        timestampMode.nativeValue,
+        receiveSysex,
+        receiveTiming,
+        receiveSensing,
+      );
+    } finally {
+      if (nativeFilter != nullptr) calloc.free(nativeFilter);
+    }
+
+    if (_handle == nullptr) {
+      _parameterCallback?.close();
+      _chunkCallback?.close();
+    } else {
+      _filtered = filter != null;
+      _decoded = true;
+    }
+  }
+
+  MidiInput._ring(
+    Pointer<LrmObserver> observer,
+    int portId, {
+    required int capacity,
+    required MidiOverflowPolicy overflowPolicy,
+    required Duration? pollInterval,
+    required bool receiveSysex,
+    required bool receiveTiming,
+    required bool receiveSensing,
+    required MidiTimestampMode timestampMode,
+  }) {
+    _handle = _bindings.lrm_midi_in_open_ring(
       observer,
       portId,
-      _callback!.nativeFunction,
-      nullptr,
+      capacity,
+      overflowPolicy.nativeValue,
+      timestampMode.nativeValue,
       receiveSysex,
       receiveTiming,
       receiveSensing,
     );
 
     if (_handle == nullptr) {
-      _callback?.close();
       throw const MidiException('Failed to open MIDI input');
     }
-  }
 
-  void _onMidiMessage(
-    Pointer<Void> context,
-    Pointer<Uint8> data,
-    int length,
-    int timestamp,
-  ) {
-    if (_disposed) return;
+    // A buffer as large as the ring always fits the next message.
+    _batchCapacity = _bindings.lrm_midi_in_get_ring_capacity(_handle!);
+    _batchBuffer = calloc<Uint8>(_batchCapacity);
 
-    final bytes = Uint8List(length);
-    for (var i = 0; i < length; i++) {
-      bytes[i] = data[i];
+    if (pollInterval != null) {
+      _pollTimer = Timer.periodic(pollInterval, (_) => _drainRing());
     }
-
-    _messageController.add(MidiMessage(bytes, timestamp: timestamp));
   }
 
-  /// Stream of incoming MIDI messages.
-  ///
-  /// Note: Messages originate from native callbacks which may be invoked on
-  /// a different thread. The stream delivers events asynchronously to the
-  /// Dart isolate, so UI updates should be safe.
-  ///
-  /// **Backpressure warning:** This is an unbounded broadcast stream. If your
-  /// listener processes messages slower than they arrive (e.g., high-speed
-  /// SysEx dumps), messages will queue in memory. Consider using
-  /// [messagesFiltered] or processing messages efficiently.
-  Stream<MidiMessage> get messages => _messageController.stream;
+  MidiInput._batched(
+    Pointer<LrmObserver> observer,
+    int portId, {
+    required Duration window,
+    required int maxMessages,
+    required int maxBytes,
+    required bool receiveSysex,
+    required bool receiveTiming,
+    required bool receiveSensing,
+    required MidiTimestampMode timestampMode,
+  }) {
+    _batchCallback = NativeCallable<
+        Void Function(Pointer<Void>, Pointer<Uint8>, Size,
+            Int32)>.listener(_onMidiBatch);
 
-  /// Stream of decoded RPN / NRPN messages.
-  ///
-  /// The raw Control Change messages remain available through [messages]. This
-  /// stream creates a parser for the returned stream and emits parameter events
-  /// when a CC sequence selects an RPN/NRPN parameter and sends Data Entry.
-  Stream<RpnNrpnMessage> get rpnNrpnMessages {
-    final parser = RpnNrpnParser();
-    return _messageController.stream.expand((msg) {
-      final event = parser.process(msg);
-      return event == null ? const <RpnNrpnMessage>[] : [event];
-    });
+    _handle = _bindings.lrm_midi_in_open_batched(
+      observer,
+      portId,
+      _batchCallback!.nativeFunction,
+      nullptr,
+      window.inMicroseconds,
+      maxMessages,
+      maxBytes,
+      timestampMode.nativeValue,
+      receiveSysex,
+      receiveTiming,
+      receiveSensing,
+    );
+
+    if (_handle == nullptr) {
+      _batchCallback?.close();
+      throw const MidiException('Failed to open MIDI input');
+    }
   }
 
-  /// Stream of incoming MIDI messages with optional filtering.
-  ///
-  /// Filters out messages that exceed [maxBytes] (default: 1024) or,
-  /// optionally, all SysEx messages. This is a convenience filter on the
-  /// Dart side — note that messages are still received and allocated by the
-  /// native callback before filtering. To prevent large SysEx allocations
-  /// entirely, disable SysEx at the input level via [MidiObserver.openInput]
-  /// with `receiveSysex: false`.
-  ///
+  MidiInput._clock(
+    Pointer<LrmObserver> observer,
+    int portId, {
+    required bool suppressTicks,
+    required bool receiveSysex,
+    required bool receiveSensing,
+    required MidiTimestampMode timestampMode,
+  }) {
+    _callback = NativeCallable<
+        Void Function(Pointer<Void>, Pointer<Uint8>, Size,
+            Int64)>.listener(_onMidiMessage);
+
+    _handle = _bindings.lrm_midi_in_open_clock(
+      observer,
+      portId,
+      _callback!.nativeFunction,
+      nullptr,
+      suppressTicks,
+      timestampMode.nativeValue,
+      receiveSysex,
+      receiveSensing,
+    );
+
+    if (_handle == nullptr) {
+      _callback?.close();
+      throw const MidiException('Failed to open MIDI input');
+    }
+  }
+
+  MidiInput._timecode(
+    Pointer<LrmObserver> observer,
+    int portId, {
+    required bool suppressQuarterFrames,
+    required bool receiveSysex,
+    required bool receiveSensing,
+    required MidiTimestampMode timestampMode,
+  }) {
+    _callback = NativeCallable<
+        Void Function(Pointer<Void>, Pointer<Uint8>, Size,
+            Int64)>.listener(_onMidiMessage);
+
+    _handle = _bindings.lrm_midi_in_open_timecode(
+      observer,
+      portId,
+      _callback!.nativeFunction,
+      nullptr,
+      suppressQuarterFrames,
+      timestampMode.nativeValue,
+      receiveSysex,
+      receiveSensing,
+    );
+
+    if (_handle == nullptr) {
+      _callback?.close();
+      throw const MidiException('Failed to open MIDI input');
+    }
+  }
+
+  MidiInput._sysExStream(
+    Pointer<LrmObserver> observer,
+    int portId, {
+    required int chunkSize,
+    required int maxSysExSize,
+    required MidiSysExOverflowPolicy overflowPolicy,
+    required bool receiveTiming,
+    required bool receiveSensing,
+    required MidiTimestampMode timestampMode,
+  }) {
+    _callback = NativeCallable<
+        Void Function(Pointer<Void>, Pointer<Uint8>, Size,
+            Int64)>.listener(_onMidiMessage);
+    _chunkCallback = NativeCallable<
+        Void Function(Pointer<Void>, Pointer<Uint8>, Size, Int32,
+            Int64)>.listener(_onSysExChunk);
+
+    _handle = _bindings.lrm_midi_in_open_sysex_stream(
+      observer,
+      portId,
+      _callback!.nativeFunction,
+      _chunkCallback!.nativeFunction,
+      nullptr,
+      chunkSize,
+      maxSysExSize,
+      overflowPolicy.nativeValue,
+      timestampMode.nativeValue,
+      receiveTiming,
+      receiveSensing,
+    );
+
+    if (_handle == nullptr) {
+      _callback?.close();
+      _chunkCallback?.close();
+      throw const MidiException('Failed to open MIDI input');
+    }
+  }
+
+  void _onSysExChunk(
+    Pointer<Void> context,
+    Pointer<Uint8> data,
+    int length,
+    int flags,
+    int timestamp,
+  ) {
+    // The chunk is owned by Dart and must be released even after dispose.
+    try {
+      if (_disposed) return;
+      final bytes = Uint8List.fromList(data.asTypedList(length));
+      _sysExChunkController.add(
+        SysExChunk(bytes, flags: flags, timestamp: timestamp),
+      );
+    } finally {
+      _bindings.lrm_midi_batch_free(data);
+    }
+  }
+
+  void _onMidiBatch(
+    Pointer<Void> context,
+    Pointer<Uint8> data,
+    int length,
+    int count,
+  ) {
+    // The batch is owned by Dart and must be released even after dispose.
+    try {
+      if (_disposed) return;
+      final packed = data.asTypedList(length);
+      for (final message in MidiMessage.decodePacked(packed)) {
+        _messageController.add(message);
+      }
+    } finally {
+      _bindings.lrm_midi_batch_free(data);
+    }
+  }
+
+  void _drainRing() {
+    if (_disposed) return;
+    for (final message in readBatch()) {
+      _messageController.add(message);
+    }
+  }
+
+  void _onParameter(
+    Pointer<Void> context,
+    int kind,
+    int flags,
+    int channel,
+    int parameter,
+    int value,
+    int timestamp,
+  ) {
+    if (_disposed) return;
+
+    if (kind == LRM_PARAM_CC14) {
+      _cc14Controller.add(ControlChange14Message(
+        channel: channel,
+        controller: parameter,
+        value: value,
+        timestamp: timestamp,
+      ));
+      return;
+    }
+
+    // Rebuild the Control Change that completed the event, as the Dart
+    // parser reports it in RpnNrpnMessage.source.
+    final fourteenBit = flags & LRM_PARAM_FLAG_14BIT != 0;
+    final RpnNrpnChangeType changeType;
+    final int controller;
+    if (flags & LRM_PARAM_FLAG_INCREMENT != 0) {
+      changeType = RpnNrpnChangeType.increment;
+      controller = 96;
+    } else if (flags & LRM_PARAM_FLAG_DECREMENT != 0) {
+      changeType = RpnNrpnChangeType.decrement;
+      controller = 97;
+    } else {
+      changeType = RpnNrpnChangeType.value;
+      controller = fourteenBit ? 38 : 6;
+    }
+    final source = MidiMessage(
+      Uint8List.fromList([0xB0 | channel, controller, value & 0x7F]),
+      timestamp: timestamp,
+    );
+
+    _rpnNrpnController.add(RpnNrpnMessage(
+      type: kind == LRM_PARAM_RPN ? RpnNrpnType.rpn : RpnNrpnType.nrpn,
+      changeType: changeType,
+      channel: channel,
+      parameter: parameter,
+      value: value,
+      fourteenBit: fourteenBit,
+      source: source,
+    ));
+  }
+
+  void _onMidiMessage(
+    Pointer<Void> context,
+    Pointer<Uint8> data,
+    int length,
+    int timestamp,
+  ) {
+    if (_disposed) return;
+
+    final bytes = Uint8List(length);
+    for (var i = 0; i < length; i++) {
+      bytes[i] = data[i];
+    }
+
+    _messageController.add(MidiMessage(bytes, timestamp: timestamp));
+  }
+
+  /// Stream of incoming MIDI messages.
+  ///
+  /// Note: Messages originate from native callbacks which may be invoked on
+  /// a different thread. The stream delivers events asynchronously to the
+  /// Dart isolate, so UI updates should be safe.
+  ///
+  /// **Backpressure warning:** This is an unbounded broadcast stream. If your
+  /// listener processes messages slower than they arrive (e.g., high-speed
+  /// SysEx dumps), messages will queue in memory. Consider using
+  /// [messagesFiltered], processing messages efficiently, or opening the port
+  /// with [MidiObserver.openBufferedInput], which bounds the backlog natively.
+  Stream<MidiMessage> get messages => _messageController.stream;
+
+  /// Stream of decoded RPN / NRPN messages.
+  ///
+  /// The raw Control Change messages remain available through [messages]. This
+  /// stream creates a parser for the returned stream and emits parameter events
+  /// when a CC sequence selects an RPN/NRPN parameter and sends Data Entry.
+  ///
+  /// If the input was opened with [MidiParameterDecoding], the events are
+  /// decoded natively instead and the raw messages may be suppressed.
+  Stream<RpnNrpnMessage> get rpnNrpnMessages {
+    if (_decoded) return _rpnNrpnController.stream;
+    final parser = RpnNrpnParser();
+    return _messageController.stream.expand((msg) {
+      final event = parser.process(msg);
+      return event == null ? const <RpnNrpnMessage>[] : [event];
+    });
+  }
+
+  /// Stream of SysEx chunks for inputs opened with
+  /// [MidiObserver.openSysExStreamInput].
+  Stream<SysExChunk> get sysExChunks => _sysExChunkController.stream;
+
+  /// Number of streamed SysEx messages that were cut short, either by the
+  /// size cap or because they were never terminated.
+  int get sysExAbortedCount {
+    if (_disposed || _handle == null) return 0;
+    return _bindings.lrm_midi_in_get_sysex_aborted_count(_handle!);
+  }
+
+  /// Stream of 14-bit Control Change values decoded natively.
+  ///
+  /// Only emits for inputs opened with [MidiParameterDecoding] that list the
+  /// controllers in [MidiParameterDecoding.fourteenBitControllers].
+  Stream<ControlChange14Message> get controlChange14Messages =>
+      _cc14Controller.stream;
+
+  /// Stream of incoming MIDI messages with optional filtering.
+  ///
+  /// Filters out messages that exceed [maxBytes] (default: 1024) or,
+  /// optionally, all SysEx messages. This is a convenience filter on the
+  /// Dart side — note that messages are still received and allocated by the
+  /// native callback before filtering. To prevent large SysEx allocations
+  /// entirely, disable SysEx at the input level via [MidiObserver.openInput]
+  /// with `receiveSysex: false`, or pass a [MidiInputFilter] there.
+  ///
   /// Example:
   /// ```dart
   /// // Only receive messages up to 256 bytes
@@ -1280,19 +3489,657 @@ class MidiInput {
     return _bindings.lrm_midi_in_is_connected(_handle!);
   }
 
+  /// Whether this input buffers messages natively
+  /// (see [MidiObserver.openBufferedInput]).
+  bool get isBuffered => _batchBuffer != null;
+
+  /// Drains all messages currently buffered by a buffered input.
+  ///
+  /// Each call costs one FFI crossing per ring-full of data regardless of the
+  /// number of messages. Messages returned here are not added to [messages].
+  List<MidiMessage> readBatch() {
+    if (_disposed) {
+      throw StateError('MidiInput has been disposed');
+    }
+    final buffer = _batchBuffer;
+    if (buffer == null) {
+      throw StateError('MidiInput was not opened with openBufferedInput');
+    }
+
+    final messages = <MidiMessage>[];
+    while (true) {
+      final written = _bindings.lrm_midi_in_read_batch(
+        _handle!,
+        buffer,
+        _batchCapacity,
+      );
+      if (written < 0) {
+        throw MidiException(
+          'Failed to read buffered MIDI messages',
+          errorCode: written,
+          nativeFunction: 'lrm_midi_in_read_batch',
+        );
+      }
+      if (written == 0) break;
+      messages.addAll(MidiMessage.decodePacked(buffer.asTypedList(written)));
+    }
+    return messages;
+  }
+
+  /// Number of messages discarded because the native ring buffer was full,
+  /// or, for batched inputs, because a batch could not be allocated.
+  ///
+  /// Always 0 for inputs that are neither buffered nor batched.
+  int get droppedCount {
+    if (_disposed || _handle == null) return 0;
+    return _bindings.lrm_midi_in_get_dropped_count(_handle!);
+  }
+
+  /// Counters of this input since it was opened.
+  MidiInputStats get stats {
+    if (_disposed) {
+      throw StateError('MidiInput has been disposed');
+    }
+    final stats = calloc<LrmMidiInStats>();
+    try {
+      final result = _bindings.lrm_midi_in_get_stats(_handle!, stats);
+      if (result != LRM_OK) {
+        throw MidiException(
+          'Failed to read input statistics',
+          errorCode: result,
+          nativeFunction: 'lrm_midi_in_get_stats',
+        );
+      }
+      return MidiInputStats(
+        messages: stats.ref.messages,
+        bytes: stats.ref.bytes,
+        sysExFragments: stats.ref.sysex_fragments,
+        dropped: stats.ref.dropped,
+        filtered: stats.ref.filtered,
+        maxLatencyNanoseconds: stats.ref.max_latency_ns,
+        p99LatencyNanoseconds: stats.ref.p99_latency_ns,
+      );
+    } finally {
+      calloc.free(stats);
+    }
+  }
+
+  /// State of the incoming MIDI clock, or `null` if the input was not opened
+  /// with [MidiObserver.openClockInput].
+  MidiClockState? get clockState {
+    if (_disposed || _handle == null) return null;
+    final state = calloc<LrmClockState>();
+    try {
+      final result = _bindings.lrm_midi_in_get_clock_state(_handle!, state);
+      if (result != LRM_OK) return null;
+      return MidiClockState(
+        bpm: state.ref.bpm,
+        beatPhase: state.ref.beat_phase,
+        jitterMicroseconds: state.ref.jitter_us,
+        tickCount: state.ref.tick_count,
+        songPosition: state.ref.song_position,
+        isRunning: state.ref.running,
+      );
+    } finally {
+      calloc.free(state);
+    }
+  }
+
+  /// Position of the incoming MIDI Time Code, or `null` if the input was
+  /// not opened with [MidiObserver.openTimecodeInput].
+  MidiTimecode? get timecode {
+    if (_disposed || _handle == null) return null;
+    final position = calloc<LrmTimecode>();
+    try {
+      final result = _bindings.lrm_midi_in_get_timecode(_handle!, position);
+      if (result != LRM_OK) return null;
+      return MidiTimecode.fromNative(position.ref);
+    } finally {
+      calloc.free(position);
+    }
+  }
+
+  /// Rejection counters of the native filter passed to
+  /// [MidiObserver.openInput], or `null` if the input is not filtered.
+  MidiFilterStats? get filterStats {
+    if (_disposed || _handle == null || !_filtered) return null;
+    final stats = calloc<LrmMidiFilterStats>();
+    try {
+      final result = _bindings.lrm_midi_in_get_filter_stats(_handle!, stats);
+      if (result != LRM_OK) return null;
+      return MidiFilterStats(
+        rejectedKind: stats.ref.rejected_status,
+        rejectedChannel: stats.ref.rejected_channel,
+        rejectedNote: stats.ref.rejected_note,
+        rejectedController: stats.ref.rejected_controller,
+        rejectedSize: stats.ref.rejected_size,
+      );
+    } finally {
+      calloc.free(stats);
+    }
+  }
+
+  /// Forwards this input's messages to [output] natively, on the MIDI
+  /// backend's thread, without waking the Dart isolate (MIDI thru).
+  ///
+  /// Several routes can share an input (split) or an output (merge). Pass a
+  /// [transform] to filter, remap channels, transpose or scale velocities.
+  /// On Linux, an unchanged route between two ALSA sequencer ports becomes a
+  /// kernel connection (see [MidiRoute.isNative]), which also carries clock
+  /// and SysEx regardless of this input's settings.
+  ///
+  /// The route is disposed with either port. SysEx received by an input
+  /// opened with [MidiObserver.openSysExStreamInput] is not forwarded.
+  MidiRoute routeTo(MidiOutput output, {MidiRouteTransform? transform}) {
+    if (_disposed) {
+      throw StateError('MidiInput has been disposed');
+    }
+    output._checkDisposed();
+    final settings = calloc<LrmRouteTransform>();
+    try {
+      _bindings.lrm_route_transform_init(settings);
+      transform?.fill(settings.ref);
+      final handle = _bindings.lrm_route_create(
+        _handle!,
+        output._handle!,
+        settings,
+      );
+      if (handle == nullptr) {
+        throw const MidiException(
+          'Failed to create route',
+          nativeFunction: 'lrm_route_create',
+        );
+      }
+      final route = MidiRoute._(handle, this, output);
+      _routes.add(route);
+      output._routes.add(route);
+      return route;
+    } finally {
+      calloc.free(settings);
+    }
+  }
+
   /// Closes the input connection and releases resources.
   void dispose() {
     if (!_disposed && _handle != null) {
       // Order matters to avoid use-after-free:
       // 1. Mark disposed first to reject new callbacks in Dart
       _disposed = true;
+      for (final route in List.of(_routes)) {
+        route.dispose();
+      }
+      _pollTimer?.cancel();
       // 2. Close native MIDI input first (stops the native producer)
       _bindings.lrm_midi_in_close(_handle!);
       _handle = null;
       // 3. Now safe to close the callable (no native code can call it)
       _callback?.close();
-      // 4. Close Dart stream controller
+      _batchCallback?.close();
+      _parameterCallback?.close();
+      if (_batchBuffer != null) {
+        calloc.free(_batchBuffer!);
+        _batchBuffer = null;
+      }
+      // 4. Close Dart stream controllers
       _messageController.close();
+      _rpnNrpnController.close();
+      _cc14Controller.close();
+      _sysExChunkController.close();
+    }
+  }
+}
+
+// =============================================================================
+// MidiRoute - Native MIDI thru
+// =============================================================================
+
+/// Changes a [MidiRoute] applies to forwarded messages.
+class MidiRouteTransform {
+  /// Messages to forward, matched before any remapping. `null` forwards all.
+  final MidiInputFilter? filter;
+
+  /// Output channel (0-15) per input channel; unlisted channels keep theirs.
+  final Map<int, int> channelMap;
+
+  /// Semitones added to Note On/Off and Polyphonic Aftertouch notes. Notes
+  /// pushed outside 0-127 are dropped.
+  final int transpose;
+
+  /// Factor applied to Note On velocities; results are clamped to 1-127.
+  final double velocityScale;
+
+  const MidiRouteTransform({
+    this.filter,
+    this.channelMap = const {},
+    this.transpose = 0,
+    this.velocityScale = 1.0,
+  });
+
+  /// Writes these settings to [settings], which `lrm_route_transform_init`
+  /// has set to forward everything unchanged.
+  @visibleForTesting
+  void fill(LrmRouteTransform settings) {
+    RangeError.checkValueInInterval(transpose, -127, 127, 'transpose');
+    if (velocityScale.isNaN || velocityScale < 0) {
+      throw ArgumentError.value(
+        velocityScale,
+        'velocityScale',
+        'Must not be negative',
+      );
+    }
+    filter?._fill(settings.filter);
+    channelMap.forEach((from, to) {
+      RangeError.checkValueInInterval(from, 0, 15, 'channelMap key');
+      RangeError.checkValueInInterval(to, 0, 15, 'channelMap value');
+      settings.channel_map[from] = to;
+    });
+    settings.transpose = transpose;
+    settings.velocity_scale = velocityScale;
+  }
+}
+
+/// Counters of a [MidiRoute].
+class MidiRouteStats {
+  /// Messages sent to the output.
+  final int forwarded;
+
+  /// Messages rejected by the filter or the remapping.
+  final int dropped;
+
+  /// Messages the output refused.
+  final int sendFailures;
+
+  const MidiRouteStats({
+    required this.forwarded,
+    required this.dropped,
+    required this.sendFailures,
+  });
+
+  @override
+  String toString() => 'MidiRouteStats(forwarded: $forwarded, '
+      'dropped: $dropped, failures: $sendFailures)';
+}
+
+/// A native connection from a [MidiInput] to a [MidiOutput], created by
+/// [MidiInput.routeTo].
+class MidiRoute {
+  Pointer<LrmRoute>? _handle;
+  final MidiInput _input;
+  final MidiOutput _output;
+
+  MidiRoute._(this._handle, this._input, this._output);
+
+  /// Whether the route is a kernel-level connection made by the MIDI system
+  /// (ALSA sequencer) rather than forwarded by this plugin. Native routes
+  /// report no [stats].
+  bool get isNative {
+    final handle = _handle;
+    return handle != null && _bindings.lrm_route_is_native(handle);
+  }
+
+  /// Counters of this route since it was created.
+  MidiRouteStats get stats {
+    final handle = _handle;
+    if (handle == null) {
+      throw StateError('MidiRoute has been disposed');
+    }
+    final stats = calloc<LrmRouteStats>();
+    try {
+      _bindings.lrm_route_get_stats(handle, stats);
+      return MidiRouteStats(
+        forwarded: stats.ref.forwarded,
+        dropped: stats.ref.dropped,
+        sendFailures: stats.ref.send_failures,
+      );
+    } finally {
+      calloc.free(stats);
+    }
+  }
+
+  /// Stops forwarding. Called automatically when either port is disposed.
+  void dispose() {
+    final handle = _handle;
+    if (handle == null) return;
+    _handle = null;
+    _bindings.lrm_route_destroy(handle);
+    _input._routes.remove(this);
+    _output._routes.remove(this);
+  }
+}
+
+// =============================================================================
+// MidiClockGenerator - Native MIDI clock master
+// =============================================================================
+
+/// Sends MIDI clock (24 ticks per quarter note) and transport messages to
+/// one or more outputs.
+///
+/// Ticks are sent by a native thread on absolute deadlines, so the tempo does
+/// not drift and does not depend on the Dart event loop. Tempo and swing
+/// changes take effect from the next tick.
+///
+/// ```dart
+/// final clock = MidiClockGenerator(bpm: 120)..addOutput(output);
+/// clock.start();
+/// clock.bpm = 128;
+/// clock.stop();
+/// clock.dispose();
+/// ```
+class MidiClockGenerator {
+  Pointer<LrmClock>? _handle;
+  final List<MidiOutput> _outputs = [];
+  double _bpm;
+  double _swing = 0.5;
+  bool _tickWhenStopped = false;
+
+  /// Creates a stopped clock at [bpm] (1-999).
+  MidiClockGenerator({double bpm = 120.0}) : _bpm = bpm {
+    _checkBpm(bpm);
+    final handle = _bindings.lrm_clock_create(bpm);
+    if (handle == nullptr) {
+      throw const MidiException(
+        'Failed to create clock generator',
+        nativeFunction: 'lrm_clock_create',
+      );
+    }
+    _handle = handle;
+  }
+
+  static void _checkBpm(double bpm) {
+    if (bpm.isNaN || bpm < 1 || bpm > 999) {
+      throw RangeError.range(bpm, 1, 999, 'bpm');
+    }
+  }
+
+  Pointer<LrmClock> get _checkedHandle {
+    final handle = _handle;
+    if (handle == null) {
+      throw StateError('MidiClockGenerator has been disposed');
+    }
+    return handle;
+  }
+
+  /// Outputs the clock is sent to.
+  List<MidiOutput> get outputs => List.unmodifiable(_outputs);
+
+  /// Sends the clock to [output] as well. The output is detached
+  /// automatically when it is disposed.
+  void addOutput(MidiOutput output) {
+    output._checkDisposed();
+    if (_outputs.contains(output)) return;
+    _bindings.lrm_clock_add_output(_checkedHandle, output._handle!);
+    _outputs.add(output);
+    output._clocks.add(this);
+  }
+
+  /// Stops sending the clock to [output].
+  void removeOutput(MidiOutput output) {
+    if (!_outputs.remove(output)) return;
+    output._clocks.remove(this);
+    final handle = _handle;
+    if (handle != null && output._handle != null) {
+      _bindings.lrm_clock_remove_output(handle, output._handle!);
+    }
+  }
+
+  /// Tempo in beats per minute (1-999).
+  double get bpm => _bpm;
+  set bpm(double value) {
+    _checkBpm(value);
+    _bindings.lrm_clock_set_bpm(_checkedHandle, value);
+    _bpm = value;
+  }
+
+  /// Share of each eighth note taken by its first sixteenth: 0.5 is
+  /// straight, about 0.67 a triplet shuffle. Must be below 1.0.
+  double get swing => _swing;
+  set swing(double value) {
+    if (value.isNaN || value < 0.5 || value >= 1.0) {
+      throw ArgumentError.value(value, 'swing', 'Must be in [0.5, 1.0)');
+    }
+    _bindings.lrm_clock_set_swing(_checkedHandle, value);
+    _swing = value;
+  }
+
+  /// Whether ticks are also sent while stopped, so followers keep the tempo.
+  bool get tickWhenStopped => _tickWhenStopped;
+  set tickWhenStopped(bool value) {
+    _bindings.lrm_clock_set_tick_when_stopped(_checkedHandle, value);
+    _tickWhenStopped = value;
+  }
+
+  /// Sends Start and runs from the beginning of the song.
+  void start() => _bindings.lrm_clock_start(_checkedHandle);
+
+  /// Sends Stop.
+  void stop() => _bindings.lrm_clock_stop(_checkedHandle);
+
+  /// Sends Continue and runs from the current song position.
+  void resume() => _bindings.lrm_clock_continue(_checkedHandle);
+
+  /// Moves to [sixteenths] (0-16383) and sends a Song Position Pointer.
+  ///
+  /// Throws [MidiException] while the clock is running.
+  void setSongPosition(int sixteenths) {
+    RangeError.checkValueInInterval(sixteenths, 0, 16383, 'sixteenths');
+    final result = _bindings.lrm_clock_set_song_position(
+      _checkedHandle,
+      sixteenths,
+    );
+    if (result != LRM_OK) {
+      throw MidiException(
+        'Song position can only be set while stopped',
+        errorCode: result,
+        nativeFunction: 'lrm_clock_set_song_position',
+      );
+    }
+  }
+
+  /// Current tempo, song position and timing of the clock.
+  MidiClockState get state {
+    final handle = _checkedHandle;
+    final state = calloc<LrmClockState>();
+    try {
+      _bindings.lrm_clock_get_state(handle, state);
+      return MidiClockState(
+        bpm: state.ref.bpm,
+        beatPhase: state.ref.beat_phase,
+        jitterMicroseconds: state.ref.jitter_us,
+        tickCount: state.ref.tick_count,
+        songPosition: state.ref.song_position,
+        isRunning: state.ref.running,
+      );
+    } finally {
+      calloc.free(state);
+    }
+  }
+
+  /// Stops the clock thread without sending Stop, and detaches all outputs.
+  void dispose() {
+    final handle = _handle;
+    if (handle == null) return;
+    _handle = null;
+    _bindings.lrm_clock_destroy(handle);
+    for (final output in _outputs) {
+      output._clocks.remove(this);
+    }
+    _outputs.clear();
+  }
+}
+
+// =============================================================================
+// MidiOutputGroup - One send to many outputs
+// =============================================================================
+
+/// A set of outputs that are sent the same messages by a single native call.
+///
+/// Each member can remap channels. With `kernelFanout` on Linux, ALSA
+/// sequencer members without a channel map are fed from one sequencer port
+/// of the group that the kernel copies to each of them; such members bypass
+/// their own [MidiOutput.optimizer], asynchronous writer and statistics.
+///
+/// ```dart
+/// final group = MidiOutputGroup()
+///   ..add(lightsOut)
+///   ..add(synthOut, channelMap: {0: 3, 9: null}); // ch 1 -> 4, drop ch 10
+/// group.send(Uint8List.fromList([0x90, 60, 100]));
+/// ```
+class MidiOutputGroup {
+  Pointer<LrmMidiOutGroup>? _handle;
+  final List<MidiOutput> _outputs = [];
+
+  // Native send buffer, grown as needed
+  Pointer<Uint8> _bufferPtr = nullptr;
+  Uint8List? _buffer;
+
+  MidiOutputGroup({bool kernelFanout = false}) {
+    final handle = _bindings.lrm_midi_out_group_create(kernelFanout);
+    if (handle == nullptr) {
+      throw const MidiException(
+        'Failed to create output group',
+        nativeFunction: 'lrm_midi_out_group_create',
+      );
+    }
+    _handle = handle;
+  }
+
+  Pointer<LrmMidiOutGroup> get _checkedHandle {
+    _checkDisposed();
+    return _handle!;
+  }
+
+  void _checkDisposed() {
+    if (_handle == null) {
+      throw StateError('MidiOutputGroup has been disposed');
+    }
+  }
+
+  /// The member outputs.
+  List<MidiOutput> get outputs => List.unmodifiable(_outputs);
+
+  /// Members fed through the kernel fan-out port.
+  int get kernelFanoutCount =>
+      _bindings.lrm_midi_out_group_kernel_fanout_count(_checkedHandle);
+
+  /// Adds [output] to the group. [channelMap] sends a channel (0-15) on
+  /// another channel for this member, or leaves it out when mapped to
+  /// `null`. The output leaves the group automatically when it is disposed.
+  void add(MidiOutput output, {Map<int, int?> channelMap = const {}}) {
+    output._checkDisposed();
+    final handle = _checkedHandle;
+    if (_outputs.contains(output)) return;
+    Pointer<Int8> map = nullptr;
+    try {
+      if (channelMap.isNotEmpty) {
+        map = calloc<Int8>(16);
+        for (var channel = 0; channel < 16; channel++) {
+          map[channel] = channel;
+        }
+        channelMap.forEach((from, to) {
+          RangeError.checkValueInInterval(from, 0, 15, 'channelMap key');
+          if (to != null) {
+            RangeError.checkValueInInterval(to, 0, 15, 'channelMap value');
+          }
+          map[from] = to ?? -1;
+        });
+      }
+      final result = _bindings.lrm_midi_out_group_add(
+        handle,
+        output._handle!,
+        map,
+      );
+      if (result != LRM_OK) {
+        throw MidiException(
+          'Failed to add output to group',
+          errorCode: result,
+          nativeFunction: 'lrm_midi_out_group_add',
+        );
+      }
+    } finally {
+      if (map != nullptr) calloc.free(map);
+    }
+    _outputs.add(output);
+    output._groups.add(this);
+  }
+
+  /// Removes [output] from the group.
+  void remove(MidiOutput output) {
+    if (!_outputs.remove(output)) return;
+    output._groups.remove(this);
+    final handle = _handle;
+    if (handle != null && output._handle != null) {
+      _bindings.lrm_midi_out_group_remove(handle, output._handle!);
+    }
+  }
+
+  /// Sends one or more concatenated complete messages to every member.
+  ///
+  /// Returns the number of members that accepted them.
+  int send(Uint8List data) {
+    _checkDisposed();
+    _stage(data.length).setAll(0, data);
+    return _sendStaged(data.length);
+  }
+
+  /// Sends several complete messages to every member in one native call.
+  ///
+  /// Returns the number of members that accepted them.
+  int sendBatch(Iterable<Uint8List> messages) {
+    _checkDisposed();
+    final list = messages is List<Uint8List> ? messages : messages.toList();
+    var length = 0;
+    for (final message in list) {
+      length += message.length;
+    }
+    final buffer = _stage(length);
+    var offset = 0;
+    for (final message in list) {
+      buffer.setAll(offset, message);
+      offset += message.length;
+    }
+    return _sendStaged(length);
+  }
+
+  int _sendStaged(int length) {
+    final result = _bindings.lrm_midi_out_group_send(
+      _checkedHandle,
+      _bufferPtr,
+      length,
+    );
+    if (result < 0) {
+      throw MidiException(
+        'Failed to send to output group',
+        errorCode: result,
+        nativeFunction: 'lrm_midi_out_group_send',
+      );
+    }
+    return result;
+  }
+
+  Uint8List _stage(int length) {
+    final buffer = _buffer;
+    if (buffer != null && buffer.length >= length) return buffer;
+    final doubled = (buffer?.length ?? 128) * 2;
+    final capacity = length > doubled ? length : doubled;
+    if (_bufferPtr != nullptr) calloc.free(_bufferPtr);
+    _bufferPtr = calloc<Uint8>(capacity);
+    return _buffer = _bufferPtr.asTypedList(capacity);
+  }
+
+  /// Frees the group. The member outputs stay open.
+  void dispose() {
+    final handle = _handle;
+    if (handle == null) return;
+    _handle = null;
+    _bindings.lrm_midi_out_group_destroy(handle);
+    for (final output in _outputs) {
+      output._groups.remove(this);
+    }
+    _outputs.clear();
+    if (_bufferPtr != nullptr) {
+      calloc.free(_bufferPtr);
+      _bufferPtr = nullptr;
+      _buffer = null;
     }
   }
 }
@@ -1314,6 +4161,22 @@ class LibremidiFlutter {
     return _observer!;
   }
 
+  /// Creates the shared observer without blocking the calling isolate.
+  ///
+  /// Without it, the first call that needs the port list creates the
+  /// observer synchronously, enumerating every port on the calling thread.
+  /// Does nothing if the library is already initialized.
+  static Future<void> initialize() async {
+    if (_observer != null) return;
+    final observer = await MidiObserver.startAsync();
+    if (_observer != null) {
+      // Initialized synchronously while this one was starting
+      observer.dispose();
+      return;
+    }
+    _observer = observer;
+  }
+
   /// Whether the library has been initialized (observer created).
   static bool get isInitialized => _observer != null;
 
@@ -1323,9 +4186,44 @@ class LibremidiFlutter {
     return ptr.cast<Utf8>().toDartString();
   }
 
+  /// Current time in nanoseconds on the clock used by
+  /// [MidiTimestampMode.monotonic] inputs.
+  ///
+  /// Compare it with [MidiMessage.timestamp] to measure input latency, or use
+  /// it to align recordings from several ports.
+  static int get nowNanoseconds => _bindings.lrm_now_ns();
+
   /// Stream of hotplug events (device added/removed).
   static Stream<HotplugEventType> get onHotplug => _ensureObserver.onHotplug;
 
+  /// Stream of hotplug events with the id of the port that changed.
+  ///
+  /// See [MidiObserver.onHotplugEvent].
+  static Stream<HotplugEvent> get onHotplugEvent =>
+      _ensureObserver.onHotplugEvent;
+
+  /// Gets the input port with [portId], or null if there is none.
+  static MidiPort? findInputPort(int portId) {
+    return _ensureObserver.findInputPort(portId);
+  }
+
+  /// Gets the output port with [portId], or null if there is none.
+  static MidiPort? findOutputPort(int portId) {
+    return _ensureObserver.findOutputPort(portId);
+  }
+
+  /// Gets the input port with [stableId], or null if there is none.
+  ///
+  /// See [MidiObserver.findInputPortByStableId].
+  static MidiPort? findInputPortByStableId(int stableId) {
+    return _ensureObserver.findInputPortByStableId(stableId);
+  }
+
+  /// Gets the output port with [stableId], or null if there is none.
+  static MidiPort? findOutputPortByStableId(int stableId) {
+    return _ensureObserver.findOutputPortByStableId(stableId);
+  }
+
   /// Gets all available MIDI input ports.
   static List<MidiPort> getInputPorts() {
     return _ensureObserver.getInputPorts();
@@ -1336,6 +4234,11 @@ class LibremidiFlutter {
     return _ensureObserver.getOutputPorts();
   }
 
+  /// Gets both port lists at once. See [MidiObserver.snapshot].
+  static MidiPortSnapshot getPortSnapshot() {
+    return _ensureObserver.snapshot();
+  }
+
   /// Opens a MIDI output connection to the specified port.
   ///
   /// Throws [StateError] if the port is already open.
@@ -1348,6 +4251,27 @@ class LibremidiFlutter {
     return output;
   }
 
+  /// Opens a MIDI output whose sends are queued and performed by a native
+  /// writer thread. See [MidiObserver.openAsyncOutput].
+  ///
+  /// Throws [StateError] if the port is already open.
+  static MidiOutput openAsyncOutput(
+    MidiPort port, {
+    int queueDepth = 256,
+    MidiBackpressurePolicy backpressure = MidiBackpressurePolicy.block,
+  }) {
+    if (_openOutputs.containsKey(port.portId)) {
+      throw StateError('Output port ${port.displayName} is already open');
+    }
+    final output = _ensureObserver.openAsyncOutput(
+      port,
+      queueDepth: queueDepth,
+      backpressure: backpressure,
+    );
+    _openOutputs[port.portId] = output;
+    return output;
+  }
+
   /// Opens a MIDI input connection to the specified port.
   ///
   /// By default, SysEx messages are received, while timing (MIDI clock) and
@@ -1359,6 +4283,9 @@ class LibremidiFlutter {
     bool receiveSysex = true,
     bool receiveTiming = false,
     bool receiveSensing = false,
+    MidiTimestampMode timestampMode = MidiTimestampMode.absolute,
+    MidiInputFilter? filter,
+    MidiParameterDecoding? decoding,
   }) {
     if (_openInputs.containsKey(port.portId)) {
       throw StateError('Input port ${port.displayName} is already open');
@@ -1368,6 +4295,150 @@ class LibremidiFlutter {
       receiveSysex: receiveSysex,
       receiveTiming: receiveTiming,
       receiveSensing: receiveSensing,
+      timestampMode: timestampMode,
+      filter: filter,
+      decoding: decoding,
+    );
+    _openInputs[port.portId] = input;
+    return input;
+  }
+
+  /// Opens a MIDI input that buffers messages natively and delivers them in
+  /// batches. See [MidiObserver.openBufferedInput].
+  ///
+  /// Throws [StateError] if the port is already open.
+  static MidiInput openBufferedInput(
+    MidiPort port, {
+    int capacity = 64 * 1024,
+    MidiOverflowPolicy overflowPolicy = MidiOverflowPolicy.dropOldest,
+    Duration? pollInterval = const Duration(milliseconds: 5),
+    bool receiveSysex = true,
+    bool receiveTiming = false,
+    bool receiveSensing = false,
+    MidiTimestampMode timestampMode = MidiTimestampMode.absolute,
+  }) {
+    if (_openInputs.containsKey(port.portId)) {
+      throw StateError('Input port ${port.displayName} is already open');
+    }
+    final input = _ensureObserver.openBufferedInput(
+      port,
+      capacity: capacity,
+      overflowPolicy: overflowPolicy,
+      pollInterval: pollInterval,
+      receiveSysex: receiveSysex,
+      receiveTiming: receiveTiming,
+      receiveSensing: receiveSensing,
+      timestampMode: timestampMode,
+    );
+    _openInputs[port.portId] = input;
+    return input;
+  }
+
+  /// Opens a MIDI input that delivers messages in time-windowed batches.
+  /// See [MidiObserver.openBatchedInput].
+  ///
+  /// Throws [StateError] if the port is already open.
+  static MidiInput openBatchedInput(
+    MidiPort port, {
+    Duration window = const Duration(milliseconds: 1),
+    int maxMessages = 256,
+    int maxBytes = 16 * 1024,
+    bool receiveSysex = true,
+    bool receiveTiming = false,
+    bool receiveSensing = false,
+    MidiTimestampMode timestampMode = MidiTimestampMode.absolute,
+  }) {
+    if (_openInputs.containsKey(port.portId)) {
+      throw StateError('Input port ${port.displayName} is already open');
+    }
+    final input = _ensureObserver.openBatchedInput(
+      port,
+      window: window,
+      maxMessages: maxMessages,
+      maxBytes: maxBytes,
+      receiveSysex: receiveSysex,
+      receiveTiming: receiveTiming,
+      receiveSensing: receiveSensing,
+      timestampMode: timestampMode,
+    );
+    _openInputs[port.portId] = input;
+    return input;
+  }
+
+  /// Opens a MIDI input that streams SysEx in chunks.
+  /// See [MidiObserver.openSysExStreamInput].
+  ///
+  /// Throws [StateError] if the port is already open.
+  static MidiInput openSysExStreamInput(
+    MidiPort port, {
+    int chunkSize = 4096,
+    int? maxSysExSize,
+    MidiSysExOverflowPolicy overflowPolicy = MidiSysExOverflowPolicy.abort,
+    bool receiveTiming = false,
+    bool receiveSensing = false,
+    MidiTimestampMode timestampMode = MidiTimestampMode.absolute,
+  }) {
+    if (_openInputs.containsKey(port.portId)) {
+      throw StateError('Input port ${port.displayName} is already open');
+    }
+    final input = _ensureObserver.openSysExStreamInput(
+      port,
+      chunkSize: chunkSize,
+      maxSysExSize: maxSysExSize,
+      overflowPolicy: overflowPolicy,
+      receiveTiming: receiveTiming,
+      receiveSensing: receiveSensing,
+      timestampMode: timestampMode,
+    );
+    _openInputs[port.portId] = input;
+    return input;
+  }
+
+  /// Opens a MIDI input that follows the incoming MIDI clock natively.
+  /// See [MidiObserver.openClockInput].
+  ///
+  /// Throws [StateError] if the port is already open.
+  static MidiInput openClockInput(
+    MidiPort port, {
+    bool suppressTicks = true,
+    bool receiveSysex = true,
+    bool receiveSensing = false,
+    MidiTimestampMode timestampMode = MidiTimestampMode.absolute,
+  }) {
+    if (_openInputs.containsKey(port.portId)) {
+      throw StateError('Input port ${port.displayName} is already open');
+    }
+    final input = _ensureObserver.openClockInput(
+      port,
+      suppressTicks: suppressTicks,
+      receiveSysex: receiveSysex,
+      receiveSensing: receiveSensing,
+      timestampMode: timestampMode,
+    );
+    _openInputs[port.portId] = input;
+    return input;
+  }
+
+  /// Opens a MIDI input that reads incoming MIDI Time Code natively.
+  /// See [MidiObserver.openTimecodeInput].
+  ///
+  /// Throws [StateError] if the port is already open.
+  static MidiInput openTimecodeInput(
+    MidiPort port, {
+    bool suppressQuarterFrames = true,
+    bool receiveSysex = true,
+    bool receiveSensing = false,
+    MidiTimestampMode timestampMode = MidiTimestampMode.absolute,
+  }) {
+    if (_openInputs.containsKey(port.portId)) {
+      throw StateError('Input port ${port.displayName} is already open');
+    }
+    final input = _ensureObserver.openTimecodeInput(
+      port,
+      suppressQuarterFrames: suppressQuarterFrames,
+      receiveSysex: receiveSysex,
+      receiveSensing: receiveSensing,
+      timestampMode: timestampMode,
     );
     _openInputs[port.portId] = input;
     return input;
@@ -44,7 +44,19 @@ class LibremidiFlutterBindings {
   late final _lrm_get_version =
       _lrm_get_versionPtr.asFunction<ffi.Pointer<ffi.Char> Function()>();
 
-  /// Create a new observer for enumerating MIDI ports
+  /// Current time in nanoseconds on the clock used by LRM_TIMESTAMP_MONOTONIC
+  int lrm_now_ns() {
+    return _lrm_now_ns();
+  }
+
+  late final _lrm_now_nsPtr =
+      _lookup<ffi.NativeFunction<ffi.Int64 Function()>>(
+    'lrm_now_ns',
+  );
+  late final _lrm_now_ns = _lrm_now_nsPtr.asFunction<int Function()>();
+
+  /// Create a new observer for enumerating MIDI ports. It does not track
+  /// hotplug; call lrm_observer_refresh() to update the port lists.
   ffi.Pointer<LrmObserver> lrm_observer_new() {
     return _lrm_observer_new();
   }
@@ -77,6 +89,47 @@ class LibremidiFlutterBindings {
             ffi.Pointer<ffi.Void>,
           )>();
 
+  /// Create an observer without waiting for the backend: connecting to it and
+  /// enumerating the ports happen on another thread, which then calls callback
+  /// with event_type 5 (ready). Until then the port lists are empty and no
+  /// other events are delivered; check lrm_observer_get_status() when ready
+  /// arrives. With track_hotplug false, only ready is ever delivered.
+  /// Returns nullptr if callback is null.
+  ffi.Pointer<LrmObserver> lrm_observer_new_async(
+    LrmHotplugCallback callback,
+    ffi.Pointer<ffi.Void> context,
+    bool track_hotplug,
+  ) {
+    return _lrm_observer_new_async(callback, context, track_hotplug);
+  }
+
+  late final _lrm_observer_new_asyncPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<LrmObserver> Function(
+            LrmHotplugCallback,
+            ffi.Pointer<ffi.Void>,
+            ffi.Bool,
+          )>>('lrm_observer_new_async');
+  late final _lrm_observer_new_async = _lrm_observer_new_asyncPtr.asFunction<
+      ffi.Pointer<LrmObserver> Function(
+        LrmHotplugCallback,
+        ffi.Pointer<ffi.Void>,
+        bool,
+      )>();
+
+  /// LRM_OK once the observer is started, LRM_OBSERVER_STARTING while an
+  /// asynchronous start is running, LRM_ERR_INIT_FAILED if it failed
+  int lrm_observer_get_status(ffi.Pointer<LrmObserver> observer) {
+    return _lrm_observer_get_status(observer);
+  }
+
+  late final _lrm_observer_get_statusPtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<LrmObserver>)>>(
+    'lrm_observer_get_status',
+  );
+  late final _lrm_observer_get_status = _lrm_observer_get_statusPtr
+      .asFunction<int Function(ffi.Pointer<LrmObserver>)>();
+
   /// Free the observer
   void lrm_observer_free(ffi.Pointer<LrmObserver> observer) {
     return _lrm_observer_free(observer);
@@ -163,6 +216,126 @@ class LibremidiFlutterBindings {
   late final _lrm_observer_get_output = _lrm_observer_get_outputPtr.asFunction<
       int Function(ffi.Pointer<LrmObserver>, int, ffi.Pointer<LrmPortInfo>)>();
 
+  /// Get input port info by port_id, e.g. the one passed to the hotplug callback
+  /// (returns LRM_ERR_NOT_FOUND if the port is not in the list)
+  int lrm_observer_get_input_by_id(
+    ffi.Pointer<LrmObserver> observer,
+    int port_id,
+    ffi.Pointer<LrmPortInfo> info,
+  ) {
+    return _lrm_observer_get_input_by_id(observer, port_id, info);
+  }
+
+  late final _lrm_observer_get_input_by_idPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmObserver>,
+            ffi.Uint64,
+            ffi.Pointer<LrmPortInfo>,
+          )>>('lrm_observer_get_input_by_id');
+  late final _lrm_observer_get_input_by_id =
+      _lrm_observer_get_input_by_idPtr.asFunction<
+          int Function(
+            ffi.Pointer<LrmObserver>,
+            int,
+            ffi.Pointer<LrmPortInfo>,
+          )>();
+
+  /// Get output port info by port_id
+  int lrm_observer_get_output_by_id(
+    ffi.Pointer<LrmObserver> observer,
+    int port_id,
+    ffi.Pointer<LrmPortInfo> info,
+  ) {
+    return _lrm_observer_get_output_by_id(observer, port_id, info);
+  }
+
+  late final _lrm_observer_get_output_by_idPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmObserver>,
+            ffi.Uint64,
+            ffi.Pointer<LrmPortInfo>,
+          )>>('lrm_observer_get_output_by_id');
+  late final _lrm_observer_get_output_by_id =
+      _lrm_observer_get_output_by_idPtr.asFunction<
+          int Function(
+            ffi.Pointer<LrmObserver>,
+            int,
+            ffi.Pointer<LrmPortInfo>,
+          )>();
+
+  /// Get port info by stable_id, e.g. to find a device again after it was
+  /// reconnected. Identical devices without a serial number share a stable_id;
+  /// the first of them in the list is returned.
+  int lrm_observer_find_by_stable_id(
+    ffi.Pointer<LrmObserver> observer,
+    int stable_id,
+    bool is_input,
+    ffi.Pointer<LrmPortInfo> info,
+  ) {
+    return _lrm_observer_find_by_stable_id(observer, stable_id, is_input, info);
+  }
+
+  late final _lrm_observer_find_by_stable_idPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmObserver>,
+            ffi.Uint64,
+            ffi.Bool,
+            ffi.Pointer<LrmPortInfo>,
+          )>>('lrm_observer_find_by_stable_id');
+  late final _lrm_observer_find_by_stable_id =
+      _lrm_observer_find_by_stable_idPtr.asFunction<
+          int Function(
+            ffi.Pointer<LrmObserver>,
+            int,
+            bool,
+            ffi.Pointer<LrmPortInfo>,
+          )>();
+
+  /// Number that changes whenever the observer's port lists change, starting
+  /// from 1. Compare it with LrmPortSnapshot.generation to skip taking a new
+  /// snapshot when nothing changed.
+  int lrm_observer_get_generation(ffi.Pointer<LrmObserver> observer) {
+    return _lrm_observer_get_generation(observer);
+  }
+
+  late final _lrm_observer_get_generationPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Uint64 Function(
+              ffi.Pointer<LrmObserver>)>>('lrm_observer_get_generation');
+  late final _lrm_observer_get_generation = _lrm_observer_get_generationPtr
+      .asFunction<int Function(ffi.Pointer<LrmObserver>)>();
+
+  /// Copy both port lists into one immutable buffer, instead of one
+  /// lrm_observer_get_input/lrm_observer_get_output call per port.
+  /// Returns nullptr on failure. Release it with lrm_port_snapshot_free().
+  ffi.Pointer<LrmPortSnapshot> lrm_observer_snapshot(
+    ffi.Pointer<LrmObserver> observer,
+  ) {
+    return _lrm_observer_snapshot(observer);
+  }
+
+  late final _lrm_observer_snapshotPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<LrmPortSnapshot> Function(
+              ffi.Pointer<LrmObserver>)>>('lrm_observer_snapshot');
+  late final _lrm_observer_snapshot = _lrm_observer_snapshotPtr.asFunction<
+      ffi.Pointer<LrmPortSnapshot> Function(ffi.Pointer<LrmObserver>)>();
+
+  /// Free a snapshot returned by lrm_observer_snapshot
+  void lrm_port_snapshot_free(ffi.Pointer<LrmPortSnapshot> snapshot) {
+    return _lrm_port_snapshot_free(snapshot);
+  }
+
+  late final _lrm_port_snapshot_freePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(
+              ffi.Pointer<LrmPortSnapshot>)>>('lrm_port_snapshot_free');
+  late final _lrm_port_snapshot_free = _lrm_port_snapshot_freePtr
+      .asFunction<void Function(ffi.Pointer<LrmPortSnapshot>)>();
+
   /// Open a MIDI output port by index
   ffi.Pointer<LrmMidiOut> lrm_midi_out_open(
     ffi.Pointer<LrmObserver> observer,
@@ -193,6 +366,44 @@ class LibremidiFlutterBindings {
   late final _lrm_midi_out_open_by_id = _lrm_midi_out_open_by_idPtr.asFunction<
       ffi.Pointer<LrmMidiOut> Function(ffi.Pointer<LrmObserver>, int)>();
 
+  /// Open a MIDI output port by port_id in asynchronous mode
+  /// lrm_midi_out_send and lrm_midi_out_send_batch copy the data into a bounded
+  /// queue and return without calling the backend; a dedicated writer thread
+  /// sends the queued data in order. queue_depth is a number of sends, rounded
+  /// up to a power of two (0 selects the default of 256).
+  /// backpressure: LRM_BACKPRESSURE_BLOCK, LRM_BACKPRESSURE_DROP or
+  /// LRM_BACKPRESSURE_FAIL. Backend failures are only visible in the statistics.
+  /// Closing sends whatever is still queued first.
+  ffi.Pointer<LrmMidiOut> lrm_midi_out_open_async(
+    ffi.Pointer<LrmObserver> observer,
+    int port_id,
+    int queue_depth,
+    int backpressure,
+  ) {
+    return _lrm_midi_out_open_async(
+      observer,
+      port_id,
+      queue_depth,
+      backpressure,
+    );
+  }
+
+  late final _lrm_midi_out_open_asyncPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<LrmMidiOut> Function(
+            ffi.Pointer<LrmObserver>,
+            ffi.Uint64,
+            ffi.Uint32,
+            ffi.Int32,
+          )>>('lrm_midi_out_open_async');
+  late final _lrm_midi_out_open_async = _lrm_midi_out_open_asyncPtr.asFunction<
+      ffi.Pointer<LrmMidiOut> Function(
+        ffi.Pointer<LrmObserver>,
+        int,
+        int,
+        int,
+      )>();
+
   /// Close and free a MIDI output
   void lrm_midi_out_close(ffi.Pointer<LrmMidiOut> midi_out) {
     return _lrm_midi_out_close(midi_out);
@@ -218,6 +429,7 @@ class LibremidiFlutterBindings {
       .asFunction<bool Function(ffi.Pointer<LrmMidiOut>)>();
 
   /// Send a MIDI message
+  /// On an asynchronous output the message is queued (see lrm_midi_out_open_async)
   int lrm_midi_out_send(
     ffi.Pointer<LrmMidiOut> midi_out,
     ffi.Pointer<ffi.Uint8> data,
@@ -236,179 +448,2020 @@ class LibremidiFlutterBindings {
   late final _lrm_midi_out_send = _lrm_midi_out_sendPtr.asFunction<
       int Function(ffi.Pointer<LrmMidiOut>, ffi.Pointer<ffi.Uint8>, int)>();
 
-  /// Open a MIDI input port by index
-  /// The callback will be called on a background thread when messages arrive
-  /// receive_sysex: if true, SysEx messages (F0..F7) are passed to callback
-  /// receive_timing: if true, MIDI clock messages (F8) are passed to callback
-  /// receive_sensing: if true, active sensing messages (FE) are passed to callback
-  ffi.Pointer<LrmMidiIn> lrm_midi_in_open(
-    ffi.Pointer<LrmObserver> observer,
-    int port_index,
-    LrmMidiCallback callback,
-    ffi.Pointer<ffi.Void> context,
-    bool receive_sysex,
-    bool receive_timing,
-    bool receive_sensing,
+  /// Send several complete MIDI messages concatenated in data
+  /// Every message starts with its status byte; SysEx ends with F7. On ALSA the
+  /// whole buffer is submitted with a single drain. Returns the number of
+  /// messages sent (fewer than in data if the backend failed part way),
+  /// LRM_ERR_INVALID if data is not a sequence of complete messages (nothing is
+  /// sent), or LRM_ERR_SEND_FAILED if nothing could be sent.
+  int lrm_midi_out_send_batch(
+    ffi.Pointer<LrmMidiOut> midi_out,
+    ffi.Pointer<ffi.Uint8> data,
+    int length,
   ) {
-    return _lrm_midi_in_open(
-      observer,
-      port_index,
-      callback,
-      context,
-      receive_sysex,
-      receive_timing,
-      receive_sensing,
-    );
+    return _lrm_midi_out_send_batch(midi_out, data, length);
   }
 
-  late final _lrm_midi_in_openPtr = _lookup<
+  late final _lrm_midi_out_send_batchPtr = _lookup<
       ffi.NativeFunction<
-          ffi.Pointer<LrmMidiIn> Function(
-            ffi.Pointer<LrmObserver>,
-            ffi.Int32,
-            LrmMidiCallback,
-            ffi.Pointer<ffi.Void>,
-            ffi.Bool,
-            ffi.Bool,
-            ffi.Bool,
-          )>>('lrm_midi_in_open');
-  late final _lrm_midi_in_open = _lrm_midi_in_openPtr.asFunction<
-      ffi.Pointer<LrmMidiIn> Function(
-        ffi.Pointer<LrmObserver>,
-        int,
-        LrmMidiCallback,
-        ffi.Pointer<ffi.Void>,
-        bool,
-        bool,
-        bool,
-      )>();
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiOut>,
+            ffi.Pointer<ffi.Uint8>,
+            ffi.Size,
+          )>>('lrm_midi_out_send_batch');
+  late final _lrm_midi_out_send_batch = _lrm_midi_out_send_batchPtr.asFunction<
+      int Function(ffi.Pointer<LrmMidiOut>, ffi.Pointer<ffi.Uint8>, int)>();
 
-  /// Open a MIDI input port by port_id (stable across hotplug)
-  ffi.Pointer<LrmMidiIn> lrm_midi_in_open_by_id(
-    ffi.Pointer<LrmObserver> observer,
-    int port_id,
-    LrmMidiCallback callback,
-    ffi.Pointer<ffi.Void> context,
-    bool receive_sysex,
-    bool receive_timing,
-    bool receive_sensing,
+  /// Get the output's staging buffer, grown to hold at least size bytes
+  /// The caller writes messages into it in place and sends them with
+  /// lrm_midi_out_commit or lrm_midi_out_commit_batch, avoiding a copy and an
+  /// allocation per send. The buffer is owned by the output and stays valid
+  /// until the next lrm_midi_out_acquire with a larger size or until close.
+  /// Only one thread at a time may use it. Returns NULL if size is 0 or the
+  /// buffer cannot grow.
+  ffi.Pointer<ffi.Uint8> lrm_midi_out_acquire(
+    ffi.Pointer<LrmMidiOut> midi_out,
+    int size,
   ) {
-    return _lrm_midi_in_open_by_id(
-      observer,
-      port_id,
-      callback,
-      context,
-      receive_sysex,
-      receive_timing,
-      receive_sensing,
-    );
+    return _lrm_midi_out_acquire(midi_out, size);
   }
 
-  late final _lrm_midi_in_open_by_idPtr = _lookup<
+  late final _lrm_midi_out_acquirePtr = _lookup<
       ffi.NativeFunction<
-          ffi.Pointer<LrmMidiIn> Function(
-            ffi.Pointer<LrmObserver>,
-            ffi.Uint64,
-            LrmMidiCallback,
-            ffi.Pointer<ffi.Void>,
-            ffi.Bool,
-            ffi.Bool,
-            ffi.Bool,
-          )>>('lrm_midi_in_open_by_id');
-  late final _lrm_midi_in_open_by_id = _lrm_midi_in_open_by_idPtr.asFunction<
-      ffi.Pointer<LrmMidiIn> Function(
-        ffi.Pointer<LrmObserver>,
+          ffi.Pointer<ffi.Uint8> Function(
+              ffi.Pointer<LrmMidiOut>, ffi.Size)>>('lrm_midi_out_acquire');
+  late final _lrm_midi_out_acquire = _lrm_midi_out_acquirePtr.asFunction<
+      ffi.Pointer<ffi.Uint8> Function(ffi.Pointer<LrmMidiOut>, int)>();
+
+  /// Send the first size bytes of the staging buffer as for lrm_midi_out_send
+  int lrm_midi_out_commit(
+    ffi.Pointer<LrmMidiOut> midi_out,
+    int size,
+  ) {
+    return _lrm_midi_out_commit(midi_out, size);
+  }
+
+  late final _lrm_midi_out_commitPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+              ffi.Pointer<LrmMidiOut>, ffi.Size)>>('lrm_midi_out_commit');
+  late final _lrm_midi_out_commit = _lrm_midi_out_commitPtr
+      .asFunction<int Function(ffi.Pointer<LrmMidiOut>, int)>();
+
+  /// Send the first size bytes of the staging buffer as for
+  /// lrm_midi_out_send_batch (returns the number of messages)
+  int lrm_midi_out_commit_batch(
+    ffi.Pointer<LrmMidiOut> midi_out,
+    int size,
+  ) {
+    return _lrm_midi_out_commit_batch(midi_out, size);
+  }
+
+  late final _lrm_midi_out_commit_batchPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+              ffi.Pointer<LrmMidiOut>, ffi.Size)>>('lrm_midi_out_commit_batch');
+  late final _lrm_midi_out_commit_batch = _lrm_midi_out_commit_batchPtr
+      .asFunction<int Function(ffi.Pointer<LrmMidiOut>, int)>();
+
+  /// Schedule complete MIDI messages (as for lrm_midi_out_send_batch) to be sent
+  /// at timestamp_ns on the lrm_now_ns() clock
+  /// A native thread dispatches them in timestamp order; messages with the same
+  /// timestamp keep their order, and past timestamps are sent immediately.
+  /// Pending messages are discarded by lrm_midi_out_close() unless flushed first.
+  /// On the ALSA sequencer, messages are handed to a kernel queue 10 ms before
+  /// they are due and delivered from there; from then on they cannot be
+  /// cancelled, and close waits for them to go out.
+  int lrm_midi_out_schedule(
+    ffi.Pointer<LrmMidiOut> midi_out,
+    int timestamp_ns,
+    ffi.Pointer<ffi.Uint8> data,
+    int length,
+  ) {
+    return _lrm_midi_out_schedule(midi_out, timestamp_ns, data, length);
+  }
+
+  late final _lrm_midi_out_schedulePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiOut>,
+            ffi.Int64,
+            ffi.Pointer<ffi.Uint8>,
+            ffi.Size,
+          )>>('lrm_midi_out_schedule');
+  late final _lrm_midi_out_schedule = _lrm_midi_out_schedulePtr.asFunction<
+      int Function(
+        ffi.Pointer<LrmMidiOut>,
+        int,
+        ffi.Pointer<ffi.Uint8>,
         int,
-        LrmMidiCallback,
-        ffi.Pointer<ffi.Void>,
-        bool,
-        bool,
-        bool,
       )>();
 
-  /// Close and free a MIDI input
-  void lrm_midi_in_close(ffi.Pointer<LrmMidiIn> midi_in) {
-    return _lrm_midi_in_close(midi_in);
+  /// Discard all scheduled messages. Returns the number discarded.
+  int lrm_midi_out_cancel_scheduled(ffi.Pointer<LrmMidiOut> midi_out) {
+    return _lrm_midi_out_cancel_scheduled(midi_out);
   }
 
-  late final _lrm_midi_in_closePtr =
-      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<LrmMidiIn>)>>(
-    'lrm_midi_in_close',
+  late final _lrm_midi_out_cancel_scheduledPtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<LrmMidiOut>)>>(
+    'lrm_midi_out_cancel_scheduled',
   );
-  late final _lrm_midi_in_close =
-      _lrm_midi_in_closePtr.asFunction<void Function(ffi.Pointer<LrmMidiIn>)>();
+  late final _lrm_midi_out_cancel_scheduled = _lrm_midi_out_cancel_scheduledPtr
+      .asFunction<int Function(ffi.Pointer<LrmMidiOut>)>();
 
-  /// Check if input is connected
-  bool lrm_midi_in_is_connected(ffi.Pointer<LrmMidiIn> midi_in) {
-    return _lrm_midi_in_is_connected(midi_in);
+  /// Send all scheduled messages now, in timestamp order. Returns the number sent.
+  int lrm_midi_out_flush_scheduled(ffi.Pointer<LrmMidiOut> midi_out) {
+    return _lrm_midi_out_flush_scheduled(midi_out);
   }
 
-  late final _lrm_midi_in_is_connectedPtr =
-      _lookup<ffi.NativeFunction<ffi.Bool Function(ffi.Pointer<LrmMidiIn>)>>(
-    'lrm_midi_in_is_connected',
+  late final _lrm_midi_out_flush_scheduledPtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<LrmMidiOut>)>>(
+    'lrm_midi_out_flush_scheduled',
   );
-  late final _lrm_midi_in_is_connected = _lrm_midi_in_is_connectedPtr
-      .asFunction<bool Function(ffi.Pointer<LrmMidiIn>)>();
-}
+  late final _lrm_midi_out_flush_scheduled = _lrm_midi_out_flush_scheduledPtr
+      .asFunction<int Function(ffi.Pointer<LrmMidiOut>)>();
 
-final class LrmObserver extends ffi.Opaque {}
-
-final class LrmMidiIn extends ffi.Opaque {}
+  /// Get the number of scheduled messages not sent yet
+  int lrm_midi_out_get_scheduled_count(ffi.Pointer<LrmMidiOut> midi_out) {
+    return _lrm_midi_out_get_scheduled_count(midi_out);
+  }
 
-final class LrmMidiOut extends ffi.Opaque {}
+  late final _lrm_midi_out_get_scheduled_countPtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<LrmMidiOut>)>>(
+    'lrm_midi_out_get_scheduled_count',
+  );
+  late final _lrm_midi_out_get_scheduled_count =
+      _lrm_midi_out_get_scheduled_countPtr.asFunction<
+          int Function(ffi.Pointer<LrmMidiOut>)>();
 
-final class LrmPortInfo extends ffi.Struct {
-  /// Cross-platform stable ID (survives hotplug/reorder)
-  @ffi.Uint64()
-  external int stable_id;
+  /// Get the counters of an output (returns 0 on success, fills stats struct)
+  int lrm_midi_out_get_stats(
+    ffi.Pointer<LrmMidiOut> midi_out,
+    ffi.Pointer<LrmMidiOutStats> stats,
+  ) {
+    return _lrm_midi_out_get_stats(midi_out, stats);
+  }
 
-  /// Unique port ID (CoreMIDI: kMIDIPropertyUniqueID)
-  @ffi.Uint64()
-  external int port_id;
+  late final _lrm_midi_out_get_statsPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiOut>,
+            ffi.Pointer<LrmMidiOutStats>,
+          )>>('lrm_midi_out_get_stats');
+  late final _lrm_midi_out_get_stats = _lrm_midi_out_get_statsPtr.asFunction<
+      int Function(ffi.Pointer<LrmMidiOut>, ffi.Pointer<LrmMidiOutStats>)>();
+
+  /// Send one or more complete SysEx messages (e.g. a .syx file) in paced pieces
+  /// from a native thread. Transfers on the same output are sent one after the
+  /// other. Avoid sending other non-realtime messages on the output meanwhile, as
+  /// they would land inside the SysEx. Closing the output cancels what is left.
+  /// Returns a transfer id (> 0) for lrm_midi_out_get_sysex_transfer, or an
+  /// error code.
+  int lrm_midi_out_send_sysex_paced(
+    ffi.Pointer<LrmMidiOut> midi_out,
+    ffi.Pointer<ffi.Uint8> data,
+    int length,
+    ffi.Pointer<LrmSysexPacing> pacing,
+  ) {
+    return _lrm_midi_out_send_sysex_paced(midi_out, data, length, pacing);
+  }
+
+  late final _lrm_midi_out_send_sysex_pacedPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int64 Function(
+            ffi.Pointer<LrmMidiOut>,
+            ffi.Pointer<ffi.Uint8>,
+            ffi.Size,
+            ffi.Pointer<LrmSysexPacing>,
+          )>>('lrm_midi_out_send_sysex_paced');
+  late final _lrm_midi_out_send_sysex_paced =
+      _lrm_midi_out_send_sysex_pacedPtr.asFunction<
+          int Function(
+            ffi.Pointer<LrmMidiOut>,
+            ffi.Pointer<ffi.Uint8>,
+            int,
+            ffi.Pointer<LrmSysexPacing>,
+          )>();
+
+  /// Get the progress of a paced SysEx transfer. The state of finished transfers
+  /// is kept for the 64 most recent ones; older ids return LRM_ERR_NOT_FOUND.
+  int lrm_midi_out_get_sysex_transfer(
+    ffi.Pointer<LrmMidiOut> midi_out,
+    int transfer_id,
+    ffi.Pointer<LrmSysexTransferStatus> status,
+  ) {
+    return _lrm_midi_out_get_sysex_transfer(midi_out, transfer_id, status);
+  }
+
+  late final _lrm_midi_out_get_sysex_transferPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiOut>,
+            ffi.Int64,
+            ffi.Pointer<LrmSysexTransferStatus>,
+          )>>('lrm_midi_out_get_sysex_transfer');
+  late final _lrm_midi_out_get_sysex_transfer =
+      _lrm_midi_out_get_sysex_transferPtr.asFunction<
+          int Function(
+            ffi.Pointer<LrmMidiOut>,
+            int,
+            ffi.Pointer<LrmSysexTransferStatus>,
+          )>();
+
+  /// Cancel a paced SysEx transfer, or all of them with transfer_id 0. A message
+  /// cut short is terminated with F7.
+  int lrm_midi_out_cancel_sysex(
+    ffi.Pointer<LrmMidiOut> midi_out,
+    int transfer_id,
+  ) {
+    return _lrm_midi_out_cancel_sysex(midi_out, transfer_id);
+  }
+
+  late final _lrm_midi_out_cancel_sysexPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiOut>,
+            ffi.Int64,
+          )>>('lrm_midi_out_cancel_sysex');
+  late final _lrm_midi_out_cancel_sysex = _lrm_midi_out_cancel_sysexPtr
+      .asFunction<int Function(ffi.Pointer<LrmMidiOut>, int)>();
+
+  /// Route lrm_midi_out_send and lrm_midi_out_send_batch through an optimizer
+  /// that drops repeated controller values, coalesces fast controller movements
+  /// and paces output (see LrmMidiOptimizer). Delayed messages are sent from a
+  /// pacing thread. NULL settings remove the optimizer after sending whatever it
+  /// still holds. Safe to call while routes, clocks or generators send to the
+  /// output from their own threads.
+  int lrm_midi_out_set_optimizer(
+    ffi.Pointer<LrmMidiOut> midi_out,
+    ffi.Pointer<LrmMidiOptimizer> settings,
+  ) {
+    return _lrm_midi_out_set_optimizer(midi_out, settings);
+  }
+
+  late final _lrm_midi_out_set_optimizerPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiOut>,
+            ffi.Pointer<LrmMidiOptimizer>,
+          )>>('lrm_midi_out_set_optimizer');
+  late final _lrm_midi_out_set_optimizer =
+      _lrm_midi_out_set_optimizerPtr.asFunction<
+          int Function(
+              ffi.Pointer<LrmMidiOut>, ffi.Pointer<LrmMidiOptimizer>)>();
+
+  /// Get the counters of the output's optimizer (all 0 without an optimizer)
+  int lrm_midi_out_get_optimizer_stats(
+    ffi.Pointer<LrmMidiOut> midi_out,
+    ffi.Pointer<LrmMidiOptimizerStats> stats,
+  ) {
+    return _lrm_midi_out_get_optimizer_stats(midi_out, stats);
+  }
+
+  late final _lrm_midi_out_get_optimizer_statsPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiOut>,
+            ffi.Pointer<LrmMidiOptimizerStats>,
+          )>>('lrm_midi_out_get_optimizer_stats');
+  late final _lrm_midi_out_get_optimizer_stats =
+      _lrm_midi_out_get_optimizer_statsPtr.asFunction<
+          int Function(
+              ffi.Pointer<LrmMidiOut>, ffi.Pointer<LrmMidiOptimizerStats>)>();
+
+  /// Send MIDI Time Code from position onwards: a full-frame message to locate,
+  /// then quarter frames at position->rate from a native thread. Restarts from
+  /// the new position if already running.
+  /// Returns LRM_ERR_INVALID for an invalid position or rate.
+  int lrm_midi_out_start_timecode(
+    ffi.Pointer<LrmMidiOut> midi_out,
+    ffi.Pointer<LrmTimecode> position,
+  ) {
+    return _lrm_midi_out_start_timecode(midi_out, position);
+  }
+
+  late final _lrm_midi_out_start_timecodePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiOut>,
+            ffi.Pointer<LrmTimecode>,
+          )>>('lrm_midi_out_start_timecode');
+  late final _lrm_midi_out_start_timecode =
+      _lrm_midi_out_start_timecodePtr.asFunction<
+          int Function(ffi.Pointer<LrmMidiOut>, ffi.Pointer<LrmTimecode>)>();
+
+  /// Stop sending quarter frames
+  int lrm_midi_out_stop_timecode(ffi.Pointer<LrmMidiOut> midi_out) {
+    return _lrm_midi_out_stop_timecode(midi_out);
+  }
+
+  late final _lrm_midi_out_stop_timecodePtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<LrmMidiOut>)>>(
+    'lrm_midi_out_stop_timecode',
+  );
+  late final _lrm_midi_out_stop_timecode = _lrm_midi_out_stop_timecodePtr
+      .asFunction<int Function(ffi.Pointer<LrmMidiOut>)>();
+
+  /// Get the position of the generated timecode
+  /// Returns LRM_ERR_INVALID if timecode was never started on this output.
+  int lrm_midi_out_get_timecode(
+    ffi.Pointer<LrmMidiOut> midi_out,
+    ffi.Pointer<LrmTimecode> position,
+  ) {
+    return _lrm_midi_out_get_timecode(midi_out, position);
+  }
+
+  late final _lrm_midi_out_get_timecodePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiOut>,
+            ffi.Pointer<LrmTimecode>,
+          )>>('lrm_midi_out_get_timecode');
+  late final _lrm_midi_out_get_timecode =
+      _lrm_midi_out_get_timecodePtr.asFunction<
+          int Function(ffi.Pointer<LrmMidiOut>, ffi.Pointer<LrmTimecode>)>();
+
+  /// Render an automation curve natively: from the first point's value through
+  /// each later point, sampled settings->rate_hz times per second by a native
+  /// thread and sent when the value changes. A curve already running on the
+  /// same target (channel and controller, pitch bend, or NRPN parameter) is
+  /// cancelled. Returns the curve id (> 0) or a negative error code.
+  int lrm_midi_out_automate(
+    ffi.Pointer<LrmMidiOut> midi_out,
+    ffi.Pointer<LrmAutomation> settings,
+    ffi.Pointer<LrmAutomationPoint> points,
+    int count,
+  ) {
+    return _lrm_midi_out_automate(midi_out, settings, points, count);
+  }
+
+  late final _lrm_midi_out_automatePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int64 Function(
+            ffi.Pointer<LrmMidiOut>,
+            ffi.Pointer<LrmAutomation>,
+            ffi.Pointer<LrmAutomationPoint>,
+            ffi.Size,
+          )>>('lrm_midi_out_automate');
+  late final _lrm_midi_out_automate = _lrm_midi_out_automatePtr.asFunction<
+      int Function(
+        ffi.Pointer<LrmMidiOut>,
+        ffi.Pointer<LrmAutomation>,
+        ffi.Pointer<LrmAutomationPoint>,
+        int,
+      )>();
+
+  /// Stop a curve where it is, or every curve with curve_id 0
+  /// Returns LRM_ERR_NOT_FOUND if no such curve is running.
+  int lrm_midi_out_cancel_automation(
+    ffi.Pointer<LrmMidiOut> midi_out,
+    int curve_id,
+  ) {
+    return _lrm_midi_out_cancel_automation(midi_out, curve_id);
+  }
+
+  late final _lrm_midi_out_cancel_automationPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiOut>,
+            ffi.Int64,
+          )>>('lrm_midi_out_cancel_automation');
+  late final _lrm_midi_out_cancel_automation =
+      _lrm_midi_out_cancel_automationPtr.asFunction<
+          int Function(ffi.Pointer<LrmMidiOut>, int)>();
+
+  /// Whether a curve is still running
+  bool lrm_midi_out_is_automating(
+    ffi.Pointer<LrmMidiOut> midi_out,
+    int curve_id,
+  ) {
+    return _lrm_midi_out_is_automating(midi_out, curve_id);
+  }
+
+  late final _lrm_midi_out_is_automatingPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Bool Function(
+            ffi.Pointer<LrmMidiOut>,
+            ffi.Int64,
+          )>>('lrm_midi_out_is_automating');
+  late final _lrm_midi_out_is_automating = _lrm_midi_out_is_automatingPtr
+      .asFunction<bool Function(ffi.Pointer<LrmMidiOut>, int)>();
+
+  /// Get the automation counters of an output (all 0 before the first curve)
+  int lrm_midi_out_get_automation_stats(
+    ffi.Pointer<LrmMidiOut> midi_out,
+    ffi.Pointer<LrmAutomationStats> stats,
+  ) {
+    return _lrm_midi_out_get_automation_stats(midi_out, stats);
+  }
+
+  late final _lrm_midi_out_get_automation_statsPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiOut>,
+            ffi.Pointer<LrmAutomationStats>,
+          )>>('lrm_midi_out_get_automation_stats');
+  late final _lrm_midi_out_get_automation_stats =
+      _lrm_midi_out_get_automation_statsPtr.asFunction<
+          int Function(
+              ffi.Pointer<LrmMidiOut>, ffi.Pointer<LrmAutomationStats>)>();
+
+  /// Open a MIDI input port by index
+  /// The callback will be called on a background thread when messages arrive
+  /// receive_sysex: if true, SysEx messages (F0..F7) are passed to callback
+  /// receive_timing: if true, MIDI clock messages (F8) are passed to callback
+  /// receive_sensing: if true, active sensing messages (FE) are passed to callback
+  ffi.Pointer<LrmMidiIn> lrm_midi_in_open(
+    ffi.Pointer<LrmObserver> observer,
+    int port_index,
+    LrmMidiCallback callback,
+    ffi.Pointer<ffi.Void> context,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing,
+  ) {
+    return _lrm_midi_in_open(
+      observer,
+      port_index,
+      callback,
+      context,
+      receive_sysex,
+      receive_timing,
+      receive_sensing,
+    );
+  }
+
+  late final _lrm_midi_in_openPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<LrmMidiIn> Function(
+            ffi.Pointer<LrmObserver>,
+            ffi.Int32,
+            LrmMidiCallback,
+            ffi.Pointer<ffi.Void>,
+            ffi.Bool,
+            ffi.Bool,
+            ffi.Bool,
+          )>>('lrm_midi_in_open');
+  late final _lrm_midi_in_open = _lrm_midi_in_openPtr.asFunction<
+      ffi.Pointer<LrmMidiIn> Function(
+        ffi.Pointer<LrmObserver>,
+        int,
+        LrmMidiCallback,
+        ffi.Pointer<ffi.Void>,
+        bool,
+        bool,
+        bool,
+      )>();
+
+  /// Open a MIDI input port by port_id (stable across hotplug)
+  ffi.Pointer<LrmMidiIn> lrm_midi_in_open_by_id(
+    ffi.Pointer<LrmObserver> observer,
+    int port_id,
+    LrmMidiCallback callback,
+    ffi.Pointer<ffi.Void> context,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing,
+  ) {
+    return _lrm_midi_in_open_by_id(
+      observer,
+      port_id,
+      callback,
+      context,
+      receive_sysex,
+      receive_timing,
+      receive_sensing,
+    );
+  }
+
+  late final _lrm_midi_in_open_by_idPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<LrmMidiIn> Function(
+            ffi.Pointer<LrmObserver>,
+            ffi.Uint64,
+            LrmMidiCallback,
+            ffi.Pointer<ffi.Void>,
+            ffi.Bool,
+            ffi.Bool,
+            ffi.Bool,
+          )>>('lrm_midi_in_open_by_id');
+  late final _lrm_midi_in_open_by_id = _lrm_midi_in_open_by_idPtr.asFunction<
+      ffi.Pointer<LrmMidiIn> Function(
+        ffi.Pointer<LrmObserver>,
+        int,
+        LrmMidiCallback,
+        ffi.Pointer<ffi.Void>,
+        bool,
+        bool,
+        bool,
+      )>();
+
+  /// Close and free a MIDI input
+  void lrm_midi_in_close(ffi.Pointer<LrmMidiIn> midi_in) {
+    return _lrm_midi_in_close(midi_in);
+  }
+
+  late final _lrm_midi_in_closePtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<LrmMidiIn>)>>(
+    'lrm_midi_in_close',
+  );
+  late final _lrm_midi_in_close =
+      _lrm_midi_in_closePtr.asFunction<void Function(ffi.Pointer<LrmMidiIn>)>();
+
+  /// Check if input is connected
+  bool lrm_midi_in_is_connected(ffi.Pointer<LrmMidiIn> midi_in) {
+    return _lrm_midi_in_is_connected(midi_in);
+  }
+
+  late final _lrm_midi_in_is_connectedPtr =
+      _lookup<ffi.NativeFunction<ffi.Bool Function(ffi.Pointer<LrmMidiIn>)>>(
+    'lrm_midi_in_is_connected',
+  );
+  late final _lrm_midi_in_is_connected = _lrm_midi_in_is_connectedPtr
+      .asFunction<bool Function(ffi.Pointer<LrmMidiIn>)>();
+
+  /// Get the counters of an input (returns 0 on success, fills stats struct)
+  int lrm_midi_in_get_stats(
+    ffi.Pointer<LrmMidiIn> midi_in,
+    ffi.Pointer<LrmMidiInStats> stats,
+  ) {
+    return _lrm_midi_in_get_stats(midi_in, stats);
+  }
+
+  late final _lrm_midi_in_get_statsPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiIn>,
+            ffi.Pointer<LrmMidiInStats>,
+          )>>('lrm_midi_in_get_stats');
+  late final _lrm_midi_in_get_stats = _lrm_midi_in_get_statsPtr.asFunction<
+      int Function(ffi.Pointer<LrmMidiIn>, ffi.Pointer<LrmMidiInStats>)>();
+
+  /// Open a MIDI input port by port_id with a choice of timestamp domain
+  /// lrm_midi_in_open_by_id always uses LRM_TIMESTAMP_ABSOLUTE. The extended
+  /// lrm_midi_in_open_* functions below take the same timestamp_mode argument.
+  /// timestamp_mode: one of LRM_TIMESTAMP_*
+  ffi.Pointer<LrmMidiIn> lrm_midi_in_open_timestamped(
+    ffi.Pointer<LrmObserver> observer,
+    int port_id,
+    LrmMidiCallback callback,
+    ffi.Pointer<ffi.Void> context,
+    int timestamp_mode,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing,
+  ) {
+    return _lrm_midi_in_open_timestamped(
+      observer,
+      port_id,
+      callback,
+      context,
+      timestamp_mode,
+      receive_sysex,
+      receive_timing,
+      receive_sensing,
+    );
+  }
+
+  late final _lrm_midi_in_open_timestampedPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<LrmMidiIn> Function(
+            ffi.Pointer<LrmObserver>,
+            ffi.Uint64,
+            LrmMidiCallback,
+            ffi.Pointer<ffi.Void>,
+            ffi.Int32,
+            ffi.Bool,
+            ffi.Bool,
+            ffi.Bool,
+          )>>('lrm_midi_in_open_timestamped');
+  late final _lrm_midi_in_open_timestamped =
+      _lrm_midi_in_open_timestampedPtr.asFunction<
+          ffi.Pointer<LrmMidiIn> Function(
+            ffi.Pointer<LrmObserver>,
+            int,
+            LrmMidiCallback,
+            ffi.Pointer<ffi.Void>,
+            int,
+            bool,
+            bool,
+            bool,
+          )>();
+
+  /// Open a MIDI input port by port_id in ring-buffer mode
+  /// Instead of invoking a callback per message, the backend thread writes
+  /// messages into a bounded lock-free ring that is drained with
+  /// lrm_midi_in_read_batch(). capacity is in bytes and is rounded up to a
+  /// power of two (0 selects the default of 64 KiB).
+  /// overflow_policy: LRM_OVERFLOW_DROP_OLDEST or LRM_OVERFLOW_DROP_NEWEST
+  ffi.Pointer<LrmMidiIn> lrm_midi_in_open_ring(
+    ffi.Pointer<LrmObserver> observer,
+    int port_id,
+    int capacity,
+    int overflow_policy,
+    int timestamp_mode,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing,
+  ) {
+    return _lrm_midi_in_open_ring(
+      observer,
+      port_id,
+      capacity,
+      overflow_policy,
+      timestamp_mode,
+      receive_sysex,
+      receive_timing,
+      receive_sensing,
+    );
+  }
+
+  late final _lrm_midi_in_open_ringPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<LrmMidiIn> Function(
+            ffi.Pointer<LrmObserver>,
+            ffi.Uint64,
+            ffi.Size,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Bool,
+            ffi.Bool,
+            ffi.Bool,
+          )>>('lrm_midi_in_open_ring');
+  late final _lrm_midi_in_open_ring = _lrm_midi_in_open_ringPtr.asFunction<
+      ffi.Pointer<LrmMidiIn> Function(
+        ffi.Pointer<LrmObserver>,
+        int,
+        int,
+        int,
+        int,
+        bool,
+        bool,
+        bool,
+      )>();
+
+  /// Drain buffered messages from a ring-mode input into buf as packed records
+  /// Only whole records are copied. Returns the number of bytes written (0 when
+  /// empty), LRM_ERR_BUFFER_TOO_SMALL if the next message does not fit into an
+  /// empty buf, or LRM_ERR_INVALID if the input was not opened in ring mode.
+  /// A buf as large as the ring capacity always makes progress.
+  int lrm_midi_in_read_batch(
+    ffi.Pointer<LrmMidiIn> midi_in,
+    ffi.Pointer<ffi.Uint8> buf,
+    int capacity,
+  ) {
+    return _lrm_midi_in_read_batch(midi_in, buf, capacity);
+  }
+
+  late final _lrm_midi_in_read_batchPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiIn>,
+            ffi.Pointer<ffi.Uint8>,
+            ffi.Size,
+          )>>('lrm_midi_in_read_batch');
+  late final _lrm_midi_in_read_batch = _lrm_midi_in_read_batchPtr.asFunction<
+      int Function(ffi.Pointer<LrmMidiIn>, ffi.Pointer<ffi.Uint8>, int)>();
+
+  /// Get the ring capacity in bytes of a ring-mode input (0 otherwise)
+  int lrm_midi_in_get_ring_capacity(ffi.Pointer<LrmMidiIn> midi_in) {
+    return _lrm_midi_in_get_ring_capacity(midi_in);
+  }
+
+  late final _lrm_midi_in_get_ring_capacityPtr =
+      _lookup<ffi.NativeFunction<ffi.Size Function(ffi.Pointer<LrmMidiIn>)>>(
+    'lrm_midi_in_get_ring_capacity',
+  );
+  late final _lrm_midi_in_get_ring_capacity = _lrm_midi_in_get_ring_capacityPtr
+      .asFunction<int Function(ffi.Pointer<LrmMidiIn>)>();
+
+  /// Get the number of messages discarded because the ring was full, or, for a
+  /// batched input, because the batch buffer could not be allocated
+  int lrm_midi_in_get_dropped_count(ffi.Pointer<LrmMidiIn> midi_in) {
+    return _lrm_midi_in_get_dropped_count(midi_in);
+  }
+
+  late final _lrm_midi_in_get_dropped_countPtr =
+      _lookup<ffi.NativeFunction<ffi.Uint64 Function(ffi.Pointer<LrmMidiIn>)>>(
+    'lrm_midi_in_get_dropped_count',
+  );
+  late final _lrm_midi_in_get_dropped_count = _lrm_midi_in_get_dropped_countPtr
+      .asFunction<int Function(ffi.Pointer<LrmMidiIn>)>();
+
+  /// Open a MIDI input port by port_id with batched delivery
+  /// Messages are coalesced and passed to callback as packed records. A batch is
+  /// delivered when it holds max_messages messages or max_bytes bytes, or
+  /// window_us microseconds after its first message arrived, whichever comes
+  /// first. Zero selects the defaults (1000 us, 256 messages, 16 KiB).
+  /// Messages that do not fit because a batch buffer cannot be allocated are
+  /// counted in lrm_midi_in_get_dropped_count() and LrmMidiInStats.dropped.
+  ffi.Pointer<LrmMidiIn> lrm_midi_in_open_batched(
+    ffi.Pointer<LrmObserver> observer,
+    int port_id,
+    LrmMidiBatchCallback callback,
+    ffi.Pointer<ffi.Void> context,
+    int window_us,
+    int max_messages,
+    int max_bytes,
+    int timestamp_mode,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing,
+  ) {
+    return _lrm_midi_in_open_batched(
+      observer,
+      port_id,
+      callback,
+      context,
+      window_us,
+      max_messages,
+      max_bytes,
+      timestamp_mode,
+      receive_sysex,
+      receive_timing,
+      receive_sensing,
+    );
+  }
+
+  late final _lrm_midi_in_open_batchedPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<LrmMidiIn> Function(
+            ffi.Pointer<LrmObserver>,
+            ffi.Uint64,
+            LrmMidiBatchCallback,
+            ffi.Pointer<ffi.Void>,
+            ffi.Uint32,
+            ffi.Uint32,
+            ffi.Uint32,
+            ffi.Int32,
+            ffi.Bool,
+            ffi.Bool,
+            ffi.Bool,
+          )>>('lrm_midi_in_open_batched');
+  late final _lrm_midi_in_open_batched =
+      _lrm_midi_in_open_batchedPtr.asFunction<
+          ffi.Pointer<LrmMidiIn> Function(
+            ffi.Pointer<LrmObserver>,
+            int,
+            LrmMidiBatchCallback,
+            ffi.Pointer<ffi.Void>,
+            int,
+            int,
+            int,
+            int,
+            bool,
+            bool,
+            bool,
+          )>();
+
+  /// Release a buffer received through LrmMidiBatchCallback or LrmSysexChunkCallback
+  void lrm_midi_batch_free(ffi.Pointer<ffi.Uint8> data) {
+    return _lrm_midi_batch_free(data);
+  }
+
+  late final _lrm_midi_batch_freePtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<ffi.Uint8>)>>(
+    'lrm_midi_batch_free',
+  );
+  late final _lrm_midi_batch_free = _lrm_midi_batch_freePtr
+      .asFunction<void Function(ffi.Pointer<ffi.Uint8>)>();
+
+  /// Fill filter with settings that accept every message
+  void lrm_midi_filter_init(ffi.Pointer<LrmMidiFilter> filter) {
+    return _lrm_midi_filter_init(filter);
+  }
+
+  late final _lrm_midi_filter_initPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(
+              ffi.Pointer<LrmMidiFilter>)>>('lrm_midi_filter_init');
+  late final _lrm_midi_filter_init = _lrm_midi_filter_initPtr
+      .asFunction<void Function(ffi.Pointer<LrmMidiFilter>)>();
+
+  /// Open a MIDI input port by port_id with a native filter
+  /// Messages rejected by filter are counted and never reach the callback.
+  /// The filter is copied; it may be freed once this call returns.
+  ffi.Pointer<LrmMidiIn> lrm_midi_in_open_filtered(
+    ffi.Pointer<LrmObserver> observer,
+    int port_id,
+    LrmMidiCallback callback,
+    ffi.Pointer<ffi.Void> context,
+    ffi.Pointer<LrmMidiFilter> filter,
+    int timestamp_mode,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing,
+  ) {
+    return _lrm_midi_in_open_filtered(
+      observer,
+      port_id,
+      callback,
+      context,
+      filter,
+      timestamp_mode,
+      receive_sysex,
+      receive_timing,
+      receive_sensing,
+    );
+  }
+
+  late final _lrm_midi_in_open_filteredPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<LrmMidiIn> Function(
+            ffi.Pointer<LrmObserver>,
+            ffi.Uint64,
+            LrmMidiCallback,
+            ffi.Pointer<ffi.Void>,
+            ffi.Pointer<LrmMidiFilter>,
+            ffi.Int32,
+            ffi.Bool,
+            ffi.Bool,
+            ffi.Bool,
+          )>>('lrm_midi_in_open_filtered');
+  late final _lrm_midi_in_open_filtered =
+      _lrm_midi_in_open_filteredPtr.asFunction<
+          ffi.Pointer<LrmMidiIn> Function(
+            ffi.Pointer<LrmObserver>,
+            int,
+            LrmMidiCallback,
+            ffi.Pointer<ffi.Void>,
+            ffi.Pointer<LrmMidiFilter>,
+            int,
+            bool,
+            bool,
+            bool,
+          )>();
+
+  /// Open a MIDI input port by port_id with native RPN/NRPN and 14-bit CC decoding
+  /// Decoded events go to param_callback; all other messages go to callback.
+  /// cc14_mask selects which controllers 0-31 are paired with their LSB
+  /// (controller + 32), bit n = controller n. filter may be NULL.
+  /// decode_flags: combination of LRM_DECODE_*
+  ffi.Pointer<LrmMidiIn> lrm_midi_in_open_decoded(
+    ffi.Pointer<LrmObserver> observer,
+    int port_id,
+    LrmMidiCallback callback,
+    LrmParameterCallback param_callback,
+    ffi.Pointer<ffi.Void> context,
+    ffi.Pointer<LrmMidiFilter> filter,
+    int decode_flags,
+    int cc14_mask,
+    int timestamp_mode,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing,
+  ) {
+    return _lrm_midi_in_open_decoded(
+      observer,
+      port_id,
+      callback,
+      param_callback,
+      context,
+      filter,
+      decode_flags,
+      cc14_mask,
+      timestamp_mode,
+      receive_sysex,
+      receive_timing,
+      receive_sensing,
+    );
+  }
+
+  late final _lrm_midi_in_open_decodedPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<LrmMidiIn> Function(
+            ffi.Pointer<LrmObserver>,
+            ffi.Uint64,
+            LrmMidiCallback,
+            LrmParameterCallback,
+            ffi.Pointer<ffi.Void>,
+            ffi.Pointer<LrmMidiFilter>,
+            ffi.Uint32,
+            ffi.Uint32,
+            ffi.Int32,
+            ffi.Bool,
+            ffi.Bool,
+            ffi.Bool,
+          )>>('lrm_midi_in_open_decoded');
+  late final _lrm_midi_in_open_decoded =
+      _lrm_midi_in_open_decodedPtr.asFunction<
+          ffi.Pointer<LrmMidiIn> Function(
+            ffi.Pointer<LrmObserver>,
+            int,
+            LrmMidiCallback,
+            LrmParameterCallback,
+            ffi.Pointer<ffi.Void>,
+            ffi.Pointer<LrmMidiFilter>,
+            int,
+            int,
+            int,
+            bool,
+            bool,
+            bool,
+          )>();
+
+  /// Open a MIDI input port by port_id with chunked SysEx streaming
+  /// SysEx is not reassembled; it is passed to chunk_callback in chunks of at
+  /// most chunk_size bytes (0 selects 4 KiB) as it arrives. All other messages
+  /// go to callback. max_sysex_size caps a single message (0 = no limit), and
+  /// overflow_policy (LRM_SYSEX_OVERFLOW_*) decides how an oversized one ends.
+  ffi.Pointer<LrmMidiIn> lrm_midi_in_open_sysex_stream(
+    ffi.Pointer<LrmObserver> observer,
+    int port_id,
+    LrmMidiCallback callback,
+    LrmSysexChunkCallback chunk_callback,
+    ffi.Pointer<ffi.Void> context,
+    int chunk_size,
+    int max_sysex_size,
+    int overflow_policy,
+    int timestamp_mode,
+    bool receive_timing,
+    bool receive_sensing,
+  ) {
+    return _lrm_midi_in_open_sysex_stream(
+      observer,
+      port_id,
+      callback,
+      chunk_callback,
+      context,
+      chunk_size,
+      max_sysex_size,
+      overflow_policy,
+      timestamp_mode,
+      receive_timing,
+      receive_sensing,
+    );
+  }
+
+  late final _lrm_midi_in_open_sysex_streamPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<LrmMidiIn> Function(
+            ffi.Pointer<LrmObserver>,
+            ffi.Uint64,
+            LrmMidiCallback,
+            LrmSysexChunkCallback,
+            ffi.Pointer<ffi.Void>,
+            ffi.Uint32,
+            ffi.Uint32,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Bool,
+            ffi.Bool,
+          )>>('lrm_midi_in_open_sysex_stream');
+  late final _lrm_midi_in_open_sysex_stream =
+      _lrm_midi_in_open_sysex_streamPtr.asFunction<
+          ffi.Pointer<LrmMidiIn> Function(
+            ffi.Pointer<LrmObserver>,
+            int,
+            LrmMidiCallback,
+            LrmSysexChunkCallback,
+            ffi.Pointer<ffi.Void>,
+            int,
+            int,
+            int,
+            int,
+            bool,
+            bool,
+          )>();
+
+  /// Get the number of streamed SysEx messages that were cut short, either by
+  /// max_sysex_size or because they were never terminated
+  int lrm_midi_in_get_sysex_aborted_count(ffi.Pointer<LrmMidiIn> midi_in) {
+    return _lrm_midi_in_get_sysex_aborted_count(midi_in);
+  }
+
+  late final _lrm_midi_in_get_sysex_aborted_countPtr =
+      _lookup<ffi.NativeFunction<ffi.Uint64 Function(ffi.Pointer<LrmMidiIn>)>>(
+    'lrm_midi_in_get_sysex_aborted_count',
+  );
+  late final _lrm_midi_in_get_sysex_aborted_count =
+      _lrm_midi_in_get_sysex_aborted_countPtr.asFunction<
+          int Function(ffi.Pointer<LrmMidiIn>)>();
+
+  /// Open a MIDI input port by port_id with a native clock tracker
+  /// Clock ticks (F8), Start/Continue/Stop and Song Position Pointer are
+  /// consumed natively; poll the result with lrm_midi_in_get_clock_state().
+  /// If suppress_ticks is true, F8 ticks are not passed to callback; the
+  /// transport messages always are.
+  ffi.Pointer<LrmMidiIn> lrm_midi_in_open_clock(
+    ffi.Pointer<LrmObserver> observer,
+    int port_id,
+    LrmMidiCallback callback,
+    ffi.Pointer<ffi.Void> context,
+    bool suppress_ticks,
+    int timestamp_mode,
+    bool receive_sysex,
+    bool receive_sensing,
+  ) {
+    return _lrm_midi_in_open_clock(
+      observer,
+      port_id,
+      callback,
+      context,
+      suppress_ticks,
+      timestamp_mode,
+      receive_sysex,
+      receive_sensing,
+    );
+  }
+
+  late final _lrm_midi_in_open_clockPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<LrmMidiIn> Function(
+            ffi.Pointer<LrmObserver>,
+            ffi.Uint64,
+            LrmMidiCallback,
+            ffi.Pointer<ffi.Void>,
+            ffi.Bool,
+            ffi.Int32,
+            ffi.Bool,
+            ffi.Bool,
+          )>>('lrm_midi_in_open_clock');
+  late final _lrm_midi_in_open_clock = _lrm_midi_in_open_clockPtr.asFunction<
+      ffi.Pointer<LrmMidiIn> Function(
+        ffi.Pointer<LrmObserver>,
+        int,
+        LrmMidiCallback,
+        ffi.Pointer<ffi.Void>,
+        bool,
+        int,
+        bool,
+        bool,
+      )>();
+
+  /// Get the tempo, phase, song position and jitter of the tracked clock
+  /// Returns LRM_OK, or LRM_ERR_INVALID if the input does not track the clock.
+  int lrm_midi_in_get_clock_state(
+    ffi.Pointer<LrmMidiIn> midi_in,
+    ffi.Pointer<LrmClockState> state,
+  ) {
+    return _lrm_midi_in_get_clock_state(midi_in, state);
+  }
+
+  late final _lrm_midi_in_get_clock_statePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiIn>,
+            ffi.Pointer<LrmClockState>,
+          )>>('lrm_midi_in_get_clock_state');
+  late final _lrm_midi_in_get_clock_state =
+      _lrm_midi_in_get_clock_statePtr.asFunction<
+          int Function(ffi.Pointer<LrmMidiIn>, ffi.Pointer<LrmClockState>)>();
+
+  /// Open a MIDI input port by port_id with a native MIDI Time Code reader
+  /// Quarter frames (F1) and full-frame SysEx are decoded natively; poll the
+  /// position with lrm_midi_in_get_timecode(). If suppress_quarter_frames is
+  /// true, quarter frames are not passed to callback. Timing messages are
+  /// received, so clock ticks (F8) reach callback.
+  ffi.Pointer<LrmMidiIn> lrm_midi_in_open_timecode(
+    ffi.Pointer<LrmObserver> observer,
+    int port_id,
+    LrmMidiCallback callback,
+    ffi.Pointer<ffi.Void> context,
+    bool suppress_quarter_frames,
+    int timestamp_mode,
+    bool receive_sysex,
+    bool receive_sensing,
+  ) {
+    return _lrm_midi_in_open_timecode(
+      observer,
+      port_id,
+      callback,
+      context,
+      suppress_quarter_frames,
+      timestamp_mode,
+      receive_sysex,
+      receive_sensing,
+    );
+  }
+
+  late final _lrm_midi_in_open_timecodePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<LrmMidiIn> Function(
+            ffi.Pointer<LrmObserver>,
+            ffi.Uint64,
+            LrmMidiCallback,
+            ffi.Pointer<ffi.Void>,
+            ffi.Bool,
+            ffi.Int32,
+            ffi.Bool,
+            ffi.Bool,
+          )>>('lrm_midi_in_open_timecode');
+  late final _lrm_midi_in_open_timecode =
+      _lrm_midi_in_open_timecodePtr.asFunction<
+          ffi.Pointer<LrmMidiIn> Function(
+            ffi.Pointer<LrmObserver>,
+            int,
+            LrmMidiCallback,
+            ffi.Pointer<ffi.Void>,
+            bool,
+            int,
+            bool,
+            bool,
+          )>();
+
+  /// Get the SMPTE position and lock status of the incoming timecode
+  /// Returns LRM_OK, or LRM_ERR_INVALID if the input does not read timecode.
+  int lrm_midi_in_get_timecode(
+    ffi.Pointer<LrmMidiIn> midi_in,
+    ffi.Pointer<LrmTimecode> position,
+  ) {
+    return _lrm_midi_in_get_timecode(midi_in, position);
+  }
+
+  late final _lrm_midi_in_get_timecodePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiIn>,
+            ffi.Pointer<LrmTimecode>,
+          )>>('lrm_midi_in_get_timecode');
+  late final _lrm_midi_in_get_timecode =
+      _lrm_midi_in_get_timecodePtr.asFunction<
+          int Function(ffi.Pointer<LrmMidiIn>, ffi.Pointer<LrmTimecode>)>();
+
+  /// Get the per-criterion rejection counters of a filtered input
+  /// Returns LRM_OK, or LRM_ERR_INVALID if the input has no filter.
+  int lrm_midi_in_get_filter_stats(
+    ffi.Pointer<LrmMidiIn> midi_in,
+    ffi.Pointer<LrmMidiFilterStats> stats,
+  ) {
+    return _lrm_midi_in_get_filter_stats(midi_in, stats);
+  }
+
+  late final _lrm_midi_in_get_filter_statsPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiIn>,
+            ffi.Pointer<LrmMidiFilterStats>,
+          )>>('lrm_midi_in_get_filter_stats');
+  late final _lrm_midi_in_get_filter_stats =
+      _lrm_midi_in_get_filter_statsPtr.asFunction<
+          int Function(
+              ffi.Pointer<LrmMidiIn>, ffi.Pointer<LrmMidiFilterStats>)>();
+
+  /// Initialize a transform that forwards every message unchanged
+  void lrm_route_transform_init(ffi.Pointer<LrmRouteTransform> transform) {
+    return _lrm_route_transform_init(transform);
+  }
+
+  late final _lrm_route_transform_initPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(
+              ffi.Pointer<LrmRouteTransform>)>>('lrm_route_transform_init');
+  late final _lrm_route_transform_init = _lrm_route_transform_initPtr
+      .asFunction<void Function(ffi.Pointer<LrmRouteTransform>)>();
+
+  /// Forward messages from an input to an output on the input's backend thread,
+  /// without going through Dart. Several routes can share an input (split) or an
+  /// output (merge). transform may be NULL to forward unchanged.
+  /// When both ports are ALSA sequencer ports and nothing is changed, the route
+  /// is a kernel connection instead (see lrm_route_is_native): it then carries
+  /// everything the source sends, including clock and SysEx.
+  /// SysEx received by a streaming input (lrm_midi_in_open_sysex_stream) is not
+  /// forwarded. Destroy the route before closing either port.
+  ffi.Pointer<LrmRoute> lrm_route_create(
+    ffi.Pointer<LrmMidiIn> midi_in,
+    ffi.Pointer<LrmMidiOut> midi_out,
+    ffi.Pointer<LrmRouteTransform> transform,
+  ) {
+    return _lrm_route_create(midi_in, midi_out, transform);
+  }
+
+  late final _lrm_route_createPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<LrmRoute> Function(
+            ffi.Pointer<LrmMidiIn>,
+            ffi.Pointer<LrmMidiOut>,
+            ffi.Pointer<LrmRouteTransform>,
+          )>>('lrm_route_create');
+  late final _lrm_route_create = _lrm_route_createPtr.asFunction<
+      ffi.Pointer<LrmRoute> Function(
+        ffi.Pointer<LrmMidiIn>,
+        ffi.Pointer<LrmMidiOut>,
+        ffi.Pointer<LrmRouteTransform>,
+      )>();
+
+  /// Whether the route is a kernel-level connection rather than forwarded by us
+  bool lrm_route_is_native(ffi.Pointer<LrmRoute> route) {
+    return _lrm_route_is_native(route);
+  }
+
+  late final _lrm_route_is_nativePtr =
+      _lookup<ffi.NativeFunction<ffi.Bool Function(ffi.Pointer<LrmRoute>)>>(
+    'lrm_route_is_native',
+  );
+  late final _lrm_route_is_native = _lrm_route_is_nativePtr
+      .asFunction<bool Function(ffi.Pointer<LrmRoute>)>();
+
+  /// Get the counters of a route (returns 0 on success, fills stats struct)
+  int lrm_route_get_stats(
+    ffi.Pointer<LrmRoute> route,
+    ffi.Pointer<LrmRouteStats> stats,
+  ) {
+    return _lrm_route_get_stats(route, stats);
+  }
+
+  late final _lrm_route_get_statsPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmRoute>,
+            ffi.Pointer<LrmRouteStats>,
+          )>>('lrm_route_get_stats');
+  late final _lrm_route_get_stats = _lrm_route_get_statsPtr.asFunction<
+      int Function(ffi.Pointer<LrmRoute>, ffi.Pointer<LrmRouteStats>)>();
+
+  /// Stop forwarding and free the route
+  void lrm_route_destroy(ffi.Pointer<LrmRoute> route) {
+    return _lrm_route_destroy(route);
+  }
+
+  late final _lrm_route_destroyPtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<LrmRoute>)>>(
+    'lrm_route_destroy',
+  );
+  late final _lrm_route_destroy =
+      _lrm_route_destroyPtr.asFunction<void Function(ffi.Pointer<LrmRoute>)>();
+
+  /// Create a MIDI clock master, stopped, at the given tempo (1 - 999 BPM).
+  /// It sends 24 ticks (F8) per quarter note to every attached output from its
+  /// own thread, scheduled on absolute deadlines so the tempo does not drift.
+  /// Returns NULL on failure.
+  ffi.Pointer<LrmClock> lrm_clock_create(double bpm) {
+    return _lrm_clock_create(bpm);
+  }
+
+  late final _lrm_clock_createPtr =
+      _lookup<ffi.NativeFunction<ffi.Pointer<LrmClock> Function(ffi.Double)>>(
+    'lrm_clock_create',
+  );
+  late final _lrm_clock_create =
+      _lrm_clock_createPtr.asFunction<ffi.Pointer<LrmClock> Function(double)>();
+
+  /// Stop the clock thread and free the clock (sends nothing, not even Stop)
+  void lrm_clock_destroy(ffi.Pointer<LrmClock> clock) {
+    return _lrm_clock_destroy(clock);
+  }
+
+  late final _lrm_clock_destroyPtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<LrmClock>)>>(
+    'lrm_clock_destroy',
+  );
+  late final _lrm_clock_destroy =
+      _lrm_clock_destroyPtr.asFunction<void Function(ffi.Pointer<LrmClock>)>();
+
+  /// Attach an output. Detach it (or destroy the clock) before closing it.
+  /// Returns LRM_ERR_INVALID if it is already attached.
+  int lrm_clock_add_output(
+    ffi.Pointer<LrmClock> clock,
+    ffi.Pointer<LrmMidiOut> midi_out,
+  ) {
+    return _lrm_clock_add_output(clock, midi_out);
+  }
+
+  late final _lrm_clock_add_outputPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmClock>,
+            ffi.Pointer<LrmMidiOut>,
+          )>>('lrm_clock_add_output');
+  late final _lrm_clock_add_output = _lrm_clock_add_outputPtr.asFunction<
+      int Function(ffi.Pointer<LrmClock>, ffi.Pointer<LrmMidiOut>)>();
+
+  /// Detach an output; returns once the clock no longer sends to it
+  int lrm_clock_remove_output(
+    ffi.Pointer<LrmClock> clock,
+    ffi.Pointer<LrmMidiOut> midi_out,
+  ) {
+    return _lrm_clock_remove_output(clock, midi_out);
+  }
+
+  late final _lrm_clock_remove_outputPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmClock>,
+            ffi.Pointer<LrmMidiOut>,
+          )>>('lrm_clock_remove_output');
+  late final _lrm_clock_remove_output = _lrm_clock_remove_outputPtr.asFunction<
+      int Function(ffi.Pointer<LrmClock>, ffi.Pointer<LrmMidiOut>)>();
+
+  /// Change the tempo (1 - 999 BPM), from the next tick on
+  int lrm_clock_set_bpm(
+    ffi.Pointer<LrmClock> clock,
+    double bpm,
+  ) {
+    return _lrm_clock_set_bpm(clock, bpm);
+  }
+
+  late final _lrm_clock_set_bpmPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+              ffi.Pointer<LrmClock>, ffi.Double)>>('lrm_clock_set_bpm');
+  late final _lrm_clock_set_bpm = _lrm_clock_set_bpmPtr
+      .asFunction<int Function(ffi.Pointer<LrmClock>, double)>();
+
+  /// Set the swing, from the next tick on: the share of each eighth note taken
+  /// by its first sixteenth, from 0.5 (straight) to below 1.0
+  int lrm_clock_set_swing(
+    ffi.Pointer<LrmClock> clock,
+    double swing,
+  ) {
+    return _lrm_clock_set_swing(clock, swing);
+  }
+
+  late final _lrm_clock_set_swingPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+              ffi.Pointer<LrmClock>, ffi.Double)>>('lrm_clock_set_swing');
+  late final _lrm_clock_set_swing = _lrm_clock_set_swingPtr
+      .asFunction<int Function(ffi.Pointer<LrmClock>, double)>();
+
+  /// Keep sending ticks while stopped, so followers can hold the tempo
+  int lrm_clock_set_tick_when_stopped(
+    ffi.Pointer<LrmClock> clock,
+    bool enabled,
+  ) {
+    return _lrm_clock_set_tick_when_stopped(clock, enabled);
+  }
+
+  late final _lrm_clock_set_tick_when_stoppedPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmClock>,
+            ffi.Bool,
+          )>>('lrm_clock_set_tick_when_stopped');
+  late final _lrm_clock_set_tick_when_stopped =
+      _lrm_clock_set_tick_when_stoppedPtr.asFunction<
+          int Function(ffi.Pointer<LrmClock>, bool)>();
+
+  /// Send Start (FA) and run from song position 0. Does nothing while running.
+  int lrm_clock_start(ffi.Pointer<LrmClock> clock) {
+    return _lrm_clock_start(clock);
+  }
+
+  late final _lrm_clock_startPtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<LrmClock>)>>(
+    'lrm_clock_start',
+  );
+  late final _lrm_clock_start =
+      _lrm_clock_startPtr.asFunction<int Function(ffi.Pointer<LrmClock>)>();
+
+  /// Send Stop (FC). Does nothing while stopped.
+  int lrm_clock_stop(ffi.Pointer<LrmClock> clock) {
+    return _lrm_clock_stop(clock);
+  }
+
+  late final _lrm_clock_stopPtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<LrmClock>)>>(
+    'lrm_clock_stop',
+  );
+  late final _lrm_clock_stop =
+      _lrm_clock_stopPtr.asFunction<int Function(ffi.Pointer<LrmClock>)>();
+
+  /// Send Continue (FB) and run from the current song position
+  int lrm_clock_continue(ffi.Pointer<LrmClock> clock) {
+    return _lrm_clock_continue(clock);
+  }
+
+  late final _lrm_clock_continuePtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<LrmClock>)>>(
+    'lrm_clock_continue',
+  );
+  late final _lrm_clock_continue =
+      _lrm_clock_continuePtr.asFunction<int Function(ffi.Pointer<LrmClock>)>();
+
+  /// Move to a song position in sixteenth notes (0 - 16383) and send it (F2).
+  /// Returns LRM_ERR_INVALID while running.
+  int lrm_clock_set_song_position(
+    ffi.Pointer<LrmClock> clock,
+    int sixteenths,
+  ) {
+    return _lrm_clock_set_song_position(clock, sixteenths);
+  }
+
+  late final _lrm_clock_set_song_positionPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmClock>,
+            ffi.Uint32,
+          )>>('lrm_clock_set_song_position');
+  late final _lrm_clock_set_song_position = _lrm_clock_set_song_positionPtr
+      .asFunction<int Function(ffi.Pointer<LrmClock>, int)>();
+
+  /// Get the tempo, position and timing of the clock (returns 0 on success)
+  int lrm_clock_get_state(
+    ffi.Pointer<LrmClock> clock,
+    ffi.Pointer<LrmClockState> state,
+  ) {
+    return _lrm_clock_get_state(clock, state);
+  }
+
+  late final _lrm_clock_get_statePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmClock>,
+            ffi.Pointer<LrmClockState>,
+          )>>('lrm_clock_get_state');
+  late final _lrm_clock_get_state = _lrm_clock_get_statePtr.asFunction<
+      int Function(ffi.Pointer<LrmClock>, ffi.Pointer<LrmClockState>)>();
+
+  /// Create an empty group of outputs that are sent the same messages by one
+  /// call. With kernel_fanout, ALSA sequencer members added without a channel
+  /// map are fed from a single sequencer port of the group, which the kernel
+  /// copies to each of them; those members' optimizers, writer threads and
+  /// statistics are bypassed. kernel_fanout is ignored on other backends.
+  /// Returns NULL on failure.
+  ffi.Pointer<LrmMidiOutGroup> lrm_midi_out_group_create(bool kernel_fanout) {
+    return _lrm_midi_out_group_create(kernel_fanout);
+  }
+
+  late final _lrm_midi_out_group_createPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Pointer<LrmMidiOutGroup> Function(
+              ffi.Bool)>>('lrm_midi_out_group_create');
+  late final _lrm_midi_out_group_create = _lrm_midi_out_group_createPtr
+      .asFunction<ffi.Pointer<LrmMidiOutGroup> Function(bool)>();
+
+  /// Free the group (its member outputs stay open)
+  void lrm_midi_out_group_destroy(ffi.Pointer<LrmMidiOutGroup> group) {
+    return _lrm_midi_out_group_destroy(group);
+  }
+
+  late final _lrm_midi_out_group_destroyPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Void Function(
+              ffi.Pointer<LrmMidiOutGroup>)>>('lrm_midi_out_group_destroy');
+  late final _lrm_midi_out_group_destroy = _lrm_midi_out_group_destroyPtr
+      .asFunction<void Function(ffi.Pointer<LrmMidiOutGroup>)>();
+
+  /// Add an output. channel_map, if not NULL, holds 16 entries: the channel
+  /// (0-15) each channel is sent on for this member, or -1 to leave it out.
+  /// Remove the output (or destroy the group) before closing it.
+  /// Returns LRM_ERR_INVALID if the output is already a member.
+  int lrm_midi_out_group_add(
+    ffi.Pointer<LrmMidiOutGroup> group,
+    ffi.Pointer<LrmMidiOut> midi_out,
+    ffi.Pointer<ffi.Int8> channel_map,
+  ) {
+    return _lrm_midi_out_group_add(group, midi_out, channel_map);
+  }
+
+  late final _lrm_midi_out_group_addPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiOutGroup>,
+            ffi.Pointer<LrmMidiOut>,
+            ffi.Pointer<ffi.Int8>,
+          )>>('lrm_midi_out_group_add');
+  late final _lrm_midi_out_group_add = _lrm_midi_out_group_addPtr.asFunction<
+      int Function(
+        ffi.Pointer<LrmMidiOutGroup>,
+        ffi.Pointer<LrmMidiOut>,
+        ffi.Pointer<ffi.Int8>,
+      )>();
+
+  /// Remove an output; returns LRM_ERR_NOT_FOUND if it is not a member
+  int lrm_midi_out_group_remove(
+    ffi.Pointer<LrmMidiOutGroup> group,
+    ffi.Pointer<LrmMidiOut> midi_out,
+  ) {
+    return _lrm_midi_out_group_remove(group, midi_out);
+  }
+
+  late final _lrm_midi_out_group_removePtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiOutGroup>,
+            ffi.Pointer<LrmMidiOut>,
+          )>>('lrm_midi_out_group_remove');
+  late final _lrm_midi_out_group_remove =
+      _lrm_midi_out_group_removePtr.asFunction<
+          int Function(
+              ffi.Pointer<LrmMidiOutGroup>, ffi.Pointer<LrmMidiOut>)>();
+
+  /// Send one or more concatenated complete messages to every member
+  /// Returns the number of members that accepted them, or LRM_ERR_INVALID for
+  /// empty or malformed data.
+  int lrm_midi_out_group_send(
+    ffi.Pointer<LrmMidiOutGroup> group,
+    ffi.Pointer<ffi.Uint8> data,
+    int length,
+  ) {
+    return _lrm_midi_out_group_send(group, data, length);
+  }
+
+  late final _lrm_midi_out_group_sendPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiOutGroup>,
+            ffi.Pointer<ffi.Uint8>,
+            ffi.Size,
+          )>>('lrm_midi_out_group_send');
+  late final _lrm_midi_out_group_send = _lrm_midi_out_group_sendPtr.asFunction<
+      int Function(
+        ffi.Pointer<LrmMidiOutGroup>,
+        ffi.Pointer<ffi.Uint8>,
+        int,
+      )>();
+
+  /// Number of members fed through the group's kernel fan-out port
+  int lrm_midi_out_group_kernel_fanout_count(
+    ffi.Pointer<LrmMidiOutGroup> group,
+  ) {
+    return _lrm_midi_out_group_kernel_fanout_count(group);
+  }
+
+  late final _lrm_midi_out_group_kernel_fanout_countPtr = _lookup<
+      ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<LrmMidiOutGroup>,
+          )>>('lrm_midi_out_group_kernel_fanout_count');
+  late final _lrm_midi_out_group_kernel_fanout_count =
+      _lrm_midi_out_group_kernel_fanout_countPtr.asFunction<
+          int Function(ffi.Pointer<LrmMidiOutGroup>)>();
+}
+
+final class LrmObserver extends ffi.Opaque {}
+
+final class LrmMidiIn extends ffi.Opaque {}
+
+final class LrmMidiOut extends ffi.Opaque {}
+
+final class LrmRoute extends ffi.Opaque {}
+
+final class LrmClock extends ffi.Opaque {}
+
+final class LrmMidiOutGroup extends ffi.Opaque {}
+
+final class LrmPortInfo extends ffi.Struct {
+  /// Cross-platform stable ID (survives hotplug/reorder)
+  @ffi.Uint64()
+  external int stable_id;
+
+  /// Unique port ID (CoreMIDI: kMIDIPropertyUniqueID)
+  @ffi.Uint64()
+  external int port_id;
 
   /// API client handle
   @ffi.Uint64()
-  external int client_handle;
+  external int client_handle;
+
+  /// Index in enumeration (may change on hotplug)
+  @ffi.Int32()
+  external int index;
+
+  /// Full display name (e.g. "IAC Driver Bus 1")
+  @ffi.Array.multi([256])
+  external ffi.Array<ffi.Char> display_name;
+
+  /// Port name (e.g. "Bus 1")
+  @ffi.Array.multi([256])
+  external ffi.Array<ffi.Char> port_name;
+
+  /// Device/model name (e.g. "IAC Driver")
+  @ffi.Array.multi([256])
+  external ffi.Array<ffi.Char> device_name;
+
+  /// Manufacturer name
+  @ffi.Array.multi([256])
+  external ffi.Array<ffi.Char> manufacturer;
+
+  /// Product name
+  @ffi.Array.multi([256])
+  external ffi.Array<ffi.Char> product;
+
+  /// Serial number (often empty)
+  @ffi.Array.multi([128])
+  external ffi.Array<ffi.Char> serial;
+
+  /// Transport type (software, usb, bluetooth, etc.)
+  @ffi.Uint8()
+  external int transport_type;
+
+  /// true = input, false = output
+  @ffi.Bool()
+  external bool is_input;
+
+  /// true if virtual/software port
+  @ffi.Bool()
+  external bool is_virtual;
+}
+
+/// One port of an LrmPortSnapshot. Names are offsets of NUL-terminated UTF-8
+/// strings in the snapshot's string table.
+final class LrmPortRecord extends ffi.Struct {
+  /// Same as LrmPortInfo
+  @ffi.Uint64()
+  external int stable_id;
+
+  @ffi.Uint64()
+  external int port_id;
+
+  @ffi.Uint64()
+  external int client_handle;
+
+  /// String table offsets; 0 is the empty string
+  @ffi.Uint32()
+  external int display_name;
+
+  @ffi.Uint32()
+  external int port_name;
+
+  @ffi.Uint32()
+  external int device_name;
+
+  @ffi.Uint32()
+  external int manufacturer;
+
+  @ffi.Uint32()
+  external int product;
+
+  @ffi.Uint32()
+  external int serial;
+
+  /// Index in its direction's enumeration
+  @ffi.Int32()
+  external int index;
+
+  @ffi.Uint8()
+  external int transport_type;
+
+  @ffi.Bool()
+  external bool is_input;
+
+  @ffi.Bool()
+  external bool is_virtual;
+}
+
+/// Immutable copy of an observer's port lists, allocated as a single block
+/// together with its records and strings (see lrm_observer_snapshot)
+final class LrmPortSnapshot extends ffi.Struct {
+  /// lrm_observer_get_generation() when it was taken
+  @ffi.Uint64()
+  external int generation;
 
-  /// Index in enumeration (may change on hotplug)
+  @ffi.Uint32()
+  external int input_count;
+
+  @ffi.Uint32()
+  external int output_count;
+
+  /// Bytes in strings
+  @ffi.Uint32()
+  external int strings_size;
+
+  /// input_count inputs, then output_count outputs
+  external ffi.Pointer<LrmPortRecord> ports;
+
+  /// Deduplicated string table
+  external ffi.Pointer<ffi.Char> strings;
+}
+
+/// Settings of lrm_midi_out_set_optimizer. Applies to Control Change, Pitch
+/// Bend, Channel Pressure and Poly Pressure messages; other messages are never
+/// dropped and keep their order relative to everything else.
+final class LrmMidiOptimizer extends ffi.Struct {
+  /// Drop a value equal to the last one for the same controller
+  @ffi.Bool()
+  external bool drop_duplicates;
+
+  /// Send at most one value per controller per interval (0: off)
+  @ffi.Uint32()
+  external int coalesce_interval_us;
+
+  /// Pace all output to this rate (0: unlimited; DIN MIDI is 3125)
+  @ffi.Uint32()
+  external int max_bytes_per_second;
+}
+
+/// Counters of an output optimizer (lrm_midi_out_get_optimizer_stats)
+final class LrmMidiOptimizerStats extends ffi.Struct {
+  /// Messages dropped as repeated values
+  @ffi.Uint64()
+  external int duplicates;
+
+  /// Messages replaced by a newer value before being sent
+  @ffi.Uint64()
+  external int coalesced;
+
+  /// Messages held back by the interval or the byte rate
+  @ffi.Uint64()
+  external int delayed;
+
+  /// Messages waiting to be sent
+  @ffi.Uint64()
+  external int pending;
+}
+
+/// Pacing of lrm_midi_out_send_sysex_paced. The waits add up: after each piece
+/// the next one starts after chunk_delay_us and once the byte rate allows it.
+final class LrmSysexPacing extends ffi.Struct {
+  /// Largest piece of a message in bytes (0: whole messages)
+  @ffi.Uint32()
+  external int chunk_size;
+
+  /// Pause after each piece
+  @ffi.Uint32()
+  external int chunk_delay_us;
+
+  /// Average rate limit (0: unlimited)
+  @ffi.Uint32()
+  external int max_bytes_per_second;
+}
+
+/// Progress of a paced SysEx transfer (lrm_midi_out_get_sysex_transfer)
+final class LrmSysexTransferStatus extends ffi.Struct {
+  @ffi.Uint64()
+  external int bytes_sent;
+
+  @ffi.Uint64()
+  external int bytes_total;
+
+  /// LRM_SYSEX_TX_*
   @ffi.Int32()
-  external int index;
+  external int state;
+}
 
-  /// Full display name (e.g. "IAC Driver Bus 1")
-  @ffi.Array.multi([256])
-  external ffi.Array<ffi.Char> display_name;
+/// Target and sampling of lrm_midi_out_automate
+final class LrmAutomation extends ffi.Struct {
+  /// LRM_AUTOMATION_*
+  @ffi.Int32()
+  external int target;
 
-  /// Port name (e.g. "Bus 1")
-  @ffi.Array.multi([256])
-  external ffi.Array<ffi.Char> port_name;
+  /// 0-15
+  @ffi.Uint8()
+  external int channel;
 
-  /// Device/model name (e.g. "IAC Driver")
-  @ffi.Array.multi([256])
-  external ffi.Array<ffi.Char> device_name;
+  /// Controller or NRPN parameter, per target
+  @ffi.Uint16()
+  external int number;
 
-  /// Manufacturer name
-  @ffi.Array.multi([256])
-  external ffi.Array<ffi.Char> manufacturer;
+  /// Values computed per second (at most 2000); 0 for 100
+  @ffi.Uint32()
+  external int rate_hz;
+}
 
-  /// Product name
-  @ffi.Array.multi([256])
-  external ffi.Array<ffi.Char> product;
+/// Breakpoint of an automation curve
+final class LrmAutomationPoint extends ffi.Struct {
+  /// Time from the previous point; for the first point, a start delay
+  @ffi.Uint32()
+  external int duration_us;
 
-  /// Serial number (often empty)
-  @ffi.Array.multi([128])
-  external ffi.Array<ffi.Char> serial;
+  /// 0.0 - 1.0 of the target's range
+  @ffi.Float()
+  external double value;
 
-  /// Transport type (software, usb, bluetooth, etc.)
+  /// LRM_SEGMENT_* of the segment ending here
+  @ffi.Int32()
+  external int shape;
+
+  /// Exponential steepness: > 0 starts slowly, < 0 quickly; 0 for 4
+  @ffi.Float()
+  external double curvature;
+}
+
+/// Counters of an output's automation (lrm_midi_out_get_automation_stats)
+final class LrmAutomationStats extends ffi.Struct {
+  /// Values sent
+  @ffi.Uint64()
+  external int updates;
+
+  /// Samples not sent because the value had not changed
+  @ffi.Uint64()
+  external int unchanged;
+
+  /// Curves currently running
+  @ffi.Uint32()
+  external int running;
+}
+
+/// Native input filter, evaluated on the backend thread before delivery.
+/// Initialize with lrm_midi_filter_init() so unset fields let everything pass.
+final class LrmMidiFilter extends ffi.Struct {
+  /// Accepted message kinds (LRM_FILTER_*)
+  @ffi.Uint32()
+  external int status_mask;
+
+  /// Accepted channels, bit n = channel n (0-15)
+  @ffi.Uint16()
+  external int channel_mask;
+
+  /// Lowest accepted note (note on/off, poly aftertouch)
   @ffi.Uint8()
-  external int transport_type;
+  external int note_min;
 
-  /// true = input, false = output
+  /// Highest accepted note
+  @ffi.Uint8()
+  external int note_max;
+
+  /// Lowest accepted control change number
+  @ffi.Uint8()
+  external int controller_min;
+
+  /// Highest accepted control change number
+  @ffi.Uint8()
+  external int controller_max;
+
+  /// Largest accepted message in bytes (0 = no limit)
+  @ffi.Uint32()
+  external int max_size;
+}
+
+/// Number of messages rejected by each LrmMidiFilter criterion
+final class LrmMidiFilterStats extends ffi.Struct {
+  /// Message kind not in status_mask
+  @ffi.Uint64()
+  external int rejected_status;
+
+  /// Channel not in channel_mask
+  @ffi.Uint64()
+  external int rejected_channel;
+
+  /// Note outside note_min..note_max
+  @ffi.Uint64()
+  external int rejected_note;
+
+  /// Controller outside controller_min..controller_max
+  @ffi.Uint64()
+  external int rejected_controller;
+
+  /// Message larger than max_size
+  @ffi.Uint64()
+  external int rejected_size;
+}
+
+/// Changes applied by a route (lrm_route_create) to each forwarded message.
+/// Initialize with lrm_route_transform_init() so unset fields change nothing.
+final class LrmRouteTransform extends ffi.Struct {
+  /// Messages to forward, matched before remapping
+  external LrmMidiFilter filter;
+
+  /// Output channel for each input channel, or -1 to drop
+  @ffi.Array.multi([16])
+  external ffi.Array<ffi.Int8> channel_map;
+
+  /// Semitones added to notes; notes leaving 0-127 are dropped
+  @ffi.Int8()
+  external int transpose;
+
+  /// Note On velocity factor, result clamped to 1-127
+  @ffi.Float()
+  external double velocity_scale;
+}
+
+/// Counters of a route (lrm_route_get_stats); all 0 for native routes
+final class LrmRouteStats extends ffi.Struct {
+  /// Messages sent to the output
+  @ffi.Uint64()
+  external int forwarded;
+
+  /// Messages rejected by the filter or the remapping
+  @ffi.Uint64()
+  external int dropped;
+
+  /// Messages the output refused
+  @ffi.Uint64()
+  external int send_failures;
+}
+
+/// Snapshot of an incoming MIDI clock (lrm_midi_in_get_clock_state), or of a
+/// clock generator (lrm_clock_get_state)
+final class LrmClockState extends ffi.Struct {
+  /// Smoothed tempo, 0 until two ticks were received
+  @ffi.Double()
+  external double bpm;
+
+  /// Position within the current beat (0.0 - 1.0)
+  @ffi.Double()
+  external double beat_phase;
+
+  /// Mean deviation of the tick interval (generator: lateness) in microseconds
+  @ffi.Double()
+  external double jitter_us;
+
+  /// Clock ticks (F8) received since the port was opened, or sent
+  @ffi.Uint64()
+  external int tick_count;
+
+  /// Song position in sixteenth notes (MIDI beats)
+  @ffi.Int32()
+  external int song_position;
+
+  /// Between Start/Continue and Stop
   @ffi.Bool()
-  external bool is_input;
+  external bool running;
+}
 
-  /// true if virtual/software port
+/// SMPTE position of incoming (lrm_midi_in_get_timecode) or generated
+/// (lrm_midi_out_get_timecode) MIDI Time Code
+final class LrmTimecode extends ffi.Struct {
+  /// 0 - 23
+  @ffi.Int32()
+  external int hours;
+
+  /// 0 - 59
+  @ffi.Int32()
+  external int minutes;
+
+  /// 0 - 59
+  @ffi.Int32()
+  external int seconds;
+
+  /// 0 - fps-1
+  @ffi.Int32()
+  external int frames;
+
+  /// LRM_MTC_*
+  @ffi.Int32()
+  external int rate;
+
+  /// Reader: following running quarter frames; generator: running
   @ffi.Bool()
-  external bool is_virtual;
+  external bool locked;
+
+  /// Quarter frames (F1) received or sent
+  @ffi.Uint64()
+  external int quarter_frames;
+}
+
+/// Counters of a MIDI input (lrm_midi_in_get_stats)
+/// Latency runs from the backend hand-off (the message timestamp on
+/// LRM_TIMESTAMP_MONOTONIC inputs) until the callback, ring or batcher took
+/// the message. Forwarding to routes is not included.
+final class LrmMidiInStats extends ffi.Struct {
+  /// Messages received from the backend
+  @ffi.Uint64()
+  external int messages;
+
+  /// Bytes received from the backend
+  @ffi.Uint64()
+  external int bytes;
+
+  /// SysEx messages, or chunks when streaming SysEx
+  @ffi.Uint64()
+  external int sysex_fragments;
+
+  /// Messages discarded because a buffer was full
+  @ffi.Uint64()
+  external int dropped;
+
+  /// Messages rejected by the filter or consumed natively
+  @ffi.Uint64()
+  external int filtered;
+
+  /// Longest time from backend hand-off to delivery
+  @ffi.Uint64()
+  external int max_latency_ns;
+
+  /// 99th percentile of the same (within 25%)
+  @ffi.Uint64()
+  external int p99_latency_ns;
+}
+
+/// Counters of a MIDI output (lrm_midi_out_get_stats)
+final class LrmMidiOutStats extends ffi.Struct {
+  /// Messages sent successfully
+  @ffi.Uint64()
+  external int messages;
+
+  /// Bytes sent successfully
+  @ffi.Uint64()
+  external int bytes;
+
+  /// SysEx messages sent successfully
+  @ffi.Uint64()
+  external int sysex_messages;
+
+  /// Sends rejected by the backend
+  @ffi.Uint64()
+  external int send_failures;
+
+  /// Total time spent inside the backend send call
+  @ffi.Uint64()
+  external int send_time_ns;
+
+  /// Longest single backend send call
+  @ffi.Uint64()
+  external int max_send_ns;
+
+  /// 99th percentile of the send call duration (within 25%)
+  @ffi.Uint64()
+  external int p99_send_ns;
+
+  /// Asynchronous sends waiting for the writer thread
+  @ffi.Uint64()
+  external int queue_pending;
+
+  /// Asynchronous sends the backend accepted
+  @ffi.Uint64()
+  external int queue_completed;
+
+  /// Asynchronous sends the backend rejected
+  @ffi.Uint64()
+  external int queue_failed;
+
+  /// Sends refused because the queue was full
+  @ffi.Uint64()
+  external int queue_overflows;
 }
 
 typedef LrmMidiCallbackFunction = ffi.Void Function(
@@ -427,14 +2480,89 @@ typedef DartLrmMidiCallbackFunction = void Function(
 /// Called when MIDI message is received
 typedef LrmMidiCallback
     = ffi.Pointer<ffi.NativeFunction<LrmMidiCallbackFunction>>;
+typedef LrmMidiBatchCallbackFunction = ffi.Void Function(
+  ffi.Pointer<ffi.Void> context,
+  ffi.Pointer<ffi.Uint8> data,
+  ffi.Size length,
+  ffi.Int32 count,
+);
+typedef DartLrmMidiBatchCallbackFunction = void Function(
+  ffi.Pointer<ffi.Void> context,
+  ffi.Pointer<ffi.Uint8> data,
+  int length,
+  int count,
+);
+
+/// Called with a batch of MIDI messages coalesced by lrm_midi_in_open_batched
+/// data holds `count` packed records (see LRM_PACKED_HEADER_SIZE) and is owned
+/// by the receiver, which must release it with lrm_midi_batch_free().
+typedef LrmMidiBatchCallback
+    = ffi.Pointer<ffi.NativeFunction<LrmMidiBatchCallbackFunction>>;
+typedef LrmParameterCallbackFunction = ffi.Void Function(
+  ffi.Pointer<ffi.Void> context,
+  ffi.Int32 kind,
+  ffi.Int32 flags,
+  ffi.Int32 channel,
+  ffi.Int32 parameter,
+  ffi.Int32 value,
+  ffi.Int64 timestamp,
+);
+typedef DartLrmParameterCallbackFunction = void Function(
+  ffi.Pointer<ffi.Void> context,
+  int kind,
+  int flags,
+  int channel,
+  int parameter,
+  int value,
+  int timestamp,
+);
+
+/// Called when the native decoder of lrm_midi_in_open_decoded completes a
+/// parameter change
+/// kind: LRM_PARAM_RPN, LRM_PARAM_NRPN or LRM_PARAM_CC14
+/// flags: combination of LRM_PARAM_FLAG_*
+/// parameter: 14-bit parameter number, or the MSB controller (0-31) for CC14
+typedef LrmParameterCallback
+    = ffi.Pointer<ffi.NativeFunction<LrmParameterCallbackFunction>>;
+typedef LrmSysexChunkCallbackFunction = ffi.Void Function(
+  ffi.Pointer<ffi.Void> context,
+  ffi.Pointer<ffi.Uint8> data,
+  ffi.Size length,
+  ffi.Int32 flags,
+  ffi.Int64 timestamp,
+);
+typedef DartLrmSysexChunkCallbackFunction = void Function(
+  ffi.Pointer<ffi.Void> context,
+  ffi.Pointer<ffi.Uint8> data,
+  int length,
+  int flags,
+  int timestamp,
+);
+
+/// Called with one chunk of a streamed SysEx message
+/// flags: combination of LRM_SYSEX_CHUNK_*. data is owned by the receiver, which
+/// must release it with lrm_midi_batch_free(). timestamp is the time the
+/// message started.
+typedef LrmSysexChunkCallback
+    = ffi.Pointer<ffi.NativeFunction<LrmSysexChunkCallbackFunction>>;
 typedef LrmHotplugCallbackFunction = ffi.Void Function(
-    ffi.Pointer<ffi.Void> context, ffi.Int32 event_type);
+  ffi.Pointer<ffi.Void> context,
+  ffi.Int32 event_type,
+  ffi.Uint64 port_id,
+);
 typedef DartLrmHotplugCallbackFunction = void Function(
-    ffi.Pointer<ffi.Void> context, int event_type);
+  ffi.Pointer<ffi.Void> context,
+  int event_type,
+  int port_id,
+);
 
 /// Called when MIDI device configuration changes
 /// event_type: 0 = input_added, 1 = input_removed, 2 = output_added,
-/// 3 = output_removed, 4 = setup_changed (generic, re-enumerate)
+/// 3 = output_removed, 4 = setup_changed (generic, re-enumerate),
+/// 5 = ready (lrm_observer_new_async finished starting)
+/// port_id: LrmPortInfo.port_id of the port that was added or removed, or 0
+/// when unknown (always for setup_changed). The observer's port list
+/// is already up to date when the callback runs.
 typedef LrmHotplugCallback
     = ffi.Pointer<ffi.NativeFunction<LrmHotplugCallbackFunction>>;
 
@@ -450,6 +2578,12 @@ const int LRM_ERR_SEND_FAILED = -4;
 
 const int LRM_ERR_INIT_FAILED = -5;
 
+const int LRM_ERR_BUFFER_TOO_SMALL = -6;
+
+const int LRM_ERR_QUEUE_FULL = -7;
+
+const int LRM_OBSERVER_STARTING = 1;
+
 const int LRM_TRANSPORT_UNKNOWN = 0;
 
 const int LRM_TRANSPORT_SOFTWARE = 2;
@@ -465,3 +2599,107 @@ const int LRM_TRANSPORT_BLUETOOTH = 32;
 const int LRM_TRANSPORT_PCI = 64;
 
 const int LRM_TRANSPORT_NETWORK = 128;
+
+const int LRM_OVERFLOW_DROP_OLDEST = 0;
+
+const int LRM_OVERFLOW_DROP_NEWEST = 1;
+
+const int LRM_PACKED_HEADER_SIZE = 12;
+
+const int LRM_BACKPRESSURE_BLOCK = 0;
+
+const int LRM_BACKPRESSURE_DROP = 1;
+
+const int LRM_BACKPRESSURE_FAIL = 2;
+
+const int LRM_SYSEX_TX_QUEUED = 0;
+
+const int LRM_SYSEX_TX_SENDING = 1;
+
+const int LRM_SYSEX_TX_DONE = 2;
+
+const int LRM_SYSEX_TX_FAILED = 3;
+
+const int LRM_SYSEX_TX_CANCELLED = 4;
+
+const int LRM_AUTOMATION_CC = 0;
+
+const int LRM_AUTOMATION_CC14 = 1;
+
+const int LRM_AUTOMATION_PITCH_BEND = 2;
+
+const int LRM_AUTOMATION_NRPN = 3;
+
+const int LRM_SEGMENT_LINEAR = 0;
+
+const int LRM_SEGMENT_EXPONENTIAL = 1;
+
+const int LRM_FILTER_NOTE_OFF = 1;
+
+const int LRM_FILTER_NOTE_ON = 2;
+
+const int LRM_FILTER_POLY_AFTERTOUCH = 4;
+
+const int LRM_FILTER_CONTROL_CHANGE = 8;
+
+const int LRM_FILTER_PROGRAM_CHANGE = 16;
+
+const int LRM_FILTER_CHANNEL_PRESSURE = 32;
+
+const int LRM_FILTER_PITCH_BEND = 64;
+
+const int LRM_FILTER_SYSEX = 128;
+
+const int LRM_FILTER_SYSTEM_COMMON = 256;
+
+const int LRM_FILTER_REALTIME = 512;
+
+const int LRM_FILTER_ALL = 1023;
+
+const int LRM_DECODE_RPN = 1;
+
+const int LRM_DECODE_SUPPRESS_RAW = 2;
+
+const int LRM_DECODE_WAIT_FOR_LSB = 4;
+
+const int LRM_PARAM_RPN = 0;
+
+const int LRM_PARAM_NRPN = 1;
+
+const int LRM_PARAM_CC14 = 2;
+
+const int LRM_PARAM_FLAG_14BIT = 1;
+
+const int LRM_PARAM_FLAG_INCREMENT = 2;
+
+const int LRM_PARAM_FLAG_DECREMENT = 4;
+
+const int LRM_SYSEX_CHUNK_BEGIN = 1;
+
+const int LRM_SYSEX_CHUNK_CONTINUE = 2;
+
+const int LRM_SYSEX_CHUNK_END = 4;
+
+const int LRM_SYSEX_CHUNK_ABORTED = 8;
+
+const int LRM_SYSEX_CHUNK_TRUNCATED = 16;
+
+const int LRM_SYSEX_OVERFLOW_ABORT = 0;
+
+const int LRM_SYSEX_OVERFLOW_TRUNCATE = 1;
+
+const int LRM_MTC_24FPS = 0;
+
+const int LRM_MTC_25FPS = 1;
+
+const int LRM_MTC_30FPS_DROP = 2;
+
+const int LRM_MTC_30FPS = 3;
+
+const int LRM_TIMESTAMP_ABSOLUTE = 0;
+
+const int LRM_TIMESTAMP_MONOTONIC = 1;
+
+const int LRM_TIMESTAMP_RELATIVE = 2;
+
+const int LRM_TIMESTAMP_NONE = 3;
@@ -13,6 +13,8 @@
 
 #include <libremidi/libremidi.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cstring>
 #include <memory>
@@ -20,6 +22,9 @@
 #include <string>
 #include <vector>
 
+#include "lrm_port_list.hpp"
+#include "lrm_port_snapshot.hpp"
+
 #if defined(__APPLE__)
 #include <CoreFoundation/CoreFoundation.h>
 #include <CoreMIDI/CoreMIDI.h>
@@ -36,6 +41,36 @@
 #define LRM_EVENT_OUTPUT_ADDED   2
 #define LRM_EVENT_OUTPUT_REMOVED 3
 #define LRM_EVENT_SETUP_CHANGED  4
+#define LRM_EVENT_READY          5
+
+// FNV-1a 64-bit hash for stable_id generation
+static uint64_t fnv1a_hash(const std::string& str) {
+    uint64_t hash = 14695981039346656037ULL; // FNV offset basis
+    for (char c : str) {
+        hash ^= static_cast<uint64_t>(c);
+        hash *= 1099511628211ULL; // FNV prime
+    }
+    return hash;
+}
+
+// Generate stable port key for cross-platform identification
+template<typename PortType>
+static std::string port_key(const PortType& port) {
+    return port.port_name + "|" + port.manufacturer + "|" + port.product + "|" + port.serial;
+}
+
+// Public port id (LrmPortInfo.port_id): kMIDIPropertyUniqueID
+template<typename PortType>
+static uint64_t public_port_id(const PortType& port) {
+    return static_cast<uint64_t>(port.port);
+}
+
+// Cross-platform stable id (LrmPortInfo.stable_id)
+// port.port is already stable here, but we use the hash for consistency
+template<typename PortType>
+static uint64_t stable_port_id(const PortType& port) {
+    return fnv1a_hash(port_key(port));
+}
 
 // Forward declaration
 struct LrmObserver;
@@ -49,32 +84,61 @@ static void handleMIDINotification(LrmObserver* obs, const MIDINotification* not
 
 struct LrmObserver {
     std::unique_ptr<libremidi::observer> observer;
-    std::vector<libremidi::input_port> input_ports;
-    std::vector<libremidi::output_port> output_ports;
+    LrmPortList<libremidi::input_port> input_ports{public_port_id, stable_port_id};
+    LrmPortList<libremidi::output_port> output_ports{public_port_id, stable_port_id};
     LrmHotplugCallback hotplug_callback;
     void* hotplug_context;
     mutable std::mutex ports_mutex;
+    uint64_t generation = 0;  // Bumped on every port list change
 
 #if defined(__APPLE__)
     MIDIClientRef midiClient;
     dispatch_queue_t refreshQueue;
 #endif
 
-    LrmObserver(LrmHotplugCallback callback = nullptr, void* context = nullptr)
+    const bool start_async;
+    std::atomic<int32_t> status{LRM_OBSERVER_STARTING};
+
+    // Without track_hotplug no MIDI client is created and the lists change
+    // on refresh() alone. An asynchronous start runs on refreshQueue and
+    // ends with LRM_EVENT_READY.
+    LrmObserver(LrmHotplugCallback callback = nullptr, void* context = nullptr,
+                bool track_hotplug = true, bool async = false)
         : hotplug_callback(callback), hotplug_context(context)
 #if defined(__APPLE__)
         , midiClient(0)
         , refreshQueue(dispatch_queue_create("dev.celtera.libremidi.refresh", DISPATCH_QUEUE_SERIAL))
 #endif
+        , start_async(async)
     {
         printf("[libremidi] Creating observer, callback=%p\n", (void*)callback);
 
 #if defined(__APPLE__)
-        if (hotplug_callback) {
+        if (!start_async) {
+            start(track_hotplug);
+            return;
+        }
+        dispatch_async(refreshQueue, ^{
+            try {
+                start(track_hotplug);
+            } catch (...) {
+                status.store(LRM_ERR_INIT_FAILED, std::memory_order_release);
+            }
+            notifyHotplug(LRM_EVENT_READY, 0);
+        });
+#else
+        start(track_hotplug);
+        if (start_async) notifyHotplug(LRM_EVENT_READY, 0);
+#endif
+    }
+
+    void start(bool track_hotplug) {
+#if defined(__APPLE__)
+        if (hotplug_callback && track_hotplug) {
             // Create our own MIDI client using MIDIClientCreateWithBlock
             // This delivers notifications via dispatch queue (works with Flutter)
             // instead of CFRunLoop (which doesn't work with Flutter)
-            OSStatus status = MIDIClientCreateWithBlock(
+            OSStatus result = MIDIClientCreateWithBlock(
                 CFSTR("libremidi_flutter"),
                 &midiClient,
                 ^(const MIDINotification* notification) {
@@ -82,12 +146,14 @@ struct LrmObserver {
                 }
             );
 
-            if (status != noErr) {
-                printf("[libremidi] MIDIClientCreateWithBlock failed: %d\n", (int)status);
+            if (result != noErr) {
+                printf("[libremidi] MIDIClientCreateWithBlock failed: %d\n", (int)result);
             } else {
                 printf("[libremidi] MIDIClientCreateWithBlock succeeded, client=%u\n", (unsigned)midiClient);
             }
         }
+#else
+        (void)track_hotplug;
 #endif
 
         // Create libremidi observer WITHOUT callbacks (we handle hotplug ourselves on macOS)
@@ -101,9 +167,18 @@ struct LrmObserver {
         printf("[libremidi] Observer created successfully\n");
         refreshInternal();
         printf("[libremidi] Found %zu inputs, %zu outputs\n", input_ports.size(), output_ports.size());
+        status.store(LRM_OK, std::memory_order_release);
+    }
+
+    bool isReady() const {
+        return status.load(std::memory_order_acquire) == LRM_OK;
     }
 
     ~LrmObserver() {
+#if defined(__APPLE__)
+        // An asynchronous start may still be creating the MIDI client
+        if (start_async) dispatch_sync(refreshQueue, ^{});
+#endif
         // Prevent late callbacks during/after dispose
         hotplug_callback = nullptr;
 #if defined(__APPLE__)
@@ -122,70 +197,134 @@ struct LrmObserver {
     void refreshAndNotifyAsync(int eventType) {
 #if defined(__APPLE__)
         dispatch_async(refreshQueue, ^{
-            refreshInternal();
-            notifyHotplug(eventType);
+            notifyChanges(eventType, refreshInternal(eventType));
         });
 #else
-        refreshInternal();
-        notifyHotplug(eventType);
+        notifyChanges(eventType, refreshInternal(eventType));
 #endif
     }
 
-    void refreshInternal() {
+    /// MIDIObjectAddRemoveNotification names the endpoint that changed, but
+    /// the libremidi port for it (names, display name, transport) is only
+    /// built by libremidi's own enumeration. So the lists are enumerated
+    /// again and compared with the cached ones to tell which ports the event
+    /// was about. Returns their ids.
+    std::vector<uint64_t> refreshInternal(int eventType = LRM_EVENT_SETUP_CHANGED) {
+        std::vector<uint64_t> changed;
         if (observer) {
             // Enumerate without holding the lock to avoid deadlock with
             // CoreMIDI's internal locks during notification handling.
             auto new_inputs = observer->get_input_ports();
             auto new_outputs = observer->get_output_ports();
+            LrmPortList<libremidi::input_port> inputs{public_port_id, stable_port_id};
+            LrmPortList<libremidi::output_port> outputs{public_port_id, stable_port_id};
+            inputs.assign(std::move(new_inputs));
+            outputs.assign(std::move(new_outputs));
             std::lock_guard<std::mutex> lock(ports_mutex);
-            input_ports = std::move(new_inputs);
-            output_ports = std::move(new_outputs);
+            switch (eventType) {
+                case LRM_EVENT_INPUT_ADDED: changed = missingIds(inputs, input_ports); break;
+                case LRM_EVENT_INPUT_REMOVED: changed = missingIds(input_ports, inputs); break;
+                case LRM_EVENT_OUTPUT_ADDED: changed = missingIds(outputs, output_ports); break;
+                case LRM_EVENT_OUTPUT_REMOVED: changed = missingIds(output_ports, outputs); break;
+                default: break;
+            }
+            input_ports = std::move(inputs);
+            output_ports = std::move(outputs);
+            generation++;
+        }
+        return changed;
+    }
+
+    // Ids of the ports in from that are not in other
+    template <typename PortType>
+    static std::vector<uint64_t> missingIds(const LrmPortList<PortType>& from, const LrmPortList<PortType>& other) {
+        std::vector<uint64_t> ids;
+        for (size_t i = 0; i < from.size(); i++) {
+            if (!other.contains(from.portIdAt(i))) ids.push_back(from.portIdAt(i));
         }
+        return ids;
+    }
+
+    void notifyChanges(int eventType, const std::vector<uint64_t>& changed) {
+        // An explicit refresh may have picked the change up already
+        if (changed.empty()) {
+            notifyHotplug(eventType, 0);
+            return;
+        }
+        for (uint64_t id : changed) notifyHotplug(eventType, id);
     }
 
     void refresh() {
+        // observer is still being created by an asynchronous start
+        if (!isReady()) return;
         refreshInternal();
     }
 
+    template <typename PortType>
+    static bool copyPort(const PortType* found, PortType& port) {
+        if (!found) return false;
+        port = *found;
+        return true;
+    }
+
     bool getInputPort(size_t index, libremidi::input_port& port) const {
         std::lock_guard<std::mutex> lock(ports_mutex);
-        if (index >= input_ports.size()) return false;
-        port = input_ports[index];
-        return true;
+        return copyPort(input_ports.at(index), port);
     }
 
     bool getOutputPort(size_t index, libremidi::output_port& port) const {
         std::lock_guard<std::mutex> lock(ports_mutex);
-        if (index >= output_ports.size()) return false;
-        port = output_ports[index];
+        return copyPort(output_ports.at(index), port);
+    }
+
+    bool getInputPortById(uint64_t port_id, libremidi::input_port& port, int32_t* index = nullptr) const {
+        std::lock_guard<std::mutex> lock(ports_mutex);
+        size_t found = 0;
+        if (!copyPort(input_ports.find(port_id, &found), port)) return false;
+        if (index) *index = static_cast<int32_t>(found);
         return true;
     }
 
-    bool getInputPortById(uint64_t port_id, libremidi::input_port& port) const {
+    bool getOutputPortById(uint64_t port_id, libremidi::output_port& port, int32_t* index = nullptr) const {
         std::lock_guard<std::mutex> lock(ports_mutex);
-        for (const auto& p : input_ports) {
-            if (static_cast<uint64_t>(p.port) == port_id) {
-                port = p;
-                return true;
-            }
-        }
-        return false;
+        size_t found = 0;
+        if (!copyPort(output_ports.find(port_id, &found), port)) return false;
+        if (index) *index = static_cast<int32_t>(found);
+        return true;
     }
 
-    bool getOutputPortById(uint64_t port_id, libremidi::output_port& port) const {
+    bool getInputPortByStableId(uint64_t stable_id, libremidi::input_port& port, int32_t* index) const {
         std::lock_guard<std::mutex> lock(ports_mutex);
-        for (const auto& p : output_ports) {
-            if (static_cast<uint64_t>(p.port) == port_id) {
-                port = p;
-                return true;
-            }
-        }
-        return false;
+        size_t found = 0;
+        if (!copyPort(input_ports.findStable(stable_id, &found), port)) return false;
+        *index = static_cast<int32_t>(found);
+        return true;
+    }
+
+    bool getOutputPortByStableId(uint64_t stable_id, libremidi::output_port& port, int32_t* index) const {
+        std::lock_guard<std::mutex> lock(ports_mutex);
+        size_t found = 0;
+        if (!copyPort(output_ports.findStable(stable_id, &found), port)) return false;
+        *index = static_cast<int32_t>(found);
+        return true;
+    }
+
+    uint64_t getGeneration() const {
+        std::lock_guard<std::mutex> lock(ports_mutex);
+        return generation;
+    }
+
+    LrmPortSnapshot* snapshot() const {
+        std::lock_guard<std::mutex> lock(ports_mutex);
+        LrmPortSnapshotBuilder builder;
+        builder.addPorts(input_ports, true);
+        builder.addPorts(output_ports, false);
+        return builder.build(generation);
     }
 
-    void notifyHotplug(int eventType) {
+    void notifyHotplug(int eventType, uint64_t portId) {
         if (hotplug_callback) {
-            hotplug_callback(hotplug_context, eventType);
+            hotplug_callback(hotplug_context, eventType, portId);
         }
     }
 };
@@ -229,51 +368,17 @@ static void handleMIDINotification(LrmObserver* obs, const MIDINotification* not
 }
 #endif
 
-struct LrmMidiIn {
-    std::unique_ptr<libremidi::midi_in> midi_in;
-    LrmMidiCallback callback;
-    void* context;
-
-    LrmMidiIn(libremidi::input_port& port, LrmMidiCallback cb, void* ctx,
-              bool receive_sysex, bool receive_timing, bool receive_sensing)
-        : callback(cb), context(ctx) {
-
-        libremidi::input_configuration config;
-        config.ignore_sysex = !receive_sysex;
-        config.ignore_timing = !receive_timing;
-        config.ignore_sensing = !receive_sensing;
-        config.on_message = [this](const libremidi::message& msg) {
-            if (callback) {
-                callback(context, msg.bytes.data(), msg.bytes.size(), msg.timestamp);
-            }
-        };
-
-        midi_in = std::make_unique<libremidi::midi_in>(std::move(config));
-        midi_in->open_port(port);
-    }
-};
-
-struct LrmMidiOut {
-    std::unique_ptr<libremidi::midi_out> midi_out;
-    int64_t port_id{0};
-
-    LrmMidiOut() = default;
-
-    LrmMidiOut(libremidi::output_port& port)
-        : port_id(static_cast<int64_t>(static_cast<int32_t>(port.port)))
-    {
-        midi_out = std::make_unique<libremidi::midi_out>();
-        midi_out->open_port(port);
-    }
-
-    virtual void sendRaw(const uint8_t* data, size_t len) {
-        if (midi_out) {
-            try { midi_out->send_message(data, len); } catch (...) {}
-        }
-    }
+// Backend objects for the shared port code in lrm_midi_io.hpp
+static std::unique_ptr<libremidi::midi_in> lrm_create_midi_in(
+    libremidi::input_configuration&& config,
+    const libremidi::input_port&
+) {
+    return std::make_unique<libremidi::midi_in>(std::move(config));
+}
 
-    virtual ~LrmMidiOut() = default;
-};
+static std::unique_ptr<libremidi::midi_out> lrm_create_midi_out(const libremidi::output_port&) {
+    return std::make_unique<libremidi::midi_out>();
+}
 
 // =============================================================================
 // Library info
@@ -306,6 +411,24 @@ extern "C" FFI_PLUGIN_EXPORT LrmObserver* lrm_observer_new_with_callbacks(
     }
 }
 
+extern "C" FFI_PLUGIN_EXPORT LrmObserver* lrm_observer_new_async(
+    LrmHotplugCallback callback,
+    void* context,
+    bool track_hotplug
+) {
+    if (!callback) return nullptr;
+    try {
+        return new LrmObserver(callback, context, track_hotplug, true);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_observer_get_status(LrmObserver* observer) {
+    if (!observer) return LRM_ERR_INVALID;
+    return observer->status.load(std::memory_order_acquire);
+}
+
 extern "C" FFI_PLUGIN_EXPORT void lrm_observer_free(LrmObserver* observer) {
     delete observer;
 }
@@ -333,22 +456,6 @@ static void safe_strcpy(char* dest, size_t dest_size, const std::string& src) {
     dest[dest_size - 1] = '\0';
 }
 
-// FNV-1a 64-bit hash for stable_id generation
-static uint64_t fnv1a_hash(const std::string& str) {
-    uint64_t hash = 14695981039346656037ULL; // FNV offset basis
-    for (char c : str) {
-        hash ^= static_cast<uint64_t>(c);
-        hash *= 1099511628211ULL; // FNV prime
-    }
-    return hash;
-}
-
-// Generate stable port key for cross-platform identification
-template<typename PortType>
-static std::string port_key(const PortType& port) {
-    return port.port_name + "|" + port.manufacturer + "|" + port.product + "|" + port.serial;
-}
-
 // Helper to fill port info from libremidi port
 template<typename PortType>
 static void fill_port_info(const PortType& port, int32_t index, bool is_input, LrmPortInfo* info) {
@@ -356,13 +463,10 @@ static void fill_port_info(const PortType& port, int32_t index, bool is_input, L
     std::memset(info, 0, sizeof(LrmPortInfo));
 
     // Identifiers
-    info->port_id = static_cast<uint64_t>(port.port);
+    info->port_id = public_port_id(port);
     info->client_handle = static_cast<uint64_t>(port.client);
     info->index = index;
-
-    // Generate stable_id from port key hash
-    // On macOS/iOS port.port (MIDIEndpointRef) is already stable, but we use hash for consistency
-    info->stable_id = fnv1a_hash(port_key(port));
+    info->stable_id = stable_port_id(port);
 
     // Names
     safe_strcpy(info->display_name, sizeof(info->display_name), port.display_name);
@@ -405,119 +509,73 @@ extern "C" FFI_PLUGIN_EXPORT int32_t lrm_observer_get_output(LrmObserver* observ
     return LRM_OK;
 }
 
-// =============================================================================
-// MIDI Output API
-// =============================================================================
-
-extern "C" FFI_PLUGIN_EXPORT LrmMidiOut* lrm_midi_out_open(LrmObserver* observer, int32_t port_index) {
-    if (!observer) return nullptr;
-    if (port_index < 0) return nullptr;
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_observer_get_input_by_id(LrmObserver* observer, uint64_t port_id, LrmPortInfo* info) {
+    if (!observer || !info) return LRM_ERR_INVALID;
 
-    libremidi::output_port port;
-    if (!observer->getOutputPort(static_cast<size_t>(port_index), port)) {
-        return nullptr;
+    libremidi::input_port port;
+    int32_t index = 0;
+    if (!observer->getInputPortById(port_id, port, &index)) {
+        return LRM_ERR_NOT_FOUND;
     }
 
-    try {
-        return new LrmMidiOut(port);
-    } catch (...) {
-        return nullptr;
-    }
+    fill_port_info(port, index, true, info);
+    return LRM_OK;
 }
 
-extern "C" FFI_PLUGIN_EXPORT LrmMidiOut* lrm_midi_out_open_by_id(LrmObserver* observer, uint64_t port_id) {
-    if (!observer) return nullptr;
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_observer_get_output_by_id(LrmObserver* observer, uint64_t port_id, LrmPortInfo* info) {
+    if (!observer || !info) return LRM_ERR_INVALID;
 
     libremidi::output_port port;
-    if (!observer->getOutputPortById(port_id, port)) {
-        return nullptr;
-    }
-
-    try {
-        return new LrmMidiOut(port);
-    } catch (...) {
-        return nullptr;
+    int32_t index = 0;
+    if (!observer->getOutputPortById(port_id, port, &index)) {
+        return LRM_ERR_NOT_FOUND;
     }
-}
-
-extern "C" FFI_PLUGIN_EXPORT void lrm_midi_out_close(LrmMidiOut* midi_out) {
-    delete midi_out;
-}
-
-extern "C" FFI_PLUGIN_EXPORT bool lrm_midi_out_is_connected(LrmMidiOut* midi_out) {
-    if (!midi_out || !midi_out->midi_out) return false;
-    return midi_out->midi_out->is_port_connected();
-}
 
-extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_send(LrmMidiOut* midi_out, const uint8_t* data, size_t length) {
-    if (!midi_out || !midi_out->midi_out || !data) return LRM_ERR_INVALID;
-
-    try {
-        midi_out->midi_out->send_message(data, length);
-        return LRM_OK;
-    } catch (...) {
-        return LRM_ERR_SEND_FAILED;
-    }
+    fill_port_info(port, index, false, info);
+    return LRM_OK;
 }
 
-// =============================================================================
-// MIDI Input API
-// =============================================================================
-
-extern "C" FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open(
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_observer_find_by_stable_id(
     LrmObserver* observer,
-    int32_t port_index,
-    LrmMidiCallback callback,
-    void* context,
-    bool receive_sysex,
-    bool receive_timing,
-    bool receive_sensing
+    uint64_t stable_id,
+    bool is_input,
+    LrmPortInfo* info
 ) {
-    if (!observer) return nullptr;
-    if (port_index < 0) return nullptr;
+    if (!observer || !info) return LRM_ERR_INVALID;
 
-    libremidi::input_port port;
-    if (!observer->getInputPort(static_cast<size_t>(port_index), port)) {
-        return nullptr;
+    int32_t index = 0;
+    if (is_input) {
+        libremidi::input_port port;
+        if (!observer->getInputPortByStableId(stable_id, port, &index)) return LRM_ERR_NOT_FOUND;
+        fill_port_info(port, index, true, info);
+    } else {
+        libremidi::output_port port;
+        if (!observer->getOutputPortByStableId(stable_id, port, &index)) return LRM_ERR_NOT_FOUND;
+        fill_port_info(port, index, false, info);
     }
+    return LRM_OK;
+}
 
-    try {
-        return new LrmMidiIn(port, callback, context,
-                            receive_sysex, receive_timing, receive_sensing);
-    } catch (...) {
-        return nullptr;
-    }
+extern "C" FFI_PLUGIN_EXPORT uint64_t lrm_observer_get_generation(LrmObserver* observer) {
+    if (!observer) return 0;
+    return observer->getGeneration();
 }
 
-extern "C" FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_by_id(
-    LrmObserver* observer,
-    uint64_t port_id,
-    LrmMidiCallback callback,
-    void* context,
-    bool receive_sysex,
-    bool receive_timing,
-    bool receive_sensing
-) {
+extern "C" FFI_PLUGIN_EXPORT LrmPortSnapshot* lrm_observer_snapshot(LrmObserver* observer) {
     if (!observer) return nullptr;
-
-    libremidi::input_port port;
-    if (!observer->getInputPortById(port_id, port)) {
-        return nullptr;
-    }
-
     try {
-        return new LrmMidiIn(port, callback, context,
-                            receive_sysex, receive_timing, receive_sensing);
+        return observer->snapshot();
     } catch (...) {
         return nullptr;
     }
 }
 
-extern "C" FFI_PLUGIN_EXPORT void lrm_midi_in_close(LrmMidiIn* midi_in) {
-    delete midi_in;
+extern "C" FFI_PLUGIN_EXPORT void lrm_port_snapshot_free(LrmPortSnapshot* snapshot) {
+    std::free(snapshot);
 }
 
-extern "C" FFI_PLUGIN_EXPORT bool lrm_midi_in_is_connected(LrmMidiIn* midi_in) {
-    if (!midi_in || !midi_in->midi_in) return false;
-    return midi_in->midi_in->is_port_connected();
-}
+// =============================================================================
+// MIDI Output and Input API (shared with the Linux, Windows and Android builds)
+// =============================================================================
+
+#include "lrm_midi_io.hpp"
@@ -0,0 +1,145 @@
+// Measures how far from their requested time ALSA sequencer messages arrive,
+// comparing direct output against the queue-based schedule_message().
+//
+// A virtual input port is opened and an output port connected to it. Each
+// mode sends `count` Note On messages spaced `interval_us` apart:
+//
+//   direct: the sender sleeps until the due time, then calls send_message
+//   queue:  the sender hands each message to schedule_message 10 ms before
+//           it is due, as the plugin's scheduler does, and the kernel
+//           delivers it from the output queue
+//
+// Arrival is taken on the input thread, so both modes include the same
+// delivery overhead. Build with -DLRM_BUILD_BENCHMARKS=ON and run:
+//
+//   alsa_seq_jitter [count] [interval_us]
+
+#include <libremidi/libremidi.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr const char* kSinkName = "lrm jitter sink";
+constexpr int64_t kLookaheadNs = 10'000'000;
+
+int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct Arrivals {
+    std::mutex mutex;
+    std::vector<int64_t> times;
+};
+
+void report(const char* mode, const std::vector<int64_t>& due, Arrivals& arrivals) {
+    std::vector<int64_t> errors;
+    {
+        std::lock_guard<std::mutex> lock(arrivals.mutex);
+        for (size_t i = 0; i < arrivals.times.size() && i < due.size(); i++) {
+            errors.push_back(arrivals.times[i] - due[i]);
+        }
+        arrivals.times.clear();
+    }
+    if (errors.empty()) {
+        std::printf("%-7s no messages received\n", mode);
+        return;
+    }
+
+    std::sort(errors.begin(), errors.end());
+    auto us = [](int64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    std::printf("%-7s n=%zu/%zu  min %8.1f  median %8.1f  p99 %8.1f  max %8.1f us\n",
+                mode, errors.size(), due.size(), us(errors.front()),
+                us(errors[errors.size() / 2]), us(errors[errors.size() * 99 / 100]),
+                us(errors.back()));
+}
+
+std::vector<int64_t> dueTimes(int count, int64_t interval_ns) {
+    std::vector<int64_t> due;
+    const int64_t start = now() + 50'000'000;
+    for (int i = 0; i < count; i++) due.push_back(start + i * interval_ns);
+    return due;
+}
+
+void sleepUntil(int64_t t) {
+    std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+        std::chrono::nanoseconds(t)));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const int count = argc > 1 ? std::atoi(argv[1]) : 200;
+    const int64_t interval_ns = (argc > 2 ? std::atoll(argv[2]) : 5000) * 1000;
+    if (count <= 0 || interval_ns <= 0) {
+        std::fprintf(stderr, "usage: %s [count] [interval_us]\n", argv[0]);
+        return 1;
+    }
+
+    Arrivals arrivals;
+    libremidi::input_configuration in_config;
+    in_config.timestamps = libremidi::timestamp_mode::NoTimestamp;
+    in_config.on_message = [&](libremidi::message&&) {
+        const int64_t t = now();
+        std::lock_guard<std::mutex> lock(arrivals.mutex);
+        arrivals.times.push_back(t);
+    };
+    libremidi::midi_in input{
+        std::move(in_config), libremidi::midi_in_configuration_for(libremidi::API::ALSA_SEQ)};
+    if (input.open_virtual_port(kSinkName) != stdx::error{}) {
+        std::fprintf(stderr, "could not open the ALSA sequencer\n");
+        return 1;
+    }
+
+    libremidi::observer_configuration obs_config;
+    obs_config.track_any = true;
+    libremidi::observer observer{
+        std::move(obs_config), libremidi::observer_configuration_for(libremidi::API::ALSA_SEQ)};
+    std::optional<libremidi::output_port> sink;
+    for (const auto& port : observer.get_output_ports()) {
+        if (port.port_name.find(kSinkName) != std::string::npos) sink = port;
+    }
+    if (!sink) {
+        std::fprintf(stderr, "virtual port not found\n");
+        return 1;
+    }
+
+    libremidi::output_configuration out_config;
+    out_config.timestamps = libremidi::timestamp_mode::SystemMonotonic;
+    libremidi::midi_out output{
+        std::move(out_config), libremidi::midi_out_configuration_for(libremidi::API::ALSA_SEQ)};
+    if (output.open_port(*sink) != stdx::error{}) {
+        std::fprintf(stderr, "could not connect to the virtual port\n");
+        return 1;
+    }
+
+    const unsigned char note[3] = {0x90, 60, 100};
+    std::printf("%d messages, %lld us apart\n", count, static_cast<long long>(interval_ns / 1000));
+
+    auto due = dueTimes(count, interval_ns);
+    for (int64_t t : due) {
+        sleepUntil(t);
+        output.send_message(note, sizeof(note));
+    }
+    sleepUntil(due.back() + 100'000'000);
+    report("direct", due, arrivals);
+
+    due = dueTimes(count, interval_ns);
+    for (int64_t t : due) {
+        sleepUntil(t - kLookaheadNs);
+        output.schedule_message(t, note, sizeof(note));
+    }
+    sleepUntil(due.back() + 100'000'000);
+    report("queue", due, arrivals);
+    return 0;
+}
@@ -0,0 +1,169 @@
+// Measures ALSA sequencer port enumeration with many ports, and the cost of
+// the udev sound card lookups it makes for ports that belong to a card.
+//
+// One sequencer client with `ports` duplex ports is created, then
+//
+//   enumerate: get_input_ports() + get_output_ports() on an ALSA sequencer
+//              observer (with its udev cache), `iterations` times
+//   udev:      (with LIBREMIDI_HAS_UDEV) the udev lookups those enumerations
+//              make: one per listed port that belongs to a sound card, for
+//              inputs and outputs, `iterations` times. Timed uncached with
+//              get_udev_soundcard_info (one udev query per port, as before
+//              the cache) and through udev_soundcard_cache as the observer
+//              does now.
+//
+// The created ports have no card, so they only make the sequencer walk
+// longer. Card-backed ports come from hardware or, without any, from
+// snd-virmidi:
+//
+//   modprobe snd-virmidi midi_devs=16
+//
+// Build with -DLRM_BUILD_BENCHMARKS=ON and run:
+//
+//   alsa_seq_port_enum [ports] [iterations]
+
+#include <libremidi/libremidi.hpp>
+
+#include <alsa/asoundlib.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double perEnumerationUs(int64_t total_ns, int iterations) {
+    return static_cast<double>(total_ns) / 1000.0 / iterations;
+}
+
+void report(const char* what, int64_t total_ns, int iterations) {
+    std::printf("%-24s %8.1f us per enumeration (%d enumerations)\n",
+                what, perEnumerationUs(total_ns, iterations), iterations);
+}
+
+#if LIBREMIDI_HAS_UDEV
+// Card of every port the observer lists, once per list it appears in
+std::vector<int> listedPortCards(snd_seq_t* seq) {
+    std::vector<int> cards;
+    snd_seq_client_info_t* client;
+    snd_seq_port_info_t* port;
+    snd_seq_client_info_alloca(&client);
+    snd_seq_port_info_alloca(&port);
+    snd_seq_client_info_set_client(client, -1);
+    while (snd_seq_query_next_client(seq, client) >= 0) {
+        const int card = snd_seq_client_info_get_card(client);
+        if (card < 0) continue;
+        snd_seq_port_info_set_client(port, snd_seq_client_info_get_client(client));
+        snd_seq_port_info_set_port(port, -1);
+        while (snd_seq_query_next_port(seq, port) >= 0) {
+            const unsigned int caps = snd_seq_port_info_get_capability(port);
+            if ((caps & SND_SEQ_PORT_CAP_READ) && (caps & SND_SEQ_PORT_CAP_SUBS_READ)) cards.push_back(card);
+            if ((caps & SND_SEQ_PORT_CAP_WRITE) && (caps & SND_SEQ_PORT_CAP_SUBS_WRITE)) cards.push_back(card);
+        }
+    }
+    return cards;
+}
+
+void benchmarkUdev(snd_seq_t* seq, int iterations, int64_t enumerate_ns) {
+    const std::vector<int> cards = listedPortCards(seq);
+    if (cards.empty()) {
+        std::printf("udev: no sequencer ports belong to a sound card (try snd-virmidi)\n");
+        return;
+    }
+
+    libremidi::udev_helper helper;
+    libremidi::udev_soundcard_cache cache;
+    size_t checksum = 0;
+
+    int64_t start = now();
+    for (int i = 0; i < iterations; i++) {
+        for (int card : cards) checksum += libremidi::get_udev_soundcard_info(helper, card).product.size();
+    }
+    const int64_t uncached = now() - start;
+
+    start = now();
+    for (int i = 0; i < iterations; i++) {
+        for (int card : cards) checksum += cache.get(helper, card).product.size();
+    }
+    const int64_t cached = now() - start;
+
+    std::printf("udev: %zu listed ports with a card, per enumeration:\n", cards.size());
+    report("  uncached (per port)", uncached, iterations);
+    report("  cached (observer)", cached, iterations);
+    std::printf("enumerate without the cache: about %.1f us per enumeration\n",
+                perEnumerationUs(enumerate_ns + uncached - cached, iterations));
+    if (checksum == 0) std::printf("  (no udev metadata for these cards)\n");
+}
+#endif
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const int port_count = argc > 1 ? std::atoi(argv[1]) : 256;
+    const int iterations = argc > 2 ? std::atoi(argv[2]) : 50;
+    if (port_count < 0 || iterations <= 0) {
+        std::fprintf(stderr, "usage: %s [ports] [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    snd_seq_t* seq = nullptr;
+    if (snd_seq_open(&seq, "default", SND_SEQ_OPEN_DUPLEX, 0) < 0) {
+        std::fprintf(stderr, "could not open the ALSA sequencer\n");
+        return 1;
+    }
+    snd_seq_set_client_name(seq, "lrm enum bench");
+    for (int i = 0; i < port_count; i++) {
+        const std::string name = "bench " + std::to_string(i);
+        const int port = snd_seq_create_simple_port(
+            seq, name.c_str(),
+            SND_SEQ_PORT_CAP_READ | SND_SEQ_PORT_CAP_SUBS_READ |
+                SND_SEQ_PORT_CAP_WRITE | SND_SEQ_PORT_CAP_SUBS_WRITE,
+            SND_SEQ_PORT_TYPE_MIDI_GENERIC | SND_SEQ_PORT_TYPE_APPLICATION);
+        if (port < 0) {
+            std::fprintf(stderr, "created only %d of %d ports\n", i, port_count);
+            break;
+        }
+    }
+
+    libremidi::observer_configuration config;
+    config.track_any = true;
+    libremidi::observer observer{
+        std::move(config), libremidi::observer_configuration_for(libremidi::API::ALSA_SEQ)};
+
+    size_t inputs = 0;
+    size_t outputs = 0;
+    size_t with_card = 0;
+    const int64_t start = now();
+    for (int i = 0; i < iterations; i++) {
+        const auto in = observer.get_input_ports();
+        const auto out = observer.get_output_ports();
+        inputs = in.size();
+        outputs = out.size();
+        with_card = 0;
+        for (const auto& port : in) with_card += port.manufacturer.empty() ? 0 : 1;
+    }
+    const int64_t enumerate_ns = now() - start;
+    std::printf("%zu inputs (%zu with udev metadata), %zu outputs\n", inputs, with_card, outputs);
+#if LIBREMIDI_HAS_UDEV
+    report("enumerate (udev cached)", enumerate_ns, iterations);
+#else
+    report("enumerate (no udev)", enumerate_ns, iterations);
+#endif
+
+#if LIBREMIDI_HAS_UDEV
+    benchmarkUdev(seq, iterations, enumerate_ns);
+#else
+    std::printf("udev: not available in this build\n");
+#endif
+
+    snd_seq_close(seq);
+    return 0;
+}
@@ -27,9 +27,14 @@
 #include <cstring>
 #include <memory>
 #include <algorithm>
+#include <atomic>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "lrm_port_list.hpp"
+#include "lrm_port_snapshot.hpp"
+
 // =============================================================================
 // API selection — prefer WinMIDI (MIDI 2.0), fall back to platform default
 // =============================================================================
@@ -60,6 +65,7 @@ static constexpr const char* kInternalClientName = "libremidi_flutter_internal";
 #define LRM_EVENT_INPUT_REMOVED  1
 #define LRM_EVENT_OUTPUT_ADDED   2
 #define LRM_EVENT_OUTPUT_REMOVED 3
+#define LRM_EVENT_READY          5
 
 // FNV-1a 64-bit hash for stable_id / public port id generation
 static uint64_t fnv1a_hash(const std::string& str) {
@@ -83,39 +89,85 @@ static uint64_t public_port_id(const PortType& port) {
     return static_cast<uint64_t>(port.port);
 }
 
+// Generate stable port key for cross-platform identification
+template<typename PortType>
+static std::string port_key(const PortType& port) {
+    return port.port_name + "|" + port.manufacturer + "|" + port.product + "|" + port.serial;
+}
+
+// Cross-platform stable id (LrmPortInfo.stable_id)
+// On macOS/iOS port.port (MIDIEndpointRef) is already stable, but we use hash for consistency
+template<typename PortType>
+static uint64_t stable_port_id(const PortType& port) {
+    return fnv1a_hash(port_key(port));
+}
+
 struct LrmObserver {
     std::unique_ptr<libremidi::observer> observer;
-    std::vector<libremidi::input_port> input_ports;
-    std::vector<libremidi::output_port> output_ports;
+    LrmPortList<libremidi::input_port> input_ports{public_port_id, stable_port_id};
+    LrmPortList<libremidi::output_port> output_ports{public_port_id, stable_port_id};
     LrmHotplugCallback hotplug_callback;
     void* hotplug_context;
     mutable std::mutex ports_mutex;  // Thread safety for port vectors
-
-    LrmObserver(LrmHotplugCallback callback = nullptr, void* context = nullptr)
-        : hotplug_callback(callback), hotplug_context(context)
+    uint64_t generation = 0;  // Bumped on every port list change
+    const bool start_async;
+    std::atomic<int32_t> status{LRM_OBSERVER_STARTING};
+    std::thread starter;  // Runs start() for lrm_observer_new_async
+
+    // Without track_hotplug the observer only enumerates: the lists change
+    // on refresh() alone. callback then only receives LRM_EVENT_READY.
+    LrmObserver(LrmHotplugCallback callback = nullptr, void* context = nullptr,
+                bool track_hotplug = true, bool async = false)
+        : hotplug_callback(callback), hotplug_context(context), start_async(async)
     {
+        if (!start_async) {
+            start(track_hotplug);
+            return;
+        }
+        starter = std::thread([this, track_hotplug] {
+            try {
+                start(track_hotplug);
+            } catch (...) {
+                status.store(LRM_ERR_INIT_FAILED, std::memory_order_release);
+            }
+            notifyHotplug(LRM_EVENT_READY, 0);
+        });
+    }
+
+    ~LrmObserver() {
+        if (starter.joinable()) starter.join();
+    }
+
+    void start(bool track_hotplug) {
         libremidi::observer_configuration config;
         config.track_hardware = true;
         config.track_virtual = true;
         // Must be true so m_knownClients is populated for unregister_port() to work
         config.notify_in_constructor = true;
 
-        if (hotplug_callback) {
-            config.input_added = [this](const libremidi::input_port&) {
-                refreshInternal();
-                notifyHotplug(LRM_EVENT_INPUT_ADDED);
+        const bool tracking = hotplug_callback && track_hotplug;
+        if (tracking) {
+            // Each callback carries the port that changed: apply it to the
+            // cached lists instead of enumerating every port again
+            config.input_added = [this](const libremidi::input_port& port) {
+                if (isInternalObserverPort(port)) return;
+                addPort(input_ports, port);
+                notifyHotplug(LRM_EVENT_INPUT_ADDED, public_port_id(port));
             };
-            config.input_removed = [this](const libremidi::input_port&) {
-                refreshInternal();
-                notifyHotplug(LRM_EVENT_INPUT_REMOVED);
+            config.input_removed = [this](const libremidi::input_port& port) {
+                if (isInternalObserverPort(port)) return;
+                removePort(input_ports, port);
+                notifyHotplug(LRM_EVENT_INPUT_REMOVED, public_port_id(port));
             };
-            config.output_added = [this](const libremidi::output_port&) {
-                refreshInternal();
-                notifyHotplug(LRM_EVENT_OUTPUT_ADDED);
+            config.output_added = [this](const libremidi::output_port& port) {
+                if (isInternalObserverPort(port)) return;
+                addPort(output_ports, port);
+                notifyHotplug(LRM_EVENT_OUTPUT_ADDED, public_port_id(port));
             };
-            config.output_removed = [this](const libremidi::output_port&) {
-                refreshInternal();
-                notifyHotplug(LRM_EVENT_OUTPUT_REMOVED);
+            config.output_removed = [this](const libremidi::output_port& port) {
+                if (isInternalObserverPort(port)) return;
+                removePort(output_ports, port);
+                notifyHotplug(LRM_EVENT_OUTPUT_REMOVED, public_port_id(port));
             };
         }
 
@@ -123,14 +175,27 @@ struct LrmObserver {
         auto api = get_preferred_api();
         auto api_conf = libremidi::observer_configuration_for(api);
         libremidi::set_client_name(api_conf, kInternalClientName);
+#if defined(LIBREMIDI_ALSA)
+        // Without callbacks the ALSA observer thread would poll for nothing;
+        // a no-op manual poll keeps libremidi from starting it
+        if (!tracking) {
+            if (auto* alsa = std::get_if<libremidi::alsa_seq::observer_configuration>(&api_conf)) {
+                alsa->manual_poll = [](const libremidi::alsa_seq::poll_parameters&) { return true; };
+                alsa->stop_poll = [](snd_seq_addr_t) { return true; };
+            }
+        }
+#endif
         observer = std::make_unique<libremidi::observer>(
             std::move(config),
             std::move(api_conf)
         );
         refreshInternal();
+        status.store(LRM_OK, std::memory_order_release);
     }
 
-    ~LrmObserver() = default;
+    bool isReady() const {
+        return status.load(std::memory_order_acquire) == LRM_OK;
+    }
 
     template <typename PortType>
     static bool isInternalObserverPort(const PortType& port) {
@@ -177,15 +242,31 @@ struct LrmObserver {
                 new_outputs.end());
 
             std::lock_guard<std::mutex> lock(ports_mutex);
-            input_ports = std::move(new_inputs);
-            output_ports = std::move(new_outputs);
+            input_ports.assign(std::move(new_inputs));
+            output_ports.assign(std::move(new_outputs));
+            generation++;
         }
     }
 
     void refresh() {
+        // observer is still being created by an asynchronous start
+        if (!isReady()) return;
         refreshInternal();
     }
 
+    template <typename PortType>
+    void addPort(LrmPortList<PortType>& ports, const PortType& port) {
+        std::lock_guard<std::mutex> lock(ports_mutex);
+        ports.add(port);
+        generation++;
+    }
+
+    template <typename PortType>
+    void removePort(LrmPortList<PortType>& ports, const PortType& port) {
+        std::lock_guard<std::mutex> lock(ports_mutex);
+        if (ports.remove(public_port_id(port))) generation++;
+    }
+
     size_t getInputCount() const {
         std::lock_guard<std::mutex> lock(ports_mutex);
         return input_ports.size();
@@ -196,98 +277,101 @@ struct LrmObserver {
         return output_ports.size();
     }
 
+    template <typename PortType>
+    static bool copyPort(const PortType* found, PortType& port) {
+        if (!found) return false;
+        port = *found;
+        return true;
+    }
+
     bool getInputPort(size_t index, libremidi::input_port& port) const {
         std::lock_guard<std::mutex> lock(ports_mutex);
-        if (index >= input_ports.size()) return false;
-        port = input_ports[index];
-        return true;
+        return copyPort(input_ports.at(index), port);
     }
 
     bool getOutputPort(size_t index, libremidi::output_port& port) const {
         std::lock_guard<std::mutex> lock(ports_mutex);
-        if (index >= output_ports.size()) return false;
-        port = output_ports[index];
-        return true;
+        return copyPort(output_ports.at(index), port);
     }
 
-    bool getInputPortById(uint64_t port_id, libremidi::input_port& port) const {
+    bool getInputPortById(uint64_t port_id, libremidi::input_port& port, int32_t* index = nullptr) const {
         std::lock_guard<std::mutex> lock(ports_mutex);
-        for (const auto& p : input_ports) {
-            if (public_port_id(p) == port_id) {
-                port = p;
-                return true;
-            }
-        }
-        return false;
+        size_t found = 0;
+        if (!copyPort(input_ports.find(port_id, &found), port)) return false;
+        if (index) *index = static_cast<int32_t>(found);
+        return true;
     }
 
-    bool getOutputPortById(uint64_t port_id, libremidi::output_port& port) const {
+    bool getOutputPortById(uint64_t port_id, libremidi::output_port& port, int32_t* index = nullptr) const {
         std::lock_guard<std::mutex> lock(ports_mutex);
-        for (const auto& p : output_ports) {
-            if (public_port_id(p) == port_id) {
-                port = p;
-                return true;
-            }
-        }
-        return false;
+        size_t found = 0;
+        if (!copyPort(output_ports.find(port_id, &found), port)) return false;
+        if (index) *index = static_cast<int32_t>(found);
+        return true;
     }
 
-    void notifyHotplug(int eventType) {
-        if (hotplug_callback) {
-            hotplug_callback(hotplug_context, eventType);
-        }
+    bool getInputPortByStableId(uint64_t stable_id, libremidi::input_port& port, int32_t* index) const {
+        std::lock_guard<std::mutex> lock(ports_mutex);
+        size_t found = 0;
+        if (!copyPort(input_ports.findStable(stable_id, &found), port)) return false;
+        *index = static_cast<int32_t>(found);
+        return true;
     }
-};
-
 
-struct LrmMidiIn {
-    std::unique_ptr<libremidi::midi_in> midi_in;
-    LrmMidiCallback callback;
-    void* context;
+    bool getOutputPortByStableId(uint64_t stable_id, libremidi::output_port& port, int32_t* index) const {
+        std::lock_guard<std::mutex> lock(ports_mutex);
+        size_t found = 0;
+        if (!copyPort(output_ports.findStable(stable_id, &found), port)) return false;
+        *index = static_cast<int32_t>(found);
+        return true;
+    }
 
-    LrmMidiIn(libremidi::input_port port, LrmMidiCallback cb, void* ctx,
-              bool receive_sysex, bool receive_timing, bool receive_sensing)
-        : callback(cb), context(ctx) {
+    uint64_t getGeneration() const {
+        std::lock_guard<std::mutex> lock(ports_mutex);
+        return generation;
+    }
 
-        libremidi::input_configuration config;
-        config.ignore_sysex = !receive_sysex;
-        config.ignore_timing = !receive_timing;
-        config.ignore_sensing = !receive_sensing;
-        config.on_message = [this](const libremidi::message& msg) {
-            if (callback) {
-                callback(context, msg.bytes.data(), msg.bytes.size(), msg.timestamp);
-            }
-        };
+    LrmPortSnapshot* snapshot() const {
+        std::lock_guard<std::mutex> lock(ports_mutex);
+        LrmPortSnapshotBuilder builder;
+        builder.addPorts(input_ports, true);
+        builder.addPorts(output_ports, false);
+        return builder.build(generation);
+    }
 
-        // Use the API that enumerated this port. For MIDI 2 backends
-        // (WinMIDI), libremidi wraps the MIDI 1 config with UMP conversion.
-        auto api = port.api;
-        auto api_conf = libremidi::midi_in_configuration_for(api);
-        libremidi::set_client_name(api_conf, kInternalClientName);
-        midi_in = std::make_unique<libremidi::midi_in>(
-            std::move(config),
-            std::move(api_conf)
-        );
-        midi_in->open_port(port);
+    void notifyHotplug(int eventType, uint64_t portId) {
+        // The ports found while an asynchronous start enumerates are
+        // announced by LRM_EVENT_READY, not one by one
+        if (start_async && eventType != LRM_EVENT_READY && !isReady()) return;
+        if (hotplug_callback) {
+            hotplug_callback(hotplug_context, eventType, portId);
+        }
     }
 };
 
-struct LrmMidiOut {
-    std::unique_ptr<libremidi::midi_out> midi_out;
+// Backend objects for the shared port code in lrm_midi_io.hpp. Use the API
+// that enumerated the port: for MIDI 2 backends (WinMIDI), libremidi wraps the
+// MIDI 1 config with UMP conversion and converts send_message() to UMP.
+static std::unique_ptr<libremidi::midi_in> lrm_create_midi_in(
+    libremidi::input_configuration&& config,
+    const libremidi::input_port& port
+) {
+    auto api_conf = libremidi::midi_in_configuration_for(port.api);
+    libremidi::set_client_name(api_conf, kInternalClientName);
+    return std::make_unique<libremidi::midi_in>(std::move(config), std::move(api_conf));
+}
 
-    LrmMidiOut(libremidi::output_port port) {
-        // Use the API that enumerated this port. For MIDI 2 backends
-        // (WinMIDI), libremidi converts MIDI 1 send_message() to UMP.
-        auto api = port.api;
-        auto api_conf = libremidi::midi_out_configuration_for(api);
-        libremidi::set_client_name(api_conf, kInternalClientName);
-        midi_out = std::make_unique<libremidi::midi_out>(
-            libremidi::output_configuration{},
-            std::move(api_conf)
-        );
-        midi_out->open_port(port);
-    }
-};
+static std::unique_ptr<libremidi::midi_out> lrm_create_midi_out(const libremidi::output_port& port) {
+    auto api_conf = libremidi::midi_out_configuration_for(port.api);
+    libremidi::set_client_name(api_conf, kInternalClientName);
+    // Scheduled timestamps are on the lrm_now_ns() clock
+    libremidi::output_configuration config;
+    config.timestamps = libremidi::timestamp_mode::SystemMonotonic;
+    return std::make_unique<libremidi::midi_out>(
+        std::move(config),
+        std::move(api_conf)
+    );
+}
 
 // =============================================================================
 // Library info
@@ -320,6 +404,24 @@ extern "C" FFI_PLUGIN_EXPORT LrmObserver* lrm_observer_new_with_callbacks(
     }
 }
 
+extern "C" FFI_PLUGIN_EXPORT LrmObserver* lrm_observer_new_async(
+    LrmHotplugCallback callback,
+    void* context,
+    bool track_hotplug
+) {
+    if (!callback) return nullptr;
+    try {
+        return new LrmObserver(callback, context, track_hotplug, true);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_observer_get_status(LrmObserver* observer) {
+    if (!observer) return LRM_ERR_INVALID;
+    return observer->status.load(std::memory_order_acquire);
+}
+
 extern "C" FFI_PLUGIN_EXPORT void lrm_observer_free(LrmObserver* observer) {
     delete observer;
 }
@@ -345,12 +447,6 @@ static void safe_strcpy(char* dest, size_t dest_size, const std::string& src) {
     dest[dest_size - 1] = '\0';
 }
 
-// Generate stable port key for cross-platform identification
-template<typename PortType>
-static std::string port_key(const PortType& port) {
-    return port.port_name + "|" + port.manufacturer + "|" + port.product + "|" + port.serial;
-}
-
 // Helper to fill port info from libremidi port
 template<typename PortType>
 static void fill_port_info(const PortType& port, int32_t index, bool is_input, LrmPortInfo* info) {
@@ -362,9 +458,7 @@ static void fill_port_info(const PortType& port, int32_t index, bool is_input, L
     info->client_handle = static_cast<uint64_t>(port.client);
     info->index = index;
 
-    // Generate stable_id from port key hash
-    // On macOS/iOS port.port (MIDIEndpointRef) is already stable, but we use hash for consistency
-    info->stable_id = fnv1a_hash(port_key(port));
+    info->stable_id = stable_port_id(port);
 
     // Names
     safe_strcpy(info->display_name, sizeof(info->display_name), port.display_name);
@@ -407,119 +501,74 @@ extern "C" FFI_PLUGIN_EXPORT int32_t lrm_observer_get_output(LrmObserver* observ
     return LRM_OK;
 }
 
-// =============================================================================
-// MIDI Output API
-// =============================================================================
-
-extern "C" FFI_PLUGIN_EXPORT LrmMidiOut* lrm_midi_out_open(LrmObserver* observer, int32_t port_index) {
-    if (!observer) return nullptr;
-    if (port_index < 0) return nullptr;
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_observer_get_input_by_id(LrmObserver* observer, uint64_t port_id, LrmPortInfo* info) {
+    if (!observer || !info) return LRM_ERR_INVALID;
 
-    libremidi::output_port port;
-    if (!observer->getOutputPort(static_cast<size_t>(port_index), port)) {
-        return nullptr;
+    libremidi::input_port port;
+    int32_t index = 0;
+    if (!observer->getInputPortById(port_id, port, &index)) {
+        return LRM_ERR_NOT_FOUND;
     }
 
-    try {
-        return new LrmMidiOut(port);
-    } catch (...) {
-        return nullptr;
-    }
+    fill_port_info(port, index, true, info);
+    return LRM_OK;
 }
 
-extern "C" FFI_PLUGIN_EXPORT LrmMidiOut* lrm_midi_out_open_by_id(LrmObserver* observer, uint64_t port_id) {
-    if (!observer) return nullptr;
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_observer_get_output_by_id(LrmObserver* observer, uint64_t port_id, LrmPortInfo* info) {
+    if (!observer || !info) return LRM_ERR_INVALID;
 
     libremidi::output_port port;
-    if (!observer->getOutputPortById(port_id, port)) {
-        return nullptr;
-    }
-
-    try {
-        return new LrmMidiOut(port);
-    } catch (...) {
-        return nullptr;
+    int32_t index = 0;
+    if (!observer->getOutputPortById(port_id, port, &index)) {
+        return LRM_ERR_NOT_FOUND;
     }
-}
 
-extern "C" FFI_PLUGIN_EXPORT void lrm_midi_out_close(LrmMidiOut* midi_out) {
-    delete midi_out;
-}
-
-extern "C" FFI_PLUGIN_EXPORT bool lrm_midi_out_is_connected(LrmMidiOut* midi_out) {
-    if (!midi_out || !midi_out->midi_out) return false;
-    return midi_out->midi_out->is_port_connected();
-}
-
-extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_send(LrmMidiOut* midi_out, const uint8_t* data, size_t length) {
-    if (!midi_out || !midi_out->midi_out || !data) return LRM_ERR_INVALID;
-
-    try {
-        midi_out->midi_out->send_message(data, length);
-        return LRM_OK;
-    } catch (...) {
-        return LRM_ERR_SEND_FAILED;
-    }
+    fill_port_info(port, index, false, info);
+    return LRM_OK;
 }
 
-// =============================================================================
-// MIDI Input API
-// =============================================================================
-
-extern "C" FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open(
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_observer_find_by_stable_id(
     LrmObserver* observer,
-    int32_t port_index,
-    LrmMidiCallback callback,
-    void* context,
-    bool receive_sysex,
-    bool receive_timing,
-    bool receive_sensing
+    uint64_t stable_id,
+    bool is_input,
+    LrmPortInfo* info
 ) {
-    if (!observer) return nullptr;
-    if (port_index < 0) return nullptr;
+    if (!observer || !info) return LRM_ERR_INVALID;
 
-    libremidi::input_port port;
-    if (!observer->getInputPort(static_cast<size_t>(port_index), port)) {
-        return nullptr;
+    int32_t index = 0;
+    if (is_input) {
+        libremidi::input_port port;
+        if (!observer->getInputPortByStableId(stable_id, port, &index)) return LRM_ERR_NOT_FOUND;
+        fill_port_info(port, index, true, info);
+    } else {
+        libremidi::output_port port;
+        if (!observer->getOutputPortByStableId(stable_id, port, &index)) return LRM_ERR_NOT_FOUND;
+        fill_port_info(port, index, false, info);
     }
+    return LRM_OK;
+}
 
-    try {
-        return new LrmMidiIn(port, callback, context,
-                            receive_sysex, receive_timing, receive_sensing);
-    } catch (...) {
-        return nullptr;
-    }
+extern "C" FFI_PLUGIN_EXPORT uint64_t lrm_observer_get_generation(LrmObserver* observer) {
+    if (!observer) return 0;
+    return observer->getGeneration();
 }
 
-extern "C" FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_by_id(
-    LrmObserver* observer,
-    uint64_t port_id,
-    LrmMidiCallback callback,
-    void* context,
-    bool receive_sysex,
-    bool receive_timing,
-    bool receive_sensing
-) {
+extern "C" FFI_PLUGIN_EXPORT LrmPortSnapshot* lrm_observer_snapshot(LrmObserver* observer) {
     if (!observer) return nullptr;
-
-    libremidi::input_port port;
-    if (!observer->getInputPortById(port_id, port)) {
-        return nullptr;
-    }
-
     try {
-        return new LrmMidiIn(port, callback, context,
-                            receive_sysex, receive_timing, receive_sensing);
+        return observer->snapshot();
     } catch (...) {
         return nullptr;
     }
 }
 
-extern "C" FFI_PLUGIN_EXPORT void lrm_midi_in_close(LrmMidiIn* midi_in) {
-    delete midi_in;
+extern "C" FFI_PLUGIN_EXPORT void lrm_port_snapshot_free(LrmPortSnapshot* snapshot) {
+    std::free(snapshot);
 }
 
-extern "C" FFI_PLUGIN_EXPORT bool lrm_midi_in_is_connected(LrmMidiIn* midi_in) {
-    if (!midi_in || !midi_in->midi_in) return false;
-    return midi_in->midi_in->is_port_connected();
-}
+// =============================================================================
+// MIDI Output and Input API (shared with the iOS and macOS builds)
+// =============================================================================
+
+#include "lrm_midi_io.hpp"
+
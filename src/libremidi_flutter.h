@@ -25,6 +25,11 @@ extern "C" {
 #define LRM_ERR_OPEN_FAILED -3
 #define LRM_ERR_SEND_FAILED -4
 #define LRM_ERR_INIT_FAILED -5
+#define LRM_ERR_BUFFER_TOO_SMALL -6
+#define LRM_ERR_QUEUE_FULL  -7
+
+// lrm_observer_get_status: an asynchronous start is still enumerating
+#define LRM_OBSERVER_STARTING 1
 
 // =============================================================================
 // Opaque handle types
@@ -33,6 +38,9 @@ extern "C" {
 typedef struct LrmObserver LrmObserver;
 typedef struct LrmMidiIn LrmMidiIn;
 typedef struct LrmMidiOut LrmMidiOut;
+typedef struct LrmRoute LrmRoute;
+typedef struct LrmClock LrmClock;
+typedef struct LrmMidiOutGroup LrmMidiOutGroup;
 
 // =============================================================================
 // Port information
@@ -69,6 +77,318 @@ typedef struct LrmPortInfo {
     bool is_virtual;            // true if virtual/software port
 } LrmPortInfo;
 
+// One port of an LrmPortSnapshot. Names are offsets of NUL-terminated UTF-8
+// strings in the snapshot's string table.
+typedef struct LrmPortRecord {
+    uint64_t stable_id;         // Same as LrmPortInfo
+    uint64_t port_id;
+    uint64_t client_handle;
+    uint32_t display_name;      // String table offsets; 0 is the empty string
+    uint32_t port_name;
+    uint32_t device_name;
+    uint32_t manufacturer;
+    uint32_t product;
+    uint32_t serial;
+    int32_t index;              // Index in its direction's enumeration
+    uint8_t transport_type;
+    bool is_input;
+    bool is_virtual;
+} LrmPortRecord;
+
+// Immutable copy of an observer's port lists, allocated as a single block
+// together with its records and strings (see lrm_observer_snapshot)
+typedef struct LrmPortSnapshot {
+    uint64_t generation;        // lrm_observer_get_generation() when it was taken
+    uint32_t input_count;
+    uint32_t output_count;
+    uint32_t strings_size;      // Bytes in strings
+    const LrmPortRecord* ports; // input_count inputs, then output_count outputs
+    const char* strings;        // Deduplicated string table
+} LrmPortSnapshot;
+
+// =============================================================================
+// Buffered input
+// =============================================================================
+
+// Overflow policies for ring-buffered inputs (lrm_midi_in_open_ring)
+#define LRM_OVERFLOW_DROP_OLDEST 0
+#define LRM_OVERFLOW_DROP_NEWEST 1
+
+// Size of the header preceding each packed message record.
+// A packed record is: int64_t timestamp, uint32_t length, uint8_t data[length],
+// tightly packed in native byte order with no padding between records.
+#define LRM_PACKED_HEADER_SIZE 12
+
+// =============================================================================
+// Asynchronous output
+// =============================================================================
+
+// What lrm_midi_out_send does when an asynchronous output's queue is full
+#define LRM_BACKPRESSURE_BLOCK 0  // Wait until the writer thread makes room
+#define LRM_BACKPRESSURE_DROP  1  // Discard the message, count it, return LRM_OK
+#define LRM_BACKPRESSURE_FAIL  2  // Discard the message, return LRM_ERR_QUEUE_FULL
+
+// =============================================================================
+// Output optimizer
+// =============================================================================
+
+// Settings of lrm_midi_out_set_optimizer. Applies to Control Change, Pitch
+// Bend, Channel Pressure and Poly Pressure messages; other messages are never
+// dropped and keep their order relative to everything else.
+typedef struct LrmMidiOptimizer {
+    bool drop_duplicates;           // Drop a value equal to the last one for the same controller
+    uint32_t coalesce_interval_us;  // Send at most one value per controller per interval (0: off)
+    uint32_t max_bytes_per_second;  // Pace all output to this rate (0: unlimited; DIN MIDI is 3125)
+} LrmMidiOptimizer;
+
+// Counters of an output optimizer (lrm_midi_out_get_optimizer_stats)
+typedef struct LrmMidiOptimizerStats {
+    uint64_t duplicates;  // Messages dropped as repeated values
+    uint64_t coalesced;   // Messages replaced by a newer value before being sent
+    uint64_t delayed;     // Messages held back by the interval or the byte rate
+    uint64_t pending;     // Messages waiting to be sent
+} LrmMidiOptimizerStats;
+
+// =============================================================================
+// Paced SysEx output
+// =============================================================================
+
+// Pacing of lrm_midi_out_send_sysex_paced. The waits add up: after each piece
+// the next one starts after chunk_delay_us and once the byte rate allows it.
+typedef struct LrmSysexPacing {
+    uint32_t chunk_size;            // Largest piece of a message in bytes (0: whole messages)
+    uint32_t chunk_delay_us;        // Pause after each piece
+    uint32_t max_bytes_per_second;  // Average rate limit (0: unlimited)
+} LrmSysexPacing;
+
+// States of a paced SysEx transfer
+#define LRM_SYSEX_TX_QUEUED    0  // Waiting for earlier transfers
+#define LRM_SYSEX_TX_SENDING   1
+#define LRM_SYSEX_TX_DONE      2  // Every byte was accepted by the backend
+#define LRM_SYSEX_TX_FAILED    3  // The backend rejected a piece
+#define LRM_SYSEX_TX_CANCELLED 4
+
+// Progress of a paced SysEx transfer (lrm_midi_out_get_sysex_transfer)
+typedef struct LrmSysexTransferStatus {
+    uint64_t bytes_sent;
+    uint64_t bytes_total;
+    int32_t state;  // LRM_SYSEX_TX_*
+} LrmSysexTransferStatus;
+
+// =============================================================================
+// Automation curves
+// =============================================================================
+
+// What an automation curve drives (LrmAutomation.target)
+#define LRM_AUTOMATION_CC         0  // 7-bit Control Change `number` (0-127)
+#define LRM_AUTOMATION_CC14       1  // 14-bit Control Change `number` (0-31) and `number` + 32
+#define LRM_AUTOMATION_PITCH_BEND 2  // Pitch bend; 0.5 is the centre
+#define LRM_AUTOMATION_NRPN       3  // 14-bit NRPN parameter `number` (0-16383)
+
+// Shape of the segment ending at a point (LrmAutomationPoint.shape)
+#define LRM_SEGMENT_LINEAR      0
+#define LRM_SEGMENT_EXPONENTIAL 1
+
+// Target and sampling of lrm_midi_out_automate
+typedef struct LrmAutomation {
+    int32_t target;             // LRM_AUTOMATION_*
+    uint8_t channel;            // 0-15
+    uint16_t number;            // Controller or NRPN parameter, per target
+    uint32_t rate_hz;           // Values computed per second (at most 2000); 0 for 100
+} LrmAutomation;
+
+// Breakpoint of an automation curve
+typedef struct LrmAutomationPoint {
+    uint32_t duration_us;       // Time from the previous point; for the first point, a start delay
+    float value;                // 0.0 - 1.0 of the target's range
+    int32_t shape;              // LRM_SEGMENT_* of the segment ending here
+    float curvature;            // Exponential steepness: > 0 starts slowly, < 0 quickly; 0 for 4
+} LrmAutomationPoint;
+
+// Counters of an output's automation (lrm_midi_out_get_automation_stats)
+typedef struct LrmAutomationStats {
+    uint64_t updates;           // Values sent
+    uint64_t unchanged;         // Samples not sent because the value had not changed
+    uint32_t running;           // Curves currently running
+} LrmAutomationStats;
+
+// =============================================================================
+// Input filtering
+// =============================================================================
+
+// Message kinds for LrmMidiFilter.status_mask (a set bit lets the kind through)
+#define LRM_FILTER_NOTE_OFF         1
+#define LRM_FILTER_NOTE_ON          2
+#define LRM_FILTER_POLY_AFTERTOUCH  4
+#define LRM_FILTER_CONTROL_CHANGE   8
+#define LRM_FILTER_PROGRAM_CHANGE   16
+#define LRM_FILTER_CHANNEL_PRESSURE 32
+#define LRM_FILTER_PITCH_BEND       64
+#define LRM_FILTER_SYSEX            128
+#define LRM_FILTER_SYSTEM_COMMON    256
+#define LRM_FILTER_REALTIME         512
+#define LRM_FILTER_ALL              1023
+
+// Native input filter, evaluated on the backend thread before delivery.
+// Initialize with lrm_midi_filter_init() so unset fields let everything pass.
+typedef struct LrmMidiFilter {
+    uint32_t status_mask;       // Accepted message kinds (LRM_FILTER_*)
+    uint16_t channel_mask;      // Accepted channels, bit n = channel n (0-15)
+    uint8_t note_min;           // Lowest accepted note (note on/off, poly aftertouch)
+    uint8_t note_max;           // Highest accepted note
+    uint8_t controller_min;     // Lowest accepted control change number
+    uint8_t controller_max;     // Highest accepted control change number
+    uint32_t max_size;          // Largest accepted message in bytes (0 = no limit)
+} LrmMidiFilter;
+
+// Number of messages rejected by each LrmMidiFilter criterion
+typedef struct LrmMidiFilterStats {
+    uint64_t rejected_status;       // Message kind not in status_mask
+    uint64_t rejected_channel;      // Channel not in channel_mask
+    uint64_t rejected_note;         // Note outside note_min..note_max
+    uint64_t rejected_controller;   // Controller outside controller_min..controller_max
+    uint64_t rejected_size;         // Message larger than max_size
+} LrmMidiFilterStats;
+
+// =============================================================================
+// Routing
+// =============================================================================
+
+// Changes applied by a route (lrm_route_create) to each forwarded message.
+// Initialize with lrm_route_transform_init() so unset fields change nothing.
+typedef struct LrmRouteTransform {
+    LrmMidiFilter filter;    // Messages to forward, matched before remapping
+    int8_t channel_map[16];  // Output channel for each input channel, or -1 to drop
+    int8_t transpose;        // Semitones added to notes; notes leaving 0-127 are dropped
+    float velocity_scale;    // Note On velocity factor, result clamped to 1-127
+} LrmRouteTransform;
+
+// Counters of a route (lrm_route_get_stats); all 0 for native routes
+typedef struct LrmRouteStats {
+    uint64_t forwarded;      // Messages sent to the output
+    uint64_t dropped;        // Messages rejected by the filter or the remapping
+    uint64_t send_failures;  // Messages the output refused
+} LrmRouteStats;
+
+// =============================================================================
+// Parameter decoding
+// =============================================================================
+
+// Decoder options for lrm_midi_in_open_decoded (decode_flags)
+#define LRM_DECODE_RPN           1  // Decode RPN/NRPN sequences (CC 98-101, 6, 38, 96, 97)
+#define LRM_DECODE_SUPPRESS_RAW  2  // Do not deliver CCs consumed by the decoder
+#define LRM_DECODE_WAIT_FOR_LSB  4  // Report Data Entry and 14-bit CCs only once the LSB arrives
+
+// Parameter kinds reported to LrmParameterCallback
+#define LRM_PARAM_RPN  0
+#define LRM_PARAM_NRPN 1
+#define LRM_PARAM_CC14 2
+
+// Parameter event flags reported to LrmParameterCallback
+#define LRM_PARAM_FLAG_14BIT     1  // value is a 14-bit value (MSB << 7 | LSB)
+#define LRM_PARAM_FLAG_INCREMENT 2  // Data Increment (CC 96), value is the step
+#define LRM_PARAM_FLAG_DECREMENT 4  // Data Decrement (CC 97), value is the step
+
+// =============================================================================
+// SysEx streaming
+// =============================================================================
+
+// Flags passed to LrmSysexChunkCallback
+#define LRM_SYSEX_CHUNK_BEGIN     1  // First chunk of a message (starts with F0)
+#define LRM_SYSEX_CHUNK_CONTINUE  2  // Any later chunk of the same message
+#define LRM_SYSEX_CHUNK_END       4  // Last chunk of the message
+#define LRM_SYSEX_CHUNK_ABORTED   8  // Message was cut off; discard what was received
+#define LRM_SYSEX_CHUNK_TRUNCATED 16 // Message exceeded the cap and ends here without F7
+
+// What happens when a SysEx message exceeds max_sysex_size
+#define LRM_SYSEX_OVERFLOW_ABORT    0  // Deliver an ABORTED end chunk, drop the rest
+#define LRM_SYSEX_OVERFLOW_TRUNCATE 1  // Deliver a TRUNCATED end chunk, drop the rest
+
+// =============================================================================
+// Clock tracking
+// =============================================================================
+
+// Snapshot of an incoming MIDI clock (lrm_midi_in_get_clock_state), or of a
+// clock generator (lrm_clock_get_state)
+typedef struct LrmClockState {
+    double bpm;                 // Smoothed tempo, 0 until two ticks were received
+    double beat_phase;          // Position within the current beat (0.0 - 1.0)
+    double jitter_us;           // Mean deviation of the tick interval (generator: lateness) in microseconds
+    uint64_t tick_count;        // Clock ticks (F8) received since the port was opened, or sent
+    int32_t song_position;      // Song position in sixteenth notes (MIDI beats)
+    bool running;               // Between Start/Continue and Stop
+} LrmClockState;
+
+// =============================================================================
+// MIDI Time Code
+// =============================================================================
+
+// Frame rates (LrmTimecode.rate), as encoded in MTC messages
+#define LRM_MTC_24FPS      0
+#define LRM_MTC_25FPS      1
+#define LRM_MTC_30FPS_DROP 2  // 29.97 fps drop-frame
+#define LRM_MTC_30FPS      3
+
+// SMPTE position of incoming (lrm_midi_in_get_timecode) or generated
+// (lrm_midi_out_get_timecode) MIDI Time Code
+typedef struct LrmTimecode {
+    int32_t hours;              // 0 - 23
+    int32_t minutes;            // 0 - 59
+    int32_t seconds;            // 0 - 59
+    int32_t frames;             // 0 - fps-1
+    int32_t rate;               // LRM_MTC_*
+    bool locked;                // Reader: following running quarter frames; generator: running
+    uint64_t quarter_frames;    // Quarter frames (F1) received or sent
+} LrmTimecode;
+
+// =============================================================================
+// Statistics
+// =============================================================================
+
+// Counters of a MIDI input (lrm_midi_in_get_stats)
+// Latency runs from the backend hand-off (the message timestamp on
+// LRM_TIMESTAMP_MONOTONIC inputs) until the callback, ring or batcher took
+// the message. Forwarding to routes is not included.
+typedef struct LrmMidiInStats {
+    uint64_t messages;          // Messages received from the backend
+    uint64_t bytes;             // Bytes received from the backend
+    uint64_t sysex_fragments;   // SysEx messages, or chunks when streaming SysEx
+    uint64_t dropped;           // Messages discarded because a buffer was full
+    uint64_t filtered;          // Messages rejected by the filter or consumed natively
+    uint64_t max_latency_ns;    // Longest time from backend hand-off to delivery
+    uint64_t p99_latency_ns;    // 99th percentile of the same (within 25%)
+} LrmMidiInStats;
+
+// Counters of a MIDI output (lrm_midi_out_get_stats)
+typedef struct LrmMidiOutStats {
+    uint64_t messages;          // Messages sent successfully
+    uint64_t bytes;             // Bytes sent successfully
+    uint64_t sysex_messages;    // SysEx messages sent successfully
+    uint64_t send_failures;     // Sends rejected by the backend
+    uint64_t send_time_ns;      // Total time spent inside the backend send call
+    uint64_t max_send_ns;       // Longest single backend send call
+    uint64_t p99_send_ns;       // 99th percentile of the send call duration (within 25%)
+    uint64_t queue_pending;     // Asynchronous sends waiting for the writer thread
+    uint64_t queue_completed;   // Asynchronous sends the backend accepted
+    uint64_t queue_failed;      // Asynchronous sends the backend rejected
+    uint64_t queue_overflows;   // Sends refused because the queue was full
+} LrmMidiOutStats;
+
+// =============================================================================
+// Timestamps
+// =============================================================================
+
+// Timestamp modes for the lrm_midi_in_open* functions (timestamps in nanoseconds)
+// ABSOLUTE: the backend's own reference, e.g. the creation of the ALSA
+//           sequencer queue of that port; not comparable across ports
+// MONOTONIC: the lrm_now_ns() clock, comparable across ports
+// RELATIVE: time since the previous message of the same port (0 for the first)
+// NONE: always 0
+#define LRM_TIMESTAMP_ABSOLUTE  0
+#define LRM_TIMESTAMP_MONOTONIC 1
+#define LRM_TIMESTAMP_RELATIVE  2
+#define LRM_TIMESTAMP_NONE      3
+
 // =============================================================================
 // Callback types
 // =============================================================================
@@ -81,12 +401,54 @@ typedef void (*LrmMidiCallback)(
     int64_t timestamp
 );
 
+// Called with a batch of MIDI messages coalesced by lrm_midi_in_open_batched
+// data holds `count` packed records (see LRM_PACKED_HEADER_SIZE) and is owned
+// by the receiver, which must release it with lrm_midi_batch_free().
+typedef void (*LrmMidiBatchCallback)(
+    void* context,
+    uint8_t* data,
+    size_t length,
+    int32_t count
+);
+
+// Called when the native decoder of lrm_midi_in_open_decoded completes a
+// parameter change
+// kind: LRM_PARAM_RPN, LRM_PARAM_NRPN or LRM_PARAM_CC14
+// flags: combination of LRM_PARAM_FLAG_*
+// parameter: 14-bit parameter number, or the MSB controller (0-31) for CC14
+typedef void (*LrmParameterCallback)(
+    void* context,
+    int32_t kind,
+    int32_t flags,
+    int32_t channel,
+    int32_t parameter,
+    int32_t value,
+    int64_t timestamp
+);
+
+// Called with one chunk of a streamed SysEx message
+// flags: combination of LRM_SYSEX_CHUNK_*. data is owned by the receiver, which
+// must release it with lrm_midi_batch_free(). timestamp is the time the
+// message started.
+typedef void (*LrmSysexChunkCallback)(
+    void* context,
+    uint8_t* data,
+    size_t length,
+    int32_t flags,
+    int64_t timestamp
+);
+
 // Called when MIDI device configuration changes
 // event_type: 0 = input_added, 1 = input_removed, 2 = output_added,
-//             3 = output_removed, 4 = setup_changed (generic, re-enumerate)
+//             3 = output_removed, 4 = setup_changed (generic, re-enumerate),
+//             5 = ready (lrm_observer_new_async finished starting)
+// port_id: LrmPortInfo.port_id of the port that was added or removed, or 0
+//          when unknown (always for setup_changed). The observer's port list
+//          is already up to date when the callback runs.
 typedef void (*LrmHotplugCallback)(
     void* context,
-    int32_t event_type
+    int32_t event_type,
+    uint64_t port_id
 );
 
 // =============================================================================
@@ -96,11 +458,15 @@ typedef void (*LrmHotplugCallback)(
 // Get library version string
 FFI_PLUGIN_EXPORT const char* lrm_get_version(void);
 
+// Current time in nanoseconds on the clock used by LRM_TIMESTAMP_MONOTONIC
+FFI_PLUGIN_EXPORT int64_t lrm_now_ns(void);
+
 // =============================================================================
 // Observer API - Enumerate MIDI ports
 // =============================================================================
 
-// Create a new observer for enumerating MIDI ports
+// Create a new observer for enumerating MIDI ports. It does not track
+// hotplug; call lrm_observer_refresh() to update the port lists.
 FFI_PLUGIN_EXPORT LrmObserver* lrm_observer_new(void);
 
 // Create a new observer with hotplug callback
@@ -109,6 +475,22 @@ FFI_PLUGIN_EXPORT LrmObserver* lrm_observer_new_with_callbacks(
     void* context
 );
 
+// Create an observer without waiting for the backend: connecting to it and
+// enumerating the ports happen on another thread, which then calls callback
+// with event_type 5 (ready). Until then the port lists are empty and no
+// other events are delivered; check lrm_observer_get_status() when ready
+// arrives. With track_hotplug false, only ready is ever delivered.
+// Returns nullptr if callback is null.
+FFI_PLUGIN_EXPORT LrmObserver* lrm_observer_new_async(
+    LrmHotplugCallback callback,
+    void* context,
+    bool track_hotplug
+);
+
+// LRM_OK once the observer is started, LRM_OBSERVER_STARTING while an
+// asynchronous start is running, LRM_ERR_INIT_FAILED if it failed
+FFI_PLUGIN_EXPORT int32_t lrm_observer_get_status(LrmObserver* observer);
+
 // Free the observer
 FFI_PLUGIN_EXPORT void lrm_observer_free(LrmObserver* observer);
 
@@ -127,6 +509,36 @@ FFI_PLUGIN_EXPORT int32_t lrm_observer_get_input(LrmObserver* observer, int32_t
 // Get output port info by index (returns 0 on success, fills info struct)
 FFI_PLUGIN_EXPORT int32_t lrm_observer_get_output(LrmObserver* observer, int32_t index, LrmPortInfo* info);
 
+// Get input port info by port_id, e.g. the one passed to the hotplug callback
+// (returns LRM_ERR_NOT_FOUND if the port is not in the list)
+FFI_PLUGIN_EXPORT int32_t lrm_observer_get_input_by_id(LrmObserver* observer, uint64_t port_id, LrmPortInfo* info);
+
+// Get output port info by port_id
+FFI_PLUGIN_EXPORT int32_t lrm_observer_get_output_by_id(LrmObserver* observer, uint64_t port_id, LrmPortInfo* info);
+
+// Get port info by stable_id, e.g. to find a device again after it was
+// reconnected. Identical devices without a serial number share a stable_id;
+// the first of them in the list is returned.
+FFI_PLUGIN_EXPORT int32_t lrm_observer_find_by_stable_id(
+    LrmObserver* observer,
+    uint64_t stable_id,
+    bool is_input,
+    LrmPortInfo* info
+);
+
+// Number that changes whenever the observer's port lists change, starting
+// from 1. Compare it with LrmPortSnapshot.generation to skip taking a new
+// snapshot when nothing changed.
+FFI_PLUGIN_EXPORT uint64_t lrm_observer_get_generation(LrmObserver* observer);
+
+// Copy both port lists into one immutable buffer, instead of one
+// lrm_observer_get_input/lrm_observer_get_output call per port.
+// Returns nullptr on failure. Release it with lrm_port_snapshot_free().
+FFI_PLUGIN_EXPORT LrmPortSnapshot* lrm_observer_snapshot(LrmObserver* observer);
+
+// Free a snapshot returned by lrm_observer_snapshot
+FFI_PLUGIN_EXPORT void lrm_port_snapshot_free(LrmPortSnapshot* snapshot);
+
 // =============================================================================
 // MIDI Output API
 // =============================================================================
@@ -137,6 +549,21 @@ FFI_PLUGIN_EXPORT LrmMidiOut* lrm_midi_out_open(LrmObserver* observer, int32_t p
 // Open a MIDI output port by port_id (stable across hotplug)
 FFI_PLUGIN_EXPORT LrmMidiOut* lrm_midi_out_open_by_id(LrmObserver* observer, uint64_t port_id);
 
+// Open a MIDI output port by port_id in asynchronous mode
+// lrm_midi_out_send and lrm_midi_out_send_batch copy the data into a bounded
+// queue and return without calling the backend; a dedicated writer thread
+// sends the queued data in order. queue_depth is a number of sends, rounded
+// up to a power of two (0 selects the default of 256).
+// backpressure: LRM_BACKPRESSURE_BLOCK, LRM_BACKPRESSURE_DROP or
+// LRM_BACKPRESSURE_FAIL. Backend failures are only visible in the statistics.
+// Closing sends whatever is still queued first.
+FFI_PLUGIN_EXPORT LrmMidiOut* lrm_midi_out_open_async(
+    LrmObserver* observer,
+    uint64_t port_id,
+    uint32_t queue_depth,
+    int32_t backpressure
+);
+
 // Close and free a MIDI output
 FFI_PLUGIN_EXPORT void lrm_midi_out_close(LrmMidiOut* midi_out);
 
@@ -144,8 +571,131 @@ FFI_PLUGIN_EXPORT void lrm_midi_out_close(LrmMidiOut* midi_out);
 FFI_PLUGIN_EXPORT bool lrm_midi_out_is_connected(LrmMidiOut* midi_out);
 
 // Send a MIDI message
+// On an asynchronous output the message is queued (see lrm_midi_out_open_async)
 FFI_PLUGIN_EXPORT int32_t lrm_midi_out_send(LrmMidiOut* midi_out, const uint8_t* data, size_t length);
 
+// Send several complete MIDI messages concatenated in data
+// Every message starts with its status byte; SysEx ends with F7. On ALSA the
+// whole buffer is submitted with a single drain. Returns the number of
+// messages sent (fewer than in data if the backend failed part way),
+// LRM_ERR_INVALID if data is not a sequence of complete messages (nothing is
+// sent), or LRM_ERR_SEND_FAILED if nothing could be sent.
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_send_batch(LrmMidiOut* midi_out, const uint8_t* data, size_t length);
+
+// Get the output's staging buffer, grown to hold at least size bytes
+// The caller writes messages into it in place and sends them with
+// lrm_midi_out_commit or lrm_midi_out_commit_batch, avoiding a copy and an
+// allocation per send. The buffer is owned by the output and stays valid
+// until the next lrm_midi_out_acquire with a larger size or until close.
+// Only one thread at a time may use it. Returns NULL if size is 0 or the
+// buffer cannot grow.
+FFI_PLUGIN_EXPORT uint8_t* lrm_midi_out_acquire(LrmMidiOut* midi_out, size_t size);
+
+// Send the first size bytes of the staging buffer as for lrm_midi_out_send
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_commit(LrmMidiOut* midi_out, size_t size);
+
+// Send the first size bytes of the staging buffer as for
+// lrm_midi_out_send_batch (returns the number of messages)
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_commit_batch(LrmMidiOut* midi_out, size_t size);
+
+// Schedule complete MIDI messages (as for lrm_midi_out_send_batch) to be sent
+// at timestamp_ns on the lrm_now_ns() clock
+// A native thread dispatches them in timestamp order; messages with the same
+// timestamp keep their order, and past timestamps are sent immediately.
+// Pending messages are discarded by lrm_midi_out_close() unless flushed first.
+// On the ALSA sequencer, messages are handed to a kernel queue 10 ms before
+// they are due and delivered from there; from then on they cannot be
+// cancelled, and close waits for them to go out.
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_schedule(
+    LrmMidiOut* midi_out,
+    int64_t timestamp_ns,
+    const uint8_t* data,
+    size_t length
+);
+
+// Discard all scheduled messages. Returns the number discarded.
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_cancel_scheduled(LrmMidiOut* midi_out);
+
+// Send all scheduled messages now, in timestamp order. Returns the number sent.
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_flush_scheduled(LrmMidiOut* midi_out);
+
+// Get the number of scheduled messages not sent yet
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_get_scheduled_count(LrmMidiOut* midi_out);
+
+// Get the counters of an output (returns 0 on success, fills stats struct)
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_get_stats(LrmMidiOut* midi_out, LrmMidiOutStats* stats);
+
+// Send one or more complete SysEx messages (e.g. a .syx file) in paced pieces
+// from a native thread. Transfers on the same output are sent one after the
+// other. Avoid sending other non-realtime messages on the output meanwhile, as
+// they would land inside the SysEx. Closing the output cancels what is left.
+// Returns a transfer id (> 0) for lrm_midi_out_get_sysex_transfer, or an
+// error code.
+FFI_PLUGIN_EXPORT int64_t lrm_midi_out_send_sysex_paced(
+    LrmMidiOut* midi_out,
+    const uint8_t* data,
+    size_t length,
+    const LrmSysexPacing* pacing
+);
+
+// Get the progress of a paced SysEx transfer. The state of finished transfers
+// is kept for the 64 most recent ones; older ids return LRM_ERR_NOT_FOUND.
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_get_sysex_transfer(
+    LrmMidiOut* midi_out,
+    int64_t transfer_id,
+    LrmSysexTransferStatus* status
+);
+
+// Cancel a paced SysEx transfer, or all of them with transfer_id 0. A message
+// cut short is terminated with F7.
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_cancel_sysex(LrmMidiOut* midi_out, int64_t transfer_id);
+
+// Route lrm_midi_out_send and lrm_midi_out_send_batch through an optimizer
+// that drops repeated controller values, coalesces fast controller movements
+// and paces output (see LrmMidiOptimizer). Delayed messages are sent from a
+// pacing thread. NULL settings remove the optimizer after sending whatever it
+// still holds. Safe to call while routes, clocks or generators send to the
+// output from their own threads.
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_set_optimizer(LrmMidiOut* midi_out, const LrmMidiOptimizer* settings);
+
+// Get the counters of the output's optimizer (all 0 without an optimizer)
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_get_optimizer_stats(LrmMidiOut* midi_out, LrmMidiOptimizerStats* stats);
+
+// Send MIDI Time Code from position onwards: a full-frame message to locate,
+// then quarter frames at position->rate from a native thread. Restarts from
+// the new position if already running.
+// Returns LRM_ERR_INVALID for an invalid position or rate.
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_start_timecode(LrmMidiOut* midi_out, const LrmTimecode* position);
+
+// Stop sending quarter frames
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_stop_timecode(LrmMidiOut* midi_out);
+
+// Get the position of the generated timecode
+// Returns LRM_ERR_INVALID if timecode was never started on this output.
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_get_timecode(LrmMidiOut* midi_out, LrmTimecode* position);
+
+// Render an automation curve natively: from the first point's value through
+// each later point, sampled settings->rate_hz times per second by a native
+// thread and sent when the value changes. A curve already running on the
+// same target (channel and controller, pitch bend, or NRPN parameter) is
+// cancelled. Returns the curve id (> 0) or a negative error code.
+FFI_PLUGIN_EXPORT int64_t lrm_midi_out_automate(
+    LrmMidiOut* midi_out,
+    const LrmAutomation* settings,
+    const LrmAutomationPoint* points,
+    size_t count
+);
+
+// Stop a curve where it is, or every curve with curve_id 0
+// Returns LRM_ERR_NOT_FOUND if no such curve is running.
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_cancel_automation(LrmMidiOut* midi_out, int64_t curve_id);
+
+// Whether a curve is still running
+FFI_PLUGIN_EXPORT bool lrm_midi_out_is_automating(LrmMidiOut* midi_out, int64_t curve_id);
+
+// Get the automation counters of an output (all 0 before the first curve)
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_get_automation_stats(LrmMidiOut* midi_out, LrmAutomationStats* stats);
+
 // =============================================================================
 // MIDI Input API
 // =============================================================================
@@ -182,6 +732,300 @@ FFI_PLUGIN_EXPORT void lrm_midi_in_close(LrmMidiIn* midi_in);
 // Check if input is connected
 FFI_PLUGIN_EXPORT bool lrm_midi_in_is_connected(LrmMidiIn* midi_in);
 
+// Get the counters of an input (returns 0 on success, fills stats struct)
+FFI_PLUGIN_EXPORT int32_t lrm_midi_in_get_stats(LrmMidiIn* midi_in, LrmMidiInStats* stats);
+
+// Open a MIDI input port by port_id with a choice of timestamp domain
+// lrm_midi_in_open_by_id always uses LRM_TIMESTAMP_ABSOLUTE. The extended
+// lrm_midi_in_open_* functions below take the same timestamp_mode argument.
+// timestamp_mode: one of LRM_TIMESTAMP_*
+FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_timestamped(
+    LrmObserver* observer,
+    uint64_t port_id,
+    LrmMidiCallback callback,
+    void* context,
+    int32_t timestamp_mode,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing
+);
+
+// Open a MIDI input port by port_id in ring-buffer mode
+// Instead of invoking a callback per message, the backend thread writes
+// messages into a bounded lock-free ring that is drained with
+// lrm_midi_in_read_batch(). capacity is in bytes and is rounded up to a
+// power of two (0 selects the default of 64 KiB).
+// overflow_policy: LRM_OVERFLOW_DROP_OLDEST or LRM_OVERFLOW_DROP_NEWEST
+FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_ring(
+    LrmObserver* observer,
+    uint64_t port_id,
+    size_t capacity,
+    int32_t overflow_policy,
+    int32_t timestamp_mode,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing
+);
+
+// Drain buffered messages from a ring-mode input into buf as packed records
+// Only whole records are copied. Returns the number of bytes written (0 when
+// empty), LRM_ERR_BUFFER_TOO_SMALL if the next message does not fit into an
+// empty buf, or LRM_ERR_INVALID if the input was not opened in ring mode.
+// A buf as large as the ring capacity always makes progress.
+FFI_PLUGIN_EXPORT int32_t lrm_midi_in_read_batch(LrmMidiIn* midi_in, uint8_t* buf, size_t capacity);
+
+// Get the ring capacity in bytes of a ring-mode input (0 otherwise)
+FFI_PLUGIN_EXPORT size_t lrm_midi_in_get_ring_capacity(LrmMidiIn* midi_in);
+
+// Get the number of messages discarded because the ring was full, or, for a
+// batched input, because the batch buffer could not be allocated
+FFI_PLUGIN_EXPORT uint64_t lrm_midi_in_get_dropped_count(LrmMidiIn* midi_in);
+
+// Open a MIDI input port by port_id with batched delivery
+// Messages are coalesced and passed to callback as packed records. A batch is
+// delivered when it holds max_messages messages or max_bytes bytes, or
+// window_us microseconds after its first message arrived, whichever comes
+// first. Zero selects the defaults (1000 us, 256 messages, 16 KiB).
+// Messages that do not fit because a batch buffer cannot be allocated are
+// counted in lrm_midi_in_get_dropped_count() and LrmMidiInStats.dropped.
+FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_batched(
+    LrmObserver* observer,
+    uint64_t port_id,
+    LrmMidiBatchCallback callback,
+    void* context,
+    uint32_t window_us,
+    uint32_t max_messages,
+    uint32_t max_bytes,
+    int32_t timestamp_mode,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing
+);
+
+// Release a buffer received through LrmMidiBatchCallback or LrmSysexChunkCallback
+FFI_PLUGIN_EXPORT void lrm_midi_batch_free(uint8_t* data);
+
+// Fill filter with settings that accept every message
+FFI_PLUGIN_EXPORT void lrm_midi_filter_init(LrmMidiFilter* filter);
+
+// Open a MIDI input port by port_id with a native filter
+// Messages rejected by filter are counted and never reach the callback.
+// The filter is copied; it may be freed once this call returns.
+FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_filtered(
+    LrmObserver* observer,
+    uint64_t port_id,
+    LrmMidiCallback callback,
+    void* context,
+    const LrmMidiFilter* filter,
+    int32_t timestamp_mode,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing
+);
+
+// Open a MIDI input port by port_id with native RPN/NRPN and 14-bit CC decoding
+// Decoded events go to param_callback; all other messages go to callback.
+// cc14_mask selects which controllers 0-31 are paired with their LSB
+// (controller + 32), bit n = controller n. filter may be NULL.
+// decode_flags: combination of LRM_DECODE_*
+FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_decoded(
+    LrmObserver* observer,
+    uint64_t port_id,
+    LrmMidiCallback callback,
+    LrmParameterCallback param_callback,
+    void* context,
+    const LrmMidiFilter* filter,
+    uint32_t decode_flags,
+    uint32_t cc14_mask,
+    int32_t timestamp_mode,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing
+);
+
+// Open a MIDI input port by port_id with chunked SysEx streaming
+// SysEx is not reassembled; it is passed to chunk_callback in chunks of at
+// most chunk_size bytes (0 selects 4 KiB) as it arrives. All other messages
+// go to callback. max_sysex_size caps a single message (0 = no limit), and
+// overflow_policy (LRM_SYSEX_OVERFLOW_*) decides how an oversized one ends.
+FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_sysex_stream(
+    LrmObserver* observer,
+    uint64_t port_id,
+    LrmMidiCallback callback,
+    LrmSysexChunkCallback chunk_callback,
+    void* context,
+    uint32_t chunk_size,
+    uint32_t max_sysex_size,
+    int32_t overflow_policy,
+    int32_t timestamp_mode,
+    bool receive_timing,
+    bool receive_sensing
+);
+
+// Get the number of streamed SysEx messages that were cut short, either by
+// max_sysex_size or because they were never terminated
+FFI_PLUGIN_EXPORT uint64_t lrm_midi_in_get_sysex_aborted_count(LrmMidiIn* midi_in);
+
+// Open a MIDI input port by port_id with a native clock tracker
+// Clock ticks (F8), Start/Continue/Stop and Song Position Pointer are
+// consumed natively; poll the result with lrm_midi_in_get_clock_state().
+// If suppress_ticks is true, F8 ticks are not passed to callback; the
+// transport messages always are.
+FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_clock(
+    LrmObserver* observer,
+    uint64_t port_id,
+    LrmMidiCallback callback,
+    void* context,
+    bool suppress_ticks,
+    int32_t timestamp_mode,
+    bool receive_sysex,
+    bool receive_sensing
+);
+
+// Get the tempo, phase, song position and jitter of the tracked clock
+// Returns LRM_OK, or LRM_ERR_INVALID if the input does not track the clock.
+FFI_PLUGIN_EXPORT int32_t lrm_midi_in_get_clock_state(LrmMidiIn* midi_in, LrmClockState* state);
+
+// Open a MIDI input port by port_id with a native MIDI Time Code reader
+// Quarter frames (F1) and full-frame SysEx are decoded natively; poll the
+// position with lrm_midi_in_get_timecode(). If suppress_quarter_frames is
+// true, quarter frames are not passed to callback. Timing messages are
+// received, so clock ticks (F8) reach callback.
+FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_timecode(
+    LrmObserver* observer,
+    uint64_t port_id,
+    LrmMidiCallback callback,
+    void* context,
+    bool suppress_quarter_frames,
+    int32_t timestamp_mode,
+    bool receive_sysex,
+    bool receive_sensing
+);
+
+// Get the SMPTE position and lock status of the incoming timecode
+// Returns LRM_OK, or LRM_ERR_INVALID if the input does not read timecode.
+FFI_PLUGIN_EXPORT int32_t lrm_midi_in_get_timecode(LrmMidiIn* midi_in, LrmTimecode* position);
+
+// Get the per-criterion rejection counters of a filtered input
+// Returns LRM_OK, or LRM_ERR_INVALID if the input has no filter.
+FFI_PLUGIN_EXPORT int32_t lrm_midi_in_get_filter_stats(LrmMidiIn* midi_in, LrmMidiFilterStats* stats);
+
+// =============================================================================
+// Routing API
+// =============================================================================
+
+// Initialize a transform that forwards every message unchanged
+FFI_PLUGIN_EXPORT void lrm_route_transform_init(LrmRouteTransform* transform);
+
+// Forward messages from an input to an output on the input's backend thread,
+// without going through Dart. Several routes can share an input (split) or an
+// output (merge). transform may be NULL to forward unchanged.
+// When both ports are ALSA sequencer ports and nothing is changed, the route
+// is a kernel connection instead (see lrm_route_is_native): it then carries
+// everything the source sends, including clock and SysEx.
+// SysEx received by a streaming input (lrm_midi_in_open_sysex_stream) is not
+// forwarded. Destroy the route before closing either port.
+FFI_PLUGIN_EXPORT LrmRoute* lrm_route_create(
+    LrmMidiIn* midi_in,
+    LrmMidiOut* midi_out,
+    const LrmRouteTransform* transform
+);
+
+// Whether the route is a kernel-level connection rather than forwarded by us
+FFI_PLUGIN_EXPORT bool lrm_route_is_native(LrmRoute* route);
+
+// Get the counters of a route (returns 0 on success, fills stats struct)
+FFI_PLUGIN_EXPORT int32_t lrm_route_get_stats(LrmRoute* route, LrmRouteStats* stats);
+
+// Stop forwarding and free the route
+FFI_PLUGIN_EXPORT void lrm_route_destroy(LrmRoute* route);
+
+// =============================================================================
+// Clock Generator API
+// =============================================================================
+
+// Create a MIDI clock master, stopped, at the given tempo (1 - 999 BPM).
+// It sends 24 ticks (F8) per quarter note to every attached output from its
+// own thread, scheduled on absolute deadlines so the tempo does not drift.
+// Returns NULL on failure.
+FFI_PLUGIN_EXPORT LrmClock* lrm_clock_create(double bpm);
+
+// Stop the clock thread and free the clock (sends nothing, not even Stop)
+FFI_PLUGIN_EXPORT void lrm_clock_destroy(LrmClock* clock);
+
+// Attach an output. Detach it (or destroy the clock) before closing it.
+// Returns LRM_ERR_INVALID if it is already attached.
+FFI_PLUGIN_EXPORT int32_t lrm_clock_add_output(LrmClock* clock, LrmMidiOut* midi_out);
+
+// Detach an output; returns once the clock no longer sends to it
+FFI_PLUGIN_EXPORT int32_t lrm_clock_remove_output(LrmClock* clock, LrmMidiOut* midi_out);
+
+// Change the tempo (1 - 999 BPM), from the next tick on
+FFI_PLUGIN_EXPORT int32_t lrm_clock_set_bpm(LrmClock* clock, double bpm);
+
+// Set the swing, from the next tick on: the share of each eighth note taken
+// by its first sixteenth, from 0.5 (straight) to below 1.0
+FFI_PLUGIN_EXPORT int32_t lrm_clock_set_swing(LrmClock* clock, double swing);
+
+// Keep sending ticks while stopped, so followers can hold the tempo
+FFI_PLUGIN_EXPORT int32_t lrm_clock_set_tick_when_stopped(LrmClock* clock, bool enabled);
+
+// Send Start (FA) and run from song position 0. Does nothing while running.
+FFI_PLUGIN_EXPORT int32_t lrm_clock_start(LrmClock* clock);
+
+// Send Stop (FC). Does nothing while stopped.
+FFI_PLUGIN_EXPORT int32_t lrm_clock_stop(LrmClock* clock);
+
+// Send Continue (FB) and run from the current song position
+FFI_PLUGIN_EXPORT int32_t lrm_clock_continue(LrmClock* clock);
+
+// Move to a song position in sixteenth notes (0 - 16383) and send it (F2).
+// Returns LRM_ERR_INVALID while running.
+FFI_PLUGIN_EXPORT int32_t lrm_clock_set_song_position(LrmClock* clock, uint32_t sixteenths);
+
+// Get the tempo, position and timing of the clock (returns 0 on success)
+FFI_PLUGIN_EXPORT int32_t lrm_clock_get_state(LrmClock* clock, LrmClockState* state);
+
+// =============================================================================
+// Output Group API
+// =============================================================================
+
+// Create an empty group of outputs that are sent the same messages by one
+// call. With kernel_fanout, ALSA sequencer members added without a channel
+// map are fed from a single sequencer port of the group, which the kernel
+// copies to each of them; those members' optimizers, writer threads and
+// statistics are bypassed. kernel_fanout is ignored on other backends.
+// Returns NULL on failure.
+FFI_PLUGIN_EXPORT LrmMidiOutGroup* lrm_midi_out_group_create(bool kernel_fanout);
+
+// Free the group (its member outputs stay open)
+FFI_PLUGIN_EXPORT void lrm_midi_out_group_destroy(LrmMidiOutGroup* group);
+
+// Add an output. channel_map, if not NULL, holds 16 entries: the channel
+// (0-15) each channel is sent on for this member, or -1 to leave it out.
+// Remove the output (or destroy the group) before closing it.
+// Returns LRM_ERR_INVALID if the output is already a member.
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_group_add(
+    LrmMidiOutGroup* group,
+    LrmMidiOut* midi_out,
+    const int8_t* channel_map
+);
+
+// Remove an output; returns LRM_ERR_NOT_FOUND if it is not a member
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_group_remove(LrmMidiOutGroup* group, LrmMidiOut* midi_out);
+
+// Send one or more concatenated complete messages to every member
+// Returns the number of members that accepted them, or LRM_ERR_INVALID for
+// empty or malformed data.
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_group_send(
+    LrmMidiOutGroup* group,
+    const uint8_t* data,
+    size_t length
+);
+
+// Number of members fed through the group's kernel fan-out port
+FFI_PLUGIN_EXPORT int32_t lrm_midi_out_group_kernel_fanout_count(LrmMidiOutGroup* group);
+
 #ifdef __cplusplus
 }
 #endif
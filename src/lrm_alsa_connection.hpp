@@ -0,0 +1,77 @@
+// Kernel-level connection between two ALSA sequencer ports, the equivalent of
+// `aconnect sender dest`. Events then go from the sender to the destination
+// inside the kernel, without waking any user-space thread.
+//
+// The subscription is made by a small client of our own; the kernel keeps a
+// subscription after the client that made it closes, so it is removed
+// explicitly on destruction.
+//
+// Only included by builds that use the ALSA backend (LIBREMIDI_ALSA).
+
+#ifndef LRM_ALSA_CONNECTION_HPP
+#define LRM_ALSA_CONNECTION_HPP
+
+#include <libremidi/backends/alsa_seq/helpers.hpp>
+
+#include <cstdint>
+#include <memory>
+
+class LrmAlsaConnection {
+public:
+    // libremidi ALSA sequencer port handles. Returns nullptr if the sequencer
+    // cannot be opened or refuses the subscription.
+    static std::unique_ptr<LrmAlsaConnection> create(uint64_t sender_port, uint64_t dest_port) {
+        const auto& snd = libremidi::libasound::instance();
+        if (!snd.available || !snd.seq.available) return nullptr;
+
+        std::unique_ptr<LrmAlsaConnection> connection(new LrmAlsaConnection(snd));
+        if (snd.seq.open(&connection->seq, "default", SND_SEQ_OPEN_DUPLEX, 0) < 0) {
+            connection->seq = nullptr;
+            return nullptr;
+        }
+        snd.seq.set_client_name(connection->seq, "libremidi_flutter route");
+
+        const auto [sender_client, sender_port_id] = libremidi::alsa_seq::seq_from_port_handle(sender_port);
+        const auto [dest_client, dest_port_id] = libremidi::alsa_seq::seq_from_port_handle(dest_port);
+        connection->sender.client = static_cast<unsigned char>(sender_client);
+        connection->sender.port = static_cast<unsigned char>(sender_port_id);
+        connection->dest.client = static_cast<unsigned char>(dest_client);
+        connection->dest.port = static_cast<unsigned char>(dest_port_id);
+
+        if (snd.seq.port_subscribe_malloc(&connection->subscription) < 0) {
+            connection->subscription = nullptr;
+            return nullptr;
+        }
+        snd.seq.port_subscribe_set_sender(connection->subscription, &connection->sender);
+        snd.seq.port_subscribe_set_dest(connection->subscription, &connection->dest);
+        if (snd.seq.subscribe_port(connection->seq, connection->subscription) < 0) {
+            // Already connected (e.g. by the user with aconnect), or not allowed
+            snd.seq.port_subscribe_free(connection->subscription);
+            connection->subscription = nullptr;
+            return nullptr;
+        }
+        return connection;
+    }
+
+    ~LrmAlsaConnection() {
+        if (subscription) {
+            snd.seq.unsubscribe_port(seq, subscription);
+            snd.seq.port_subscribe_free(subscription);
+        }
+        if (seq) snd.seq.close(seq);
+    }
+
+    LrmAlsaConnection(const LrmAlsaConnection&) = delete;
+    LrmAlsaConnection& operator=(const LrmAlsaConnection&) = delete;
+
+private:
+    explicit LrmAlsaConnection(const libremidi::libasound& library) : snd(library) {}
+
+    const libremidi::libasound& snd;
+    snd_seq_t* seq = nullptr;
+    snd_seq_port_subscribe_t* subscription = nullptr;
+    snd_seq_addr_t sender{};
+    snd_seq_addr_t dest{};
+};
+
+#endif // LRM_ALSA_CONNECTION_HPP
@@ -0,0 +1,134 @@
+// A single ALSA sequencer source port subscribed to several destinations.
+//
+// Each event is written once, addressed to the port's subscribers, and the
+// kernel delivers a copy to every subscribed destination. An output group
+// uses it for its ALSA sequencer members that need no channel remapping,
+// instead of encoding and writing the same message once per member.
+//
+// Only included by builds that use the ALSA backend (LIBREMIDI_ALSA).
+
+#ifndef LRM_ALSA_FANOUT_HPP
+#define LRM_ALSA_FANOUT_HPP
+
+#include <libremidi/backends/alsa_seq/helpers.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+
+class LrmAlsaFanout {
+public:
+    // Returns nullptr if the sequencer cannot be opened
+    static std::unique_ptr<LrmAlsaFanout> create() {
+        const auto& snd = libremidi::libasound::instance();
+        if (!snd.available || !snd.seq.available || !snd.midi.available) return nullptr;
+
+        std::unique_ptr<LrmAlsaFanout> fanout(new LrmAlsaFanout(snd));
+        if (snd.seq.open(&fanout->seq, "default", SND_SEQ_OPEN_OUTPUT, 0) < 0) {
+            fanout->seq = nullptr;
+            return nullptr;
+        }
+        snd.seq.set_client_name(fanout->seq, "libremidi_flutter group");
+
+        snd_seq_port_info_t* pinfo{};
+        snd_seq_port_info_alloca(&pinfo);
+        snd.seq.port_info_set_name(pinfo, "group");
+        snd.seq.port_info_set_capability(pinfo, SND_SEQ_PORT_CAP_READ | SND_SEQ_PORT_CAP_SUBS_READ);
+        snd.seq.port_info_set_type(pinfo, SND_SEQ_PORT_TYPE_MIDI_GENERIC | SND_SEQ_PORT_TYPE_APPLICATION);
+        snd.seq.port_info_set_midi_channels(pinfo, 16);
+        if (snd.seq.create_port(fanout->seq, pinfo) < 0) return nullptr;
+        fanout->port = snd.seq.port_info_get_port(pinfo);
+
+        if (snd.midi.event_new(kEncoderSize, &fanout->coder) < 0) {
+            fanout->coder = nullptr;
+            return nullptr;
+        }
+        snd.midi.event_init(fanout->coder);
+        return fanout;
+    }
+
+    ~LrmAlsaFanout() {
+        for (auto& [handle, subscription] : subscriptions) {
+            snd.seq.unsubscribe_port(seq, subscription);
+            snd.seq.port_subscribe_free(subscription);
+        }
+        if (coder) snd.midi.event_free(coder);
+        if (seq && port >= 0) snd.seq.delete_port(seq, port);
+        if (seq) snd.seq.close(seq);
+    }
+
+    LrmAlsaFanout(const LrmAlsaFanout&) = delete;
+    LrmAlsaFanout& operator=(const LrmAlsaFanout&) = delete;
+
+    // libremidi ALSA sequencer port handle of a destination. Returns false if
+    // the subscription is refused, e.g. because it already exists.
+    bool addDestination(uint64_t dest_port) {
+        if (subscriptions.count(dest_port)) return false;
+
+        const auto [client, port_id] = libremidi::alsa_seq::seq_from_port_handle(dest_port);
+        snd_seq_addr_t sender{};
+        sender.client = static_cast<unsigned char>(snd.seq.client_id(seq));
+        sender.port = static_cast<unsigned char>(port);
+        snd_seq_addr_t dest{};
+        dest.client = static_cast<unsigned char>(client);
+        dest.port = static_cast<unsigned char>(port_id);
+
+        snd_seq_port_subscribe_t* subscription = nullptr;
+        if (snd.seq.port_subscribe_malloc(&subscription) < 0) return false;
+        snd.seq.port_subscribe_set_sender(subscription, &sender);
+        snd.seq.port_subscribe_set_dest(subscription, &dest);
+        if (snd.seq.subscribe_port(seq, subscription) < 0) {
+            snd.seq.port_subscribe_free(subscription);
+            return false;
+        }
+        subscriptions[dest_port] = subscription;
+        return true;
+    }
+
+    void removeDestination(uint64_t dest_port) {
+        const auto it = subscriptions.find(dest_port);
+        if (it == subscriptions.end()) return;
+        snd.seq.unsubscribe_port(seq, it->second);
+        snd.seq.port_subscribe_free(it->second);
+        subscriptions.erase(it);
+    }
+
+    bool empty() const { return subscriptions.empty(); }
+
+    // Concatenated complete messages, written with a single drain
+    bool send(const uint8_t* data, size_t size) {
+        if (size > encoder_size) {
+            if (snd.midi.event_resize_buffer(coder, size) != 0) return false;
+            encoder_size = size;
+        }
+        size_t offset = 0;
+        while (offset < size) {
+            snd_seq_event_t ev;
+            snd_seq_ev_clear(&ev);
+            snd_seq_ev_set_source(&ev, port);
+            snd_seq_ev_set_subs(&ev);
+            snd_seq_ev_set_direct(&ev);
+            const long used = snd.midi.event_encode(
+                coder, data + offset, static_cast<long>(size - offset), &ev);
+            if (used <= 0 || ev.type == SND_SEQ_EVENT_NONE) return false;
+            offset += static_cast<size_t>(used);
+            if (snd.seq.event_output(seq, &ev) < 0) return false;
+        }
+        snd.seq.drain_output(seq);
+        return true;
+    }
+
+private:
+    static constexpr size_t kEncoderSize = 32;
+
+    explicit LrmAlsaFanout(const libremidi::libasound& library) : snd(library) {}
+
+    const libremidi::libasound& snd;
+    snd_seq_t* seq = nullptr;
+    int port = -1;
+    snd_midi_event_t* coder = nullptr;
+    size_t encoder_size = kEncoderSize;
+    std::map<uint64_t, snd_seq_port_subscribe_t*> subscriptions;
+};
+
+#endif // LRM_ALSA_FANOUT_HPP
@@ -0,0 +1,268 @@
+// Renders automation curves into Control Change, pitch bend or NRPN messages
+// from its own thread.
+//
+// A curve is a list of breakpoints with normalised values (0.0 - 1.0); each
+// segment is linear or exponential. While a curve runs, its value is sampled
+// rate_hz times per second on absolute deadlines and sent when the quantised
+// value differs from the last one sent, so flat stretches cost nothing and a
+// 7-bit target never repeats a value. The last breakpoint's value is always
+// reached exactly. Starting a curve on a target (channel and controller,
+// channel pitch bend, or channel and NRPN parameter) that already has one
+// running cancels the old curve.
+//
+// Messages of one update are sent in a single batch, outside the lock.
+
+#ifndef LRM_AUTOMATION_RENDERER_HPP
+#define LRM_AUTOMATION_RENDERER_HPP
+
+#include "libremidi_flutter.h"
+
+#include "lrm_deadline_timer.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class LrmAutomationRenderer {
+public:
+    static constexpr uint32_t kDefaultRateHz = 100;
+    static constexpr uint32_t kMaxRateHz = 2000;
+    static constexpr float kDefaultCurvature = 4.0f;
+
+    // Sends concatenated complete messages
+    using MessageSink = std::function<void(const uint8_t*, size_t)>;
+
+    explicit LrmAutomationRenderer(MessageSink message_sink)
+        : sink(std::move(message_sink)),
+          worker([this] { run(); })
+    {
+    }
+
+    ~LrmAutomationRenderer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        timer.wake();
+        worker.join();
+    }
+
+    static bool valid(const LrmAutomation& settings, const LrmAutomationPoint* points, size_t count) {
+        if (!points || count == 0 || settings.channel > 15 || settings.rate_hz > kMaxRateHz) return false;
+        switch (settings.target) {
+            case LRM_AUTOMATION_CC: if (settings.number > 127) return false; break;
+            case LRM_AUTOMATION_CC14: if (settings.number > 31) return false; break;
+            case LRM_AUTOMATION_PITCH_BEND: break;
+            case LRM_AUTOMATION_NRPN: if (settings.number > 16383) return false; break;
+            default: return false;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (!(points[i].value >= 0.0f && points[i].value <= 1.0f)) return false;
+            if (points[i].shape != LRM_SEGMENT_LINEAR && points[i].shape != LRM_SEGMENT_EXPONENTIAL) return false;
+        }
+        return true;
+    }
+
+    // settings and points must be valid. Returns the curve id (> 0).
+    int64_t start(const LrmAutomation& settings, const LrmAutomationPoint* points, size_t count) {
+        Curve curve;
+        curve.settings = settings;
+        const uint32_t rate = settings.rate_hz ? settings.rate_hz : kDefaultRateHz;
+        curve.period_ns = 1000000000LL / rate;
+        curve.points.reserve(count);
+        int64_t offset = 0;
+        for (size_t i = 0; i < count; i++) {
+            offset += static_cast<int64_t>(points[i].duration_us) * 1000;
+            curve.points.push_back({offset, points[i].value, points[i].shape, points[i].curvature});
+        }
+
+        uint64_t id;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            id = curve.id = ++last_id;
+            curves.remove_if([&](const Curve& other) { return sameTarget(other.settings, settings); });
+            curve.start_ns = LrmDeadlineTimer::now();
+            curves.push_back(std::move(curve));
+        }
+        timer.wake();
+        return static_cast<int64_t>(id);
+    }
+
+    // Stops one curve where it is, or all of them for id 0. Returns whether
+    // a running curve was cancelled.
+    bool cancel(uint64_t id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const size_t before = curves.size();
+        curves.remove_if([id](const Curve& curve) { return id == 0 || curve.id == id; });
+        return curves.size() != before;
+    }
+
+    bool isRunning(uint64_t id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::any_of(curves.begin(), curves.end(), [id](const Curve& curve) { return curve.id == id; });
+    }
+
+    void getStats(LrmAutomationStats* stats) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats->updates = updates;
+        stats->unchanged = unchanged;
+        stats->running = static_cast<uint32_t>(curves.size());
+    }
+
+private:
+    struct Point {
+        int64_t at_ns;  // From the start of the curve
+        float value;
+        int32_t shape;
+        float curvature;
+    };
+
+    struct Curve {
+        uint64_t id = 0;
+        LrmAutomation settings{};
+        std::vector<Point> points;
+        int64_t start_ns = 0;
+        int64_t period_ns = 0;
+        int64_t samples = 0;  // Samples taken; the next is due at start + samples * period
+        int32_t last_sent = -1;
+    };
+
+    static bool sameTarget(const LrmAutomation& a, const LrmAutomation& b) {
+        if (a.channel != b.channel) return false;
+        // A 14-bit CC also owns its 7-bit MSB controller
+        const bool a_cc = a.target == LRM_AUTOMATION_CC || a.target == LRM_AUTOMATION_CC14;
+        const bool b_cc = b.target == LRM_AUTOMATION_CC || b.target == LRM_AUTOMATION_CC14;
+        if (a_cc && b_cc) return a.number == b.number;
+        if (a.target != b.target) return false;
+        return a.target == LRM_AUTOMATION_PITCH_BEND || a.number == b.number;
+    }
+
+    static double shaped(const Point& point, double fraction) {
+        if (point.shape == LRM_SEGMENT_LINEAR) return fraction;
+        const double k = point.curvature != 0.0f ? point.curvature : kDefaultCurvature;
+        return std::expm1(k * fraction) / std::expm1(k);
+    }
+
+    // Value at elapsed, or a negative value before the first point
+    static double valueAt(const Curve& curve, int64_t elapsed) {
+        const auto& points = curve.points;
+        if (elapsed < points.front().at_ns) return -1.0;
+        for (size_t i = 1; i < points.size(); i++) {
+            if (elapsed >= points[i].at_ns) continue;
+            const double span = static_cast<double>(points[i].at_ns - points[i - 1].at_ns);
+            const double fraction = static_cast<double>(elapsed - points[i - 1].at_ns) / span;
+            return points[i - 1].value + (points[i].value - points[i - 1].value) * shaped(points[i], fraction);
+        }
+        return points.back().value;
+    }
+
+    static int32_t maxValue(int32_t target) {
+        return target == LRM_AUTOMATION_CC ? 127 : 16383;
+    }
+
+    // Appends the messages setting the target to value
+    static void encode(const LrmAutomation& settings, int32_t value, int32_t previous, std::vector<uint8_t>& out) {
+        const uint8_t cc = static_cast<uint8_t>(0xB0 | settings.channel);
+        const uint8_t msb = static_cast<uint8_t>(value >> 7);
+        const uint8_t lsb = static_cast<uint8_t>(value & 0x7F);
+        // A 14-bit receiver keeps the MSB when only the LSB is sent
+        const bool msb_changed = previous < 0 || (previous >> 7) != msb;
+        switch (settings.target) {
+            case LRM_AUTOMATION_CC:
+                out.insert(out.end(), {cc, static_cast<uint8_t>(settings.number), static_cast<uint8_t>(value)});
+                break;
+            case LRM_AUTOMATION_CC14:
+                if (msb_changed) out.insert(out.end(), {cc, static_cast<uint8_t>(settings.number), msb});
+                out.insert(out.end(), {cc, static_cast<uint8_t>(settings.number + 32), lsb});
+                break;
+            case LRM_AUTOMATION_PITCH_BEND:
+                out.insert(out.end(), {static_cast<uint8_t>(0xE0 | settings.channel), lsb, msb});
+                break;
+            case LRM_AUTOMATION_NRPN:
+                // The parameter is selected every time, as other traffic on
+                // the channel may select another one in between
+                out.insert(out.end(), {
+                    cc, 99, static_cast<uint8_t>(settings.number >> 7),
+                    cc, 98, static_cast<uint8_t>(settings.number & 0x7F),
+                    cc, 6, msb,
+                    cc, 38, lsb});
+                break;
+        }
+    }
+
+    void run() {
+        std::vector<uint8_t> batch;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            if (curves.empty()) {
+                timer.waitUntil(lock, nullptr);
+                continue;
+            }
+
+            const int64_t now = LrmDeadlineTimer::now();
+            int64_t next_due = INT64_MAX;
+            batch.clear();
+            for (auto it = curves.begin(); it != curves.end();) {
+                Curve& curve = *it;
+                const int64_t due = curve.start_ns + curve.samples * curve.period_ns;
+                if (due > now) {
+                    next_due = std::min(next_due, due);
+                    ++it;
+                    continue;
+                }
+
+                const int64_t elapsed = now - curve.start_ns;
+                const double value = valueAt(curve, elapsed);
+                if (value >= 0.0) {
+                    const int32_t quantised = static_cast<int32_t>(
+                        std::lround(value * maxValue(curve.settings.target)));
+                    if (quantised != curve.last_sent) {
+                        encode(curve.settings, quantised, curve.last_sent, batch);
+                        curve.last_sent = quantised;
+                        updates++;
+                    } else {
+                        unchanged++;
+                    }
+                }
+
+                if (elapsed >= curve.points.back().at_ns) {
+                    it = curves.erase(it);
+                    continue;
+                }
+                // Skip samples missed while late instead of bunching them
+                curve.samples = elapsed / curve.period_ns + 1;
+                next_due = std::min(next_due, curve.start_ns + curve.samples * curve.period_ns);
+                ++it;
+            }
+
+            if (!batch.empty()) {
+                // Curves may have changed meanwhile; look again before sleeping
+                lock.unlock();
+                sink(batch.data(), batch.size());
+                lock.lock();
+                continue;
+            }
+            if (next_due != INT64_MAX) timer.waitUntil(lock, &next_due);
+        }
+    }
+
+    const MessageSink sink;
+
+    std::mutex mutex;
+    LrmDeadlineTimer timer;
+    std::list<Curve> curves;
+    uint64_t last_id = 0;
+    uint64_t updates = 0;
+    uint64_t unchanged = 0;
+    bool stopping = false;
+
+    std::thread worker;  // Last: starts running in the constructor
+};
+
+#endif // LRM_AUTOMATION_RENDERER_HPP
@@ -0,0 +1,224 @@
+// Generates MIDI clock (24 ticks per quarter note) and transport messages.
+//
+// Tick times are computed from an anchor, never by adding intervals, so they
+// do not drift: tick n after the anchor is due at anchor + n * interval, and
+// the thread sleeps until that absolute time on an LrmDeadlineTimer. A tempo
+// or swing change takes effect at the next tick by moving the anchor to it.
+//
+// Swing delays every second sixteenth note: `swing` is the share of an
+// eighth note taken by its first sixteenth (0.5 is straight, 0.66 a triplet
+// feel), applied by stretching the first six ticks of each eighth and
+// compressing the other six.
+//
+// Transport messages are sent on the calling thread, under the same lock as
+// the ticks, so they are never reordered with them.
+
+#ifndef LRM_CLOCK_GENERATOR_HPP
+#define LRM_CLOCK_GENERATOR_HPP
+
+#include "libremidi_flutter.h"
+
+#include "lrm_deadline_timer.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+class LrmClockGenerator {
+public:
+    static constexpr int32_t kTicksPerBeat = 24;
+    static constexpr int32_t kTicksPerSixteenth = 6;
+    static constexpr int32_t kTicksPerEighth = 12;
+    static constexpr double kMinBpm = 1.0;
+    static constexpr double kMaxBpm = 999.0;
+
+    using MessageSink = std::function<void(const uint8_t*, size_t)>;
+
+    LrmClockGenerator(double initial_bpm, MessageSink message_sink)
+        : sink(std::move(message_sink)),
+          bpm(initial_bpm),
+          interval_ns(intervalFor(initial_bpm)),
+          worker([this] { run(); })
+    {
+    }
+
+    ~LrmClockGenerator() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        timer.wake();
+        worker.join();
+    }
+
+    static bool validBpm(double value) { return value >= kMinBpm && value <= kMaxBpm; }
+    static bool validSwing(double value) { return value >= 0.5 && value < 1.0; }
+
+    void setBpm(double value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending_bpm = value;
+    }
+
+    void setSwing(double value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending_swing = value;
+    }
+
+    // Keep ticking while stopped, so followers hold the tempo
+    void setTickWhenStopped(bool enabled) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (enabled && !ticking()) restartTicks(LrmDeadlineTimer::now(), 0);
+            tick_when_stopped = enabled;
+        }
+        timer.wake();
+    }
+
+    // Start: song position 0, first tick right away (or on the running grid)
+    void start() {
+        transport(0xFA, true);
+    }
+
+    // Continue from the current song position
+    void resume() {
+        transport(0xFB, false);
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) return;
+        running = false;
+        const uint8_t message = 0xFC;
+        sink(&message, 1);
+    }
+
+    // Sends Song Position Pointer; only allowed while stopped
+    bool setSongPosition(uint32_t sixteenths) {
+        if (sixteenths > 0x3FFF) return false;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (running) return false;
+        position_ticks = static_cast<int64_t>(sixteenths) * kTicksPerSixteenth;
+        const uint8_t message[3] = {
+            0xF2, static_cast<uint8_t>(sixteenths & 0x7F), static_cast<uint8_t>(sixteenths >> 7)};
+        sink(message, sizeof(message));
+        return true;
+    }
+
+    void getState(LrmClockState* state) {
+        std::lock_guard<std::mutex> lock(mutex);
+        state->bpm = bpm;
+        state->beat_phase = static_cast<double>(position_ticks % kTicksPerBeat) / kTicksPerBeat;
+        state->jitter_us = jitter_us;
+        state->tick_count = tick_count;
+        state->song_position = static_cast<int32_t>(position_ticks / kTicksPerSixteenth);
+        state->running = running;
+    }
+
+private:
+    static double intervalFor(double value) {
+        return 60e9 / (value * kTicksPerBeat);
+    }
+
+    bool ticking() const { return running || tick_when_stopped; }
+
+    // Relative length of the tick at this position within an eighth note
+    double weight(int32_t phase) const {
+        return phase < kTicksPerSixteenth ? 2.0 * swing : 2.0 * (1.0 - swing);
+    }
+
+    // Time of the next tick, counted from the anchor in whole eighths plus
+    // the remaining weighted ticks
+    int64_t nextTickTime() const {
+        double units = static_cast<double>(ticks_since_anchor / kTicksPerEighth) * kTicksPerEighth;
+        for (int64_t i = 0; i < ticks_since_anchor % kTicksPerEighth; i++) {
+            units += weight(static_cast<int32_t>((anchor_phase + i) % kTicksPerEighth));
+        }
+        return anchor_ns + std::llround(units * interval_ns);
+    }
+
+    // The next tick is due at `at`, at this position within an eighth note
+    void restartTicks(int64_t at, int32_t phase) {
+        anchor_ns = at;
+        anchor_phase = phase;
+        ticks_since_anchor = 0;
+    }
+
+    void transport(uint8_t status, bool from_start) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (running) return;
+            if (from_start) position_ticks = 0;
+            // Keep the tick grid followers already lock to, if there is one
+            const int64_t at = ticking() ? nextTickTime() : LrmDeadlineTimer::now();
+            restartTicks(at, static_cast<int32_t>(position_ticks % kTicksPerEighth));
+            running = true;
+            sink(&status, 1);
+        }
+        timer.wake();
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            if (!ticking()) {
+                timer.waitUntil(lock, nullptr);
+                continue;
+            }
+            const int64_t due = nextTickTime();
+            const int64_t now = LrmDeadlineTimer::now();
+            if (due > now) {
+                timer.waitUntil(lock, &due);
+                continue;
+            }
+
+            const uint8_t tick = 0xF8;
+            sink(&tick, 1);
+            tick_count++;
+            jitter_us += (static_cast<double>(now - due) / 1000.0 - jitter_us) * 0.05;
+
+            const int32_t phase = static_cast<int32_t>((anchor_phase + ticks_since_anchor) % kTicksPerEighth);
+            ticks_since_anchor++;
+            if (running) position_ticks++;
+
+            if (pending_bpm != 0.0 || pending_swing != 0.0) {
+                // Re-anchor on the tick just sent; the new values apply from
+                // the interval after it
+                if (pending_bpm != 0.0) {
+                    bpm = pending_bpm;
+                    interval_ns = intervalFor(bpm);
+                }
+                if (pending_swing != 0.0) swing = pending_swing;
+                pending_bpm = 0.0;
+                pending_swing = 0.0;
+                const int64_t next_anchor = due + std::llround(weight(phase) * interval_ns);
+                restartTicks(next_anchor, (phase + 1) % kTicksPerEighth);
+            }
+        }
+    }
+
+    const MessageSink sink;
+
+    std::mutex mutex;
+    LrmDeadlineTimer timer;
+    double bpm;
+    double interval_ns;
+    double swing = 0.5;
+    double pending_bpm = 0.0;    // 0: no change requested
+    double pending_swing = 0.0;
+    bool running = false;
+    bool tick_when_stopped = false;
+    bool stopping = false;
+
+    int64_t anchor_ns = 0;
+    int32_t anchor_phase = 0;
+    int64_t ticks_since_anchor = 0;
+    int64_t position_ticks = 0;  // Ticks since song position 0
+    uint64_t tick_count = 0;
+    double jitter_us = 0.0;      // Smoothed lateness of the ticks
+
+    std::thread worker;  // Last: starts running in the constructor
+};
+
+#endif // LRM_CLOCK_GENERATOR_HPP
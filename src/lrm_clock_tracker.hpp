@@ -0,0 +1,122 @@
+// Follows an incoming MIDI clock (F8 ticks, Start/Continue/Stop and Song
+// Position Pointer) and derives tempo, beat phase and tick jitter.
+//
+// Tick intervals are measured on arrival with the steady clock and smoothed
+// with an exponential moving average; intervals far off the average (a
+// paused or restarted clock source) reset the estimate instead of skewing it.
+// Updated on the backend thread and polled from any thread.
+
+#ifndef LRM_CLOCK_TRACKER_HPP
+#define LRM_CLOCK_TRACKER_HPP
+
+#include "libremidi_flutter.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+
+class LrmClockTracker {
+public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr int32_t kTicksPerBeat = 24;
+    static constexpr int32_t kTicksPerSixteenth = 6;
+
+    // Backend thread. Returns true for clock ticks (F8).
+    bool process(const uint8_t* data, size_t length) {
+        if (length == 0) return false;
+
+        switch (data[0]) {
+            case 0xF8:
+                onTick(clock::now());
+                return true;
+            case 0xFA: {
+                std::lock_guard<std::mutex> lock(mutex);
+                running = true;
+                position_ticks = 0;
+                awaiting_first_tick = true;
+                return false;
+            }
+            case 0xFB: {
+                std::lock_guard<std::mutex> lock(mutex);
+                running = true;
+                return false;
+            }
+            case 0xFC: {
+                std::lock_guard<std::mutex> lock(mutex);
+                running = false;
+                return false;
+            }
+            case 0xF2:
+                if (length >= 3) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    position_ticks = static_cast<int64_t>(data[1] | (data[2] << 7)) * kTicksPerSixteenth;
+                    awaiting_first_tick = true;
+                }
+                return false;
+            default:
+                return false;
+        }
+    }
+
+    void getState(LrmClockState* state) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        state->running = running;
+        state->tick_count = tick_count;
+        state->song_position = static_cast<int32_t>(position_ticks / kTicksPerSixteenth);
+        state->bpm = interval_ns > 0 ? 60e9 / (interval_ns * kTicksPerBeat) : 0.0;
+        state->jitter_us = deviation_ns / 1000.0;
+
+        // Interpolate between ticks so the phase moves smoothly when polled
+        double fraction = 0.0;
+        if (running && !awaiting_first_tick && interval_ns > 0 && tick_count > 0) {
+            const double since = static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - last_tick).count());
+            fraction = std::fmin(since / interval_ns, 1.0);
+        }
+        const double beat_ticks = static_cast<double>(position_ticks % kTicksPerBeat) + fraction;
+        state->beat_phase = std::fmod(beat_ticks / kTicksPerBeat, 1.0);
+    }
+
+private:
+    static constexpr double kSmoothing = 0.08;
+    static constexpr double kResetRatio = 4.0;
+
+    void onTick(clock::time_point now) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tick_count > 0) {
+            const double dt = static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_tick).count());
+            if (interval_ns <= 0 || dt > interval_ns * kResetRatio || dt * kResetRatio < interval_ns) {
+                interval_ns = dt;
+                deviation_ns = 0;
+            } else {
+                deviation_ns += kSmoothing * (std::fabs(dt - interval_ns) - deviation_ns);
+                interval_ns += kSmoothing * (dt - interval_ns);
+            }
+        }
+        last_tick = now;
+        tick_count++;
+
+        // The first tick after Start or a Song Position Pointer plays the
+        // position itself; every later one advances it.
+        if (!running) return;
+        if (awaiting_first_tick) {
+            awaiting_first_tick = false;
+        } else {
+            position_ticks++;
+        }
+    }
+
+    mutable std::mutex mutex;
+    clock::time_point last_tick{};
+    uint64_t tick_count = 0;
+    int64_t position_ticks = 0;
+    double interval_ns = 0;
+    double deviation_ns = 0;
+    bool running = false;
+    bool awaiting_first_tick = false;
+};
+
+#endif // LRM_CLOCK_TRACKER_HPP
@@ -0,0 +1,109 @@
+// Sleeps until an absolute deadline on the lrm_now_ns() clock, or until
+// woken from another thread.
+//
+// On Linux and Android the wait is a poll on an absolute CLOCK_MONOTONIC
+// timerfd, which wakes with microsecond precision and never accumulates
+// drift; an eventfd wakes it early. Elsewhere it waits on a condition
+// variable against the steady clock.
+
+#ifndef LRM_DEADLINE_TIMER_HPP
+#define LRM_DEADLINE_TIMER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+class LrmDeadlineTimer {
+public:
+    using clock = std::chrono::steady_clock;
+
+    LrmDeadlineTimer() {
+#if defined(__linux__)
+        timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (timer_fd < 0 || wake_fd < 0) closeFds();
+#endif
+    }
+
+    ~LrmDeadlineTimer() {
+#if defined(__linux__)
+        closeFds();
+#endif
+    }
+
+    LrmDeadlineTimer(const LrmDeadlineTimer&) = delete;
+    LrmDeadlineTimer& operator=(const LrmDeadlineTimer&) = delete;
+
+    static int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            clock::now().time_since_epoch()).count();
+    }
+
+    // Sleeps until deadline (or indefinitely if null) or until woken. lock
+    // is released while sleeping; callers re-check their state afterwards.
+    void waitUntil(std::unique_lock<std::mutex>& lock, const int64_t* deadline) {
+#if defined(__linux__)
+        if (timer_fd >= 0) {
+            itimerspec spec{};
+            if (deadline) {
+                spec.it_value.tv_sec = static_cast<time_t>(*deadline / 1000000000);
+                spec.it_value.tv_nsec = static_cast<long>(*deadline % 1000000000);
+            }
+            timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr);
+
+            lock.unlock();
+            pollfd fds[2] = {{timer_fd, POLLIN, 0}, {wake_fd, POLLIN, 0}};
+            if (poll(fds, 2, -1) > 0) {
+                uint64_t count;
+                if (fds[0].revents & POLLIN) (void)!read(timer_fd, &count, sizeof(count));
+                if (fds[1].revents & POLLIN) (void)!read(wake_fd, &count, sizeof(count));
+            }
+            lock.lock();
+            return;
+        }
+#endif
+        if (deadline) {
+            cv.wait_until(lock, clock::time_point(std::chrono::duration_cast<clock::duration>(
+                std::chrono::nanoseconds(*deadline))));
+        } else {
+            cv.wait(lock);
+        }
+    }
+
+    // Any thread, after changing the state the waiter checks
+    void wake() {
+#if defined(__linux__)
+        if (wake_fd >= 0) {
+            const uint64_t one = 1;
+            (void)!write(wake_fd, &one, sizeof(one));
+            return;
+        }
+#endif
+        cv.notify_one();
+    }
+
+private:
+#if defined(__linux__)
+    void closeFds() {
+        if (timer_fd >= 0) close(timer_fd);
+        if (wake_fd >= 0) close(wake_fd);
+        timer_fd = -1;
+        wake_fd = -1;
+    }
+
+    int timer_fd = -1;
+    int wake_fd = -1;
+#endif
+
+    std::condition_variable cv;
+};
+
+#endif // LRM_DEADLINE_TIMER_HPP
@@ -0,0 +1,108 @@
+// Native input filter applied to every message before it is delivered.
+//
+// Rejections are counted per criterion with relaxed atomics; the counters are
+// only ever read for reporting, so no ordering with the messages is needed.
+
+#ifndef LRM_INPUT_FILTER_HPP
+#define LRM_INPUT_FILTER_HPP
+
+#include "libremidi_flutter.h"
+
+#include <atomic>
+#include <cstdint>
+
+class LrmInputFilter {
+public:
+    explicit LrmInputFilter(const LrmMidiFilter& settings)
+        : filter(settings)
+    {
+    }
+
+    // Backend thread. Returns false if the message must be dropped.
+    bool accept(const uint8_t* data, size_t length) {
+        if (length == 0) return true;
+
+        if (filter.max_size != 0 && length > filter.max_size) {
+            return reject(rejected_size);
+        }
+
+        const uint8_t status = data[0];
+        if (status < 0x80) return true;
+        if (!(filter.status_mask & kindOf(status))) {
+            return reject(rejected_status);
+        }
+        if (status >= 0xF0) return true;
+
+        if (!(filter.channel_mask & (1u << (status & 0x0F)))) {
+            return reject(rejected_channel);
+        }
+        if (length < 2) return true;
+
+        switch (status & 0xF0) {
+            case 0x80:
+            case 0x90:
+            case 0xA0:
+                if (data[1] < filter.note_min || data[1] > filter.note_max) {
+                    return reject(rejected_note);
+                }
+                break;
+            case 0xB0:
+                if (data[1] < filter.controller_min || data[1] > filter.controller_max) {
+                    return reject(rejected_controller);
+                }
+                break;
+            default:
+                break;
+        }
+        return true;
+    }
+
+    void getStats(LrmMidiFilterStats* stats) const {
+        stats->rejected_status = rejected_status.load(std::memory_order_relaxed);
+        stats->rejected_channel = rejected_channel.load(std::memory_order_relaxed);
+        stats->rejected_note = rejected_note.load(std::memory_order_relaxed);
+        stats->rejected_controller = rejected_controller.load(std::memory_order_relaxed);
+        stats->rejected_size = rejected_size.load(std::memory_order_relaxed);
+    }
+
+    static void initAcceptAll(LrmMidiFilter* settings) {
+        settings->status_mask = LRM_FILTER_ALL;
+        settings->channel_mask = 0xFFFF;
+        settings->note_min = 0;
+        settings->note_max = 127;
+        settings->controller_min = 0;
+        settings->controller_max = 127;
+        settings->max_size = 0;
+    }
+
+    static bool acceptsAll(const LrmMidiFilter& settings) {
+        return (settings.status_mask & LRM_FILTER_ALL) == LRM_FILTER_ALL
+            && settings.channel_mask == 0xFFFF
+            && settings.note_min == 0 && settings.note_max >= 127
+            && settings.controller_min == 0 && settings.controller_max >= 127
+            && settings.max_size == 0;
+    }
+
+private:
+    static uint32_t kindOf(uint8_t status) {
+        if (status < 0xF0) return 1u << (((status >> 4) & 0x07));
+        if (status == 0xF0 || status == 0xF7) return LRM_FILTER_SYSEX;
+        if (status < 0xF8) return LRM_FILTER_SYSTEM_COMMON;
+        return LRM_FILTER_REALTIME;
+    }
+
+    static bool reject(std::atomic<uint64_t>& counter) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const LrmMidiFilter filter;
+
+    std::atomic<uint64_t> rejected_status{0};
+    std::atomic<uint64_t> rejected_channel{0};
+    std::atomic<uint64_t> rejected_note{0};
+    std::atomic<uint64_t> rejected_controller{0};
+    std::atomic<uint64_t> rejected_size{0};
+};
+
+#endif // LRM_INPUT_FILTER_HPP
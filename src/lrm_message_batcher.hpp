@@ -0,0 +1,156 @@
+// Coalesces incoming MIDI messages into packed batches.
+//
+// Messages are appended on the backend thread. A batch is handed to the
+// LrmMidiBatchCallback when it reaches max_messages or max_bytes, or when the
+// window that started with its first message expires. The expiry is driven by
+// a small flush thread so latency stays bounded when traffic is sparse.
+//
+// Ownership of each delivered buffer passes to the callback, which releases
+// it with lrm_midi_batch_free().
+
+#ifndef LRM_MESSAGE_BATCHER_HPP
+#define LRM_MESSAGE_BATCHER_HPP
+
+#include "libremidi_flutter.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+class LrmMessageBatcher {
+public:
+    using clock = std::chrono::steady_clock;
+
+    LrmMessageBatcher(LrmMidiBatchCallback cb, void* ctx,
+                      uint32_t window_us, uint32_t max_msgs, uint32_t max_len)
+        : callback(cb), context(ctx),
+          window(std::chrono::microseconds(window_us ? window_us : kDefaultWindowUs)),
+          max_messages(max_msgs ? max_msgs : kDefaultMaxMessages),
+          max_bytes(max_len ? max_len : kDefaultMaxBytes),
+          flusher([this] { flushLoop(); })
+    {
+    }
+
+    ~LrmMessageBatcher() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_one();
+        flusher.join();
+        // Pending data is discarded: the consumer may already be gone.
+        std::free(data);
+    }
+
+    // Backend thread
+    void push(const uint8_t* bytes, size_t length, int64_t timestamp) {
+        const size_t record = LRM_PACKED_HEADER_SIZE + length;
+        std::unique_lock<std::mutex> lock(mutex);
+
+        if (count > 0 && size + record > max_bytes) {
+            deliverLocked(lock);
+        }
+        if (!reserve(record)) {
+            dropped_count.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        const auto len32 = static_cast<uint32_t>(length);
+        std::memcpy(data + size, &timestamp, sizeof(timestamp));
+        std::memcpy(data + size + sizeof(timestamp), &len32, sizeof(len32));
+        std::memcpy(data + size + LRM_PACKED_HEADER_SIZE, bytes, length);
+        size += record;
+
+        if (++count == 1) {
+            deadline = clock::now() + window;
+            cv.notify_one();
+        }
+        if (count >= max_messages || size >= max_bytes) {
+            deliverLocked(lock);
+        }
+    }
+
+    // Messages discarded because the batch buffer could not grow
+    uint64_t dropped() const {
+        return dropped_count.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint32_t kDefaultWindowUs = 1000;
+    static constexpr uint32_t kDefaultMaxMessages = 256;
+    static constexpr uint32_t kDefaultMaxBytes = 16 * 1024;
+
+    bool reserve(size_t record) {
+        if (size + record <= allocated) return true;
+        size_t wanted = allocated ? allocated : max_bytes;
+        while (wanted < size + record) wanted *= 2;
+        auto grown = static_cast<uint8_t*>(std::realloc(data, wanted));
+        if (!grown) return false;
+        data = grown;
+        allocated = wanted;
+        return true;
+    }
+
+    // Hands the current batch to the callback outside of the lock. Delivery
+    // is serialized so batches from the flush thread and the backend thread
+    // cannot overtake each other.
+    void deliverLocked(std::unique_lock<std::mutex>& lock) {
+        uint8_t* batch = data;
+        const size_t batch_size = size;
+        const int32_t batch_count = static_cast<int32_t>(count);
+        data = nullptr;
+        allocated = 0;
+        size = 0;
+        count = 0;
+        deadline.reset();
+
+        std::unique_lock<std::mutex> ordered(deliver_mutex);
+        lock.unlock();
+        if (callback) {
+            callback(context, batch, batch_size, batch_count);
+        } else {
+            std::free(batch);
+        }
+        ordered.unlock();
+        lock.lock();
+    }
+
+    void flushLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            if (!deadline) {
+                cv.wait(lock);
+            } else if (cv.wait_until(lock, *deadline) == std::cv_status::timeout
+                       && deadline && clock::now() >= *deadline) {
+                deliverLocked(lock);
+            }
+        }
+    }
+
+    const LrmMidiBatchCallback callback;
+    void* const context;
+    const clock::duration window;
+    const uint32_t max_messages;
+    const uint32_t max_bytes;
+
+    std::mutex mutex;
+    std::mutex deliver_mutex;
+    std::condition_variable cv;
+    uint8_t* data = nullptr;
+    size_t allocated = 0;
+    size_t size = 0;
+    uint32_t count = 0;
+    std::optional<clock::time_point> deadline;
+    bool stopping = false;
+    std::atomic<uint64_t> dropped_count{0};
+
+    std::thread flusher;  // Last: starts running in the constructor
+};
+
+#endif // LRM_MESSAGE_BATCHER_HPP
@@ -0,0 +1,144 @@
+// Bounded lock-free ring of timestamped MIDI messages.
+//
+// Single producer (the backend's MIDI thread), single consumer (whoever calls
+// lrm_midi_in_read_batch). Messages are stored as packed records using the
+// same layout that is handed to the consumer, so draining is a plain copy:
+//
+//   int64_t timestamp | uint32_t length | uint8_t data[length]
+//
+// With LRM_OVERFLOW_DROP_OLDEST the producer may advance the read position
+// itself to make room. The consumer therefore copies optimistically and only
+// commits the new read position with a CAS; if the producer dropped records
+// in the meantime the copy is discarded and retried.
+
+#ifndef LRM_MESSAGE_RING_HPP
+#define LRM_MESSAGE_RING_HPP
+
+#include "libremidi_flutter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+class LrmMessageRing {
+public:
+    static constexpr size_t kHeaderSize = LRM_PACKED_HEADER_SIZE;
+    static constexpr size_t kMinCapacity = 256;
+    static constexpr size_t kMaxCapacity = size_t(1) << 26;  // 64 MiB
+
+    LrmMessageRing(size_t capacity, int32_t overflow_policy)
+        : drop_oldest(overflow_policy != LRM_OVERFLOW_DROP_NEWEST)
+    {
+        size_t cap = kMinCapacity;
+        while (cap < capacity && cap < kMaxCapacity) cap <<= 1;
+        storage.resize(cap);
+        mask = cap - 1;
+    }
+
+    size_t capacity() const { return storage.size(); }
+
+    uint64_t dropped() const { return dropped_count.load(std::memory_order_relaxed); }
+
+    // Producer side. Returns false if the message was discarded.
+    bool push(const uint8_t* data, size_t length, int64_t timestamp) {
+        const uint64_t record = kHeaderSize + length;
+        if (record > storage.size()) {
+            dropped_count.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        const uint64_t h = head.load(std::memory_order_relaxed);
+        uint64_t t = tail.load(std::memory_order_acquire);
+        while (h + record - t > storage.size()) {
+            if (!drop_oldest) {
+                dropped_count.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            // Only the producer writes records, so the header at t is ours
+            // to read even while the consumer is copying it.
+            const uint64_t next = t + kHeaderSize + readLength(t);
+            if (tail.compare_exchange_weak(t, next, std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {
+                dropped_count.fetch_add(1, std::memory_order_relaxed);
+                t = next;
+            }
+        }
+
+        const auto len32 = static_cast<uint32_t>(length);
+        write(h, &timestamp, sizeof(timestamp));
+        write(h + sizeof(timestamp), &len32, sizeof(len32));
+        write(h + kHeaderSize, data, length);
+        head.store(h + record, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Copies as many whole records as fit into out and
+    // returns the number of bytes written, 0 if empty, or
+    // LRM_ERR_BUFFER_TOO_SMALL if the next record alone does not fit.
+    int32_t drain(uint8_t* out, size_t out_capacity) {
+        for (;;) {
+            uint64_t t = tail.load(std::memory_order_acquire);
+            const uint64_t h = head.load(std::memory_order_acquire);
+            if (t == h) return 0;
+
+            uint64_t end = t;
+            bool torn = false;
+            while (end < h) {
+                const uint64_t record = kHeaderSize + readLength(end);
+                if (end + record > h) {
+                    // Header was overwritten by a concurrent drop-oldest
+                    torn = true;
+                    break;
+                }
+                if (end + record - t > out_capacity) break;
+                end += record;
+            }
+
+            if (!torn && end == t) {
+                if (tail.load(std::memory_order_acquire) != t) continue;
+                return LRM_ERR_BUFFER_TOO_SMALL;
+            }
+
+            if (!torn) {
+                read(t, out, static_cast<size_t>(end - t));
+                if (tail.compare_exchange_strong(t, end, std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+                    return static_cast<int32_t>(end - t);
+                }
+            }
+        }
+    }
+
+private:
+    uint32_t readLength(uint64_t pos) const {
+        uint32_t len;
+        read(pos + sizeof(int64_t), &len, sizeof(len));
+        return len;
+    }
+
+    void write(uint64_t pos, const void* src, size_t n) {
+        const size_t offset = static_cast<size_t>(pos & mask);
+        const size_t first = std::min(n, storage.size() - offset);
+        std::memcpy(storage.data() + offset, src, first);
+        std::memcpy(storage.data(), static_cast<const uint8_t*>(src) + first, n - first);
+    }
+
+    void read(uint64_t pos, void* dst, size_t n) const {
+        const size_t offset = static_cast<size_t>(pos & mask);
+        const size_t first = std::min(n, storage.size() - offset);
+        std::memcpy(dst, storage.data() + offset, first);
+        std::memcpy(static_cast<uint8_t*>(dst) + first, storage.data(), n - first);
+    }
+
+    std::vector<uint8_t> storage;
+    size_t mask = 0;
+    const bool drop_oldest;
+
+    alignas(64) std::atomic<uint64_t> head{0};  // Written by producer only
+    alignas(64) std::atomic<uint64_t> tail{0};  // Consumer, or producer when dropping oldest
+    alignas(64) std::atomic<uint64_t> dropped_count{0};
+};
+
+#endif // LRM_MESSAGE_RING_HPP
@@ -0,0 +1,86 @@
+// Splits a byte stream of concatenated MIDI 1.0 messages into messages.
+//
+// Used by the output side, where callers hand over several complete messages
+// in one buffer. Every message must start with its status byte (no running
+// status) and SysEx must be terminated with F7 inside the buffer.
+
+#ifndef LRM_MESSAGE_STREAM_HPP
+#define LRM_MESSAGE_STREAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+class LrmMessageStream {
+public:
+    // Length of the message starting at data, or 0 if data does not start
+    // with a status byte, the message is cut off, or a data byte is missing.
+    static size_t messageLength(const uint8_t* data, size_t available) {
+        if (available == 0) return 0;
+        const uint8_t status = data[0];
+
+        if (status == 0xF0) {
+            for (size_t i = 1; i < available; i++) {
+                if (data[i] == 0xF7) return i + 1;
+                if (data[i] & 0x80) return 0;
+            }
+            return 0;
+        }
+
+        const size_t length = lengthOf(status);
+        if (length == 0 || length > available) return 0;
+        for (size_t i = 1; i < length; i++) {
+            if (data[i] & 0x80) return 0;
+        }
+        return length;
+    }
+
+    // Number of messages in data, or 0 unless data is a non-empty sequence of
+    // complete messages
+    static size_t count(const uint8_t* data, size_t length) {
+        size_t messages = 0;
+        for (size_t offset = 0; offset < length; messages++) {
+            const size_t n = messageLength(data + offset, length - offset);
+            if (n == 0) return 0;
+            offset += n;
+        }
+        return messages;
+    }
+
+    // Whether data is a non-empty sequence of complete messages
+    static bool isComplete(const uint8_t* data, size_t length) {
+        return count(data, length) > 0;
+    }
+
+private:
+    static size_t lengthOf(uint8_t status) {
+        if (status < 0x80) return 0;
+        if (status < 0xF0) {
+            switch (status & 0xF0) {
+                case 0xC0:
+                case 0xD0:
+                    return 2;
+                default:
+                    return 3;
+            }
+        }
+        switch (status) {
+            case 0xF1:
+            case 0xF3:
+                return 2;
+            case 0xF2:
+                return 3;
+            case 0xF6:
+            case 0xF8:
+            case 0xFA:
+            case 0xFB:
+            case 0xFC:
+            case 0xFE:
+            case 0xFF:
+                return 1;
+            default:
+                return 0;  // F4, F5, F7, F9, FD are undefined or stray
+        }
+    }
+};
+
+#endif // LRM_MESSAGE_STREAM_HPP
@@ -0,0 +1,1553 @@
+// MIDI input and output ports, shared by every platform build.
+//
+// Included exactly once by each platform's libremidi_flutter.cpp, after it has
+// defined LrmObserver (getInputPort/getOutputPort and their *ById variants)
+// and the two factories that create a backend-specific libremidi object:
+//
+//   std::unique_ptr<libremidi::midi_in>
+//   lrm_create_midi_in(libremidi::input_configuration&&, const libremidi::input_port&);
+//   std::unique_ptr<libremidi::midi_out>
+//   lrm_create_midi_out(const libremidi::output_port&);
+
+#ifndef LRM_MIDI_IO_HPP
+#define LRM_MIDI_IO_HPP
+
+#include "libremidi_flutter.h"
+
+#include "lrm_automation_renderer.hpp"
+#include "lrm_clock_generator.hpp"
+#include "lrm_clock_tracker.hpp"
+#include "lrm_input_filter.hpp"
+#include "lrm_message_batcher.hpp"
+#include "lrm_message_ring.hpp"
+#include "lrm_message_stream.hpp"
+#include "lrm_output_optimizer.hpp"
+#include "lrm_output_queue.hpp"
+#include "lrm_output_scheduler.hpp"
+#include "lrm_parameter_decoder.hpp"
+#include "lrm_route_transform.hpp"
+#include "lrm_stats.hpp"
+#include "lrm_sysex_stream.hpp"
+#include "lrm_sysex_transmitter.hpp"
+#include "lrm_timecode_generator.hpp"
+#include "lrm_timecode_reader.hpp"
+
+#if defined(LIBREMIDI_ALSA)
+#include "lrm_alsa_connection.hpp"
+#include "lrm_alsa_fanout.hpp"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Options collected by the lrm_midi_in_open* entry points
+struct LrmMidiInSetup {
+    LrmMidiCallback callback = nullptr;
+    void* context = nullptr;
+    bool receive_sysex = true;
+    bool receive_timing = false;
+    bool receive_sensing = false;
+    int32_t timestamp_mode = LRM_TIMESTAMP_ABSOLUTE;
+
+    // Ring-buffer delivery (lrm_midi_in_open_ring) instead of the callback
+    bool use_ring = false;
+    size_t ring_capacity = 0;
+    int32_t overflow_policy = LRM_OVERFLOW_DROP_OLDEST;
+
+    // Time-windowed batch delivery (lrm_midi_in_open_batched)
+    LrmMidiBatchCallback batch_callback = nullptr;
+    uint32_t batch_window_us = 0;
+    uint32_t batch_max_messages = 0;
+    uint32_t batch_max_bytes = 0;
+
+    // Native filter (lrm_midi_in_open_filtered)
+    const LrmMidiFilter* filter = nullptr;
+
+    // RPN/NRPN and 14-bit CC decoding (lrm_midi_in_open_decoded)
+    LrmParameterCallback param_callback = nullptr;
+    uint32_t decode_flags = 0;
+    uint32_t cc14_mask = 0;
+
+    // Chunked SysEx streaming (lrm_midi_in_open_sysex_stream)
+    LrmSysexChunkCallback chunk_callback = nullptr;
+    uint32_t chunk_size = 0;
+    uint32_t max_sysex_size = 0;
+    int32_t sysex_overflow_policy = LRM_SYSEX_OVERFLOW_ABORT;
+
+    // Clock tracking (lrm_midi_in_open_clock)
+    bool track_clock = false;
+    bool suppress_clock_ticks = false;
+
+    // MIDI Time Code reading (lrm_midi_in_open_timecode)
+    bool read_timecode = false;
+    bool suppress_quarter_frames = false;
+};
+
+static constexpr size_t kDefaultRingCapacity = 64 * 1024;
+
+struct LrmRoute;
+
+struct LrmMidiIn {
+    std::unique_ptr<libremidi::midi_in> midi_in;
+    libremidi::input_port port_info;
+    LrmMidiCallback callback;
+    void* context;
+    std::unique_ptr<LrmMessageRing> ring;
+    std::unique_ptr<LrmMessageBatcher> batcher;
+    std::unique_ptr<LrmInputFilter> filter;
+    std::unique_ptr<LrmParameterDecoder> decoder;
+    std::unique_ptr<LrmSysexStreamer> sysex_stream;
+    std::unique_ptr<LrmClockTracker> clock_tracker;
+    bool suppress_clock_ticks = false;
+    std::unique_ptr<LrmTimecodeReader> timecode_reader;
+    bool suppress_quarter_frames = false;
+    LrmInputCounters counters;
+    bool monotonic_timestamps = false;
+    int64_t handoff_ns = 0;  // Backend thread: when the current callback was entered
+
+    // Routes fed from this input (lrm_route_create)
+    std::mutex routes_mutex;
+    std::vector<LrmRoute*> routes;
+    std::atomic<bool> routed{false};
+
+    LrmMidiIn(libremidi::input_port port, const LrmMidiInSetup& setup)
+        : port_info(port), callback(setup.callback), context(setup.context) {
+
+        if (setup.use_ring) {
+            ring = std::make_unique<LrmMessageRing>(
+                setup.ring_capacity ? setup.ring_capacity : kDefaultRingCapacity,
+                setup.overflow_policy);
+        } else if (setup.batch_callback) {
+            batcher = std::make_unique<LrmMessageBatcher>(
+                setup.batch_callback, setup.context,
+                setup.batch_window_us, setup.batch_max_messages, setup.batch_max_bytes);
+        }
+        if (setup.filter) {
+            filter = std::make_unique<LrmInputFilter>(*setup.filter);
+        }
+        if (setup.track_clock) {
+            clock_tracker = std::make_unique<LrmClockTracker>();
+            suppress_clock_ticks = setup.suppress_clock_ticks;
+        }
+        if (setup.read_timecode) {
+            timecode_reader = std::make_unique<LrmTimecodeReader>();
+            suppress_quarter_frames = setup.suppress_quarter_frames;
+        }
+        if (setup.param_callback) {
+            decoder = std::make_unique<LrmParameterDecoder>(
+                setup.param_callback, setup.context, setup.decode_flags, setup.cc14_mask);
+        }
+
+        libremidi::input_configuration config;
+        config.ignore_sysex = !setup.receive_sysex;
+        config.ignore_timing = !setup.receive_timing;
+        config.ignore_sensing = !setup.receive_sensing;
+        config.timestamps = timestampsFor(setup.timestamp_mode);
+        monotonic_timestamps = setup.timestamp_mode == LRM_TIMESTAMP_MONOTONIC;
+        if (setup.chunk_callback) {
+            sysex_stream = std::make_unique<LrmSysexStreamer>(
+                setup.chunk_callback, setup.context,
+                setup.chunk_size, setup.max_sysex_size, setup.sysex_overflow_policy,
+                setup.receive_timing, setup.receive_sensing,
+                [this](const uint8_t* data, size_t length, int64_t timestamp) {
+                    handleMessage(data, length, timestamp);
+                });
+            config.ignore_sysex = false;
+        }
+
+        if (sysex_stream && libremidi::is_midi1(port.api)) {
+            // Raw bytes bypass libremidi's SysEx reassembly entirely
+            config.on_raw_data = [this](std::span<const uint8_t> bytes, libremidi::timestamp ts) {
+                handoff_ns = nowNs();
+                sysex_stream->onBytes(bytes.data(), bytes.size(), ts);
+            };
+        } else if (sysex_stream) {
+            // MIDI 2 backends only deliver whole messages through on_message
+            config.on_message = [this](const libremidi::message& msg) {
+                handoff_ns = nowNs();
+                sysex_stream->onBytes(msg.bytes.data(), msg.bytes.size(), msg.timestamp);
+            };
+        } else {
+            config.on_message = [this](const libremidi::message& msg) {
+                handoff_ns = nowNs();
+                handleMessage(msg.bytes.data(), msg.bytes.size(), msg.timestamp);
+            };
+        }
+
+        midi_in = lrm_create_midi_in(std::move(config), port);
+        midi_in->open_port(port);
+    }
+
+    ~LrmMidiIn() {
+        // Stop the backend thread before the pipeline it calls into goes away;
+        // members are otherwise destroyed after the ring, batcher and decoders.
+        midi_in.reset();
+    }
+
+    static libremidi::timestamp_mode timestampsFor(int32_t mode) {
+        switch (mode) {
+            case LRM_TIMESTAMP_MONOTONIC: return libremidi::timestamp_mode::SystemMonotonic;
+            case LRM_TIMESTAMP_RELATIVE: return libremidi::timestamp_mode::Relative;
+            case LRM_TIMESTAMP_NONE: return libremidi::timestamp_mode::NoTimestamp;
+            default: return libremidi::timestamp_mode::Absolute;
+        }
+    }
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Called on the backend thread for every complete message
+    void handleMessage(const uint8_t* data, size_t length, int64_t timestamp) {
+        counters.received(data, length);
+
+        if ((clock_tracker && clock_tracker->process(data, length) && suppress_clock_ticks)
+            || (timecode_reader && timecode_reader->process(data, length) && suppress_quarter_frames)
+            || (filter && !filter->accept(data, length))
+            || (decoder && decoder->process(data, length, timestamp))) {
+            counters.filtered.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            deliver(data, length, timestamp);
+            const int64_t latency = nowNs() - handoffTime(data, length, timestamp);
+            counters.latency.record(static_cast<uint64_t>(std::max<int64_t>(latency, 0)));
+        }
+
+        // After delivery, so a slow routed output does not delay this input
+        if (routed.load(std::memory_order_acquire)) forward(data, length);
+    }
+
+    // When the backend handed the message over. Monotonic timestamps are
+    // taken by the backend itself; a SysEx reassembled by the streamer
+    // carries the time it started instead.
+    int64_t handoffTime(const uint8_t* data, size_t length, int64_t timestamp) const {
+        const bool streamed_sysex = sysex_stream && length > 0 && data[0] == 0xF0;
+        return monotonic_timestamps && !streamed_sysex ? timestamp : handoff_ns;
+    }
+
+    void getStats(LrmMidiInStats* stats) const {
+        stats->messages = counters.messages.load(std::memory_order_relaxed);
+        stats->bytes = counters.bytes.load(std::memory_order_relaxed);
+        stats->sysex_fragments = counters.sysex.load(std::memory_order_relaxed)
+            + (sysex_stream ? sysex_stream->chunks() : 0);
+        stats->dropped = ring ? ring->dropped() : batcher ? batcher->dropped() : 0;
+        stats->filtered = counters.filtered.load(std::memory_order_relaxed);
+        stats->max_latency_ns = counters.latency.max();
+        stats->p99_latency_ns = counters.latency.percentile(0.99);
+    }
+
+    void addRoute(LrmRoute* route) {
+        std::lock_guard<std::mutex> lock(routes_mutex);
+        routes.push_back(route);
+        routed.store(true, std::memory_order_release);
+    }
+
+    // Returns once the backend thread no longer uses the route
+    void removeRoute(LrmRoute* route) {
+        std::lock_guard<std::mutex> lock(routes_mutex);
+        routes.erase(std::remove(routes.begin(), routes.end(), route), routes.end());
+        routed.store(!routes.empty(), std::memory_order_release);
+    }
+
+    // Called on the backend thread; defined after LrmRoute
+    void forward(const uint8_t* data, size_t length);
+
+    // Called on the backend thread for every message that should reach the user
+    void deliver(const uint8_t* data, size_t length, int64_t timestamp) {
+        if (ring) {
+            ring->push(data, length, timestamp);
+        } else if (batcher) {
+            batcher->push(data, length, timestamp);
+        } else if (callback) {
+            callback(context, data, length, timestamp);
+        }
+    }
+};
+
+struct LrmMidiOut {
+    std::unique_ptr<libremidi::midi_out> midi_out;
+    libremidi::output_port port_info;
+    LrmOutputCounters counters;
+    bool sends_streams = false;
+    bool schedules_natively = false;
+    bool sends_sysex_pieces = false;
+    std::mutex send_mutex;
+    int64_t queued_until = 0;  // Latest time handed to the backend's queue
+
+    // Set for asynchronous outputs
+    std::unique_ptr<LrmOutputQueue> writer;
+
+    // Set by lrm_midi_out_set_optimizer; sits in front of the writer.
+    // Routes, clocks and generators send from their own threads, so it is
+    // only read or replaced under optimizer_mutex.
+    std::mutex optimizer_mutex;
+    std::unique_ptr<LrmOutputOptimizer> optimizer;
+
+    // Reused send buffer filled in place by the caller (lrm_midi_out_acquire)
+    std::vector<uint8_t> staging;
+
+    // Created on first use; declared last so their threads stop first
+    std::mutex scheduler_mutex;
+    std::unique_ptr<LrmOutputScheduler> scheduler;
+    std::unique_ptr<LrmSysexTransmitter> sysex_transmitter;
+    std::unique_ptr<LrmTimecodeGenerator> timecode_generator;
+    std::unique_ptr<LrmAutomationRenderer> automation;
+
+    LrmMidiOut(libremidi::output_port port) : port_info(port) {
+        midi_out = lrm_create_midi_out(port);
+        midi_out->open_port(port);
+
+        // The ALSA backends encode any byte stream event by event and drain
+        // once per call; other backends expect one message per call.
+        const auto api = midi_out->get_current_api();
+        sends_streams = api == libremidi::API::ALSA_SEQ || api == libremidi::API::ALSA_RAW;
+        schedules_natively = api == libremidi::API::ALSA_SEQ;
+        // Backends passing a SysEx through in pieces; the others would
+        // reject or reassemble anything but a whole message
+        sends_sysex_pieces = sends_streams || api == libremidi::API::COREMIDI
+            || api == libremidi::API::WINDOWS_MM || api == libremidi::API::WINDOWS_UWP
+            || api == libremidi::API::ANDROID_AMIDI;
+    }
+
+    ~LrmMidiOut() {
+        automation.reset();
+        timecode_generator.reset();
+        sysex_transmitter.reset();
+        optimizer.reset();
+        writer.reset();
+        scheduler.reset();
+        // Closing the port drops whatever the ALSA queue still holds, so let
+        // messages that were already handed over go out first
+        std::lock_guard<std::mutex> lock(send_mutex);
+        const auto remaining = queued_until - std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        if (remaining > 0) std::this_thread::sleep_for(std::chrono::nanoseconds(remaining));
+    }
+
+    // Sends now go through a queue drained by a writer thread
+    void startWriter(uint32_t queue_depth, int32_t backpressure) {
+        writer = std::make_unique<LrmOutputQueue>(
+            queue_depth, backpressure,
+            [this](const uint8_t* bytes, size_t size, bool batch) {
+                return batch ? sendStream(bytes, size, nullptr) > 0 : sendNow(bytes, size) == LRM_OK;
+            });
+    }
+
+    int32_t send(const uint8_t* data, size_t length) {
+        {
+            std::lock_guard<std::mutex> lock(optimizer_mutex);
+            if (optimizer) {
+                if (length == 0 || length > INT32_MAX) return LRM_ERR_INVALID;
+                optimizer->submit(data, length);
+                return LRM_OK;
+            }
+        }
+        return sendDirect(data, length);
+    }
+
+    // Sends concatenated complete messages, in a single backend call where
+    // the backend supports it. Returns the number of messages sent (or queued).
+    int32_t sendBatch(const uint8_t* data, size_t length) {
+        std::unique_lock<std::mutex> lock(optimizer_mutex);
+        if (!writer && !optimizer) {
+            lock.unlock();
+            return sendStream(data, length, nullptr);
+        }
+        if (length > INT32_MAX) return LRM_ERR_INVALID;
+        if (length == 0) return 0;
+        const size_t messages = LrmMessageStream::count(data, length);
+        if (messages == 0) return LRM_ERR_INVALID;
+
+        if (optimizer) {
+            for (size_t offset = 0; offset < length;) {
+                const size_t n = LrmMessageStream::messageLength(data + offset, length - offset);
+                optimizer->submit(data + offset, n);
+                offset += n;
+            }
+            return static_cast<int32_t>(messages);
+        }
+        lock.unlock();
+        const int32_t result = writer->push(data, length, true);
+        return result == LRM_OK ? static_cast<int32_t>(messages) : result;
+    }
+
+    // Replaces the optimizer; the old one then sends what it still holds
+    int32_t setOptimizer(const LrmMidiOptimizer* settings) {
+        std::unique_ptr<LrmOutputOptimizer> replaced;
+        if (settings) {
+            try {
+                replaced = std::make_unique<LrmOutputOptimizer>(
+                    *settings,
+                    [this](const uint8_t* bytes, size_t size) { sendDirect(bytes, size); });
+            } catch (...) {
+                return LRM_ERR_INIT_FAILED;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(optimizer_mutex);
+            optimizer.swap(replaced);
+        }
+        // The old optimizer flushes through sendDirect when it goes out of
+        // scope here, without holding up senders waiting for the lock
+        return LRM_OK;
+    }
+
+    void getOptimizerStats(LrmMidiOptimizerStats* stats) {
+        std::lock_guard<std::mutex> lock(optimizer_mutex);
+        if (optimizer) {
+            optimizer->getStats(stats);
+        } else {
+            *stats = LrmMidiOptimizerStats{};
+        }
+    }
+
+    // Returns the staging buffer, grown to at least size bytes
+    uint8_t* acquire(size_t size) {
+        if (size == 0 || size > INT32_MAX) return nullptr;
+        if (staging.size() < size) {
+            try {
+                staging.resize(size);
+            } catch (...) {
+                return nullptr;
+            }
+        }
+        return staging.data();
+    }
+
+    // Sends the first size bytes of the staging buffer
+    int32_t commit(size_t size, bool batch) {
+        if (size == 0 || size > staging.size()) return LRM_ERR_INVALID;
+        return batch ? sendBatch(staging.data(), size) : send(staging.data(), size);
+    }
+
+    // Queues concatenated complete messages to be sent at timestamp_ns
+    int32_t schedule(int64_t timestamp_ns, const uint8_t* data, size_t length) {
+        if (length > INT32_MAX || !LrmMessageStream::isComplete(data, length)) {
+            return LRM_ERR_INVALID;
+        }
+        std::lock_guard<std::mutex> lock(scheduler_mutex);
+        if (!scheduler) {
+            try {
+                scheduler = std::make_unique<LrmOutputScheduler>(
+                    [this](int64_t at, const uint8_t* bytes, size_t size) {
+                        sendStream(bytes, size, &at);
+                    },
+                    schedules_natively ? kNativeLookaheadNs : 0);
+            } catch (...) {
+                return LRM_ERR_INIT_FAILED;
+            }
+        }
+        scheduler->schedule(timestamp_ns, data, length);
+        return LRM_OK;
+    }
+
+    // Starts a paced transfer of complete SysEx messages, returning its id
+    int64_t sendSysexPaced(const uint8_t* data, size_t length, const LrmSysexPacing& pacing) {
+        if (length == 0 || length > INT32_MAX) return LRM_ERR_INVALID;
+        for (size_t offset = 0; offset < length;) {
+            const size_t n = LrmMessageStream::messageLength(data + offset, length - offset);
+            if (n == 0 || data[offset] != 0xF0) return LRM_ERR_INVALID;
+            offset += n;
+        }
+
+        LrmSysexPacing effective = pacing;
+        if (!sends_sysex_pieces) effective.chunk_size = 0;
+
+        std::lock_guard<std::mutex> lock(scheduler_mutex);
+        if (!sysex_transmitter) {
+            try {
+                sysex_transmitter = std::make_unique<LrmSysexTransmitter>(
+                    [this](const uint8_t* bytes, size_t size, bool last) {
+                        // A message is counted once, with its last piece
+                        const bool ok = transmit(bytes, size, last ? 1 : 0, last ? 1 : 0,
+                                                 nullptr, sends_sysex_pieces);
+                        if (!ok && !last) counters.failures.fetch_add(1, std::memory_order_relaxed);
+                        return ok;
+                    });
+            } catch (...) {
+                return LRM_ERR_INIT_FAILED;
+            }
+        }
+        return sysex_transmitter->start(data, length, effective);
+    }
+
+    LrmSysexTransmitter* existingSysexTransmitter() {
+        std::lock_guard<std::mutex> lock(scheduler_mutex);
+        return sysex_transmitter.get();
+    }
+
+    // Starts (or restarts) MIDI Time Code generation from position
+    int32_t startTimecode(const LrmTimecode& position) {
+        std::lock_guard<std::mutex> lock(scheduler_mutex);
+        if (!timecode_generator) {
+            try {
+                timecode_generator = std::make_unique<LrmTimecodeGenerator>(
+                    [this](const uint8_t* bytes, size_t size) { send(bytes, size); });
+            } catch (...) {
+                return LRM_ERR_INIT_FAILED;
+            }
+        }
+        timecode_generator->start(position);
+        return LRM_OK;
+    }
+
+    LrmTimecodeGenerator* existingTimecodeGenerator() {
+        std::lock_guard<std::mutex> lock(scheduler_mutex);
+        return timecode_generator.get();
+    }
+
+    int64_t automate(const LrmAutomation& settings, const LrmAutomationPoint* points, size_t count) {
+        std::lock_guard<std::mutex> lock(scheduler_mutex);
+        if (!automation) {
+            try {
+                automation = std::make_unique<LrmAutomationRenderer>(
+                    [this](const uint8_t* bytes, size_t size) { sendBatch(bytes, size); });
+            } catch (...) {
+                return LRM_ERR_INIT_FAILED;
+            }
+        }
+        return automation->start(settings, points, count);
+    }
+
+    LrmAutomationRenderer* existingAutomation() {
+        std::lock_guard<std::mutex> lock(scheduler_mutex);
+        return automation.get();
+    }
+
+    LrmOutputScheduler* existingScheduler() {
+        std::lock_guard<std::mutex> lock(scheduler_mutex);
+        return scheduler.get();
+    }
+
+    void getStats(LrmMidiOutStats* stats) const {
+        stats->messages = counters.messages.load(std::memory_order_relaxed);
+        stats->bytes = counters.bytes.load(std::memory_order_relaxed);
+        stats->sysex_messages = counters.sysex.load(std::memory_order_relaxed);
+        stats->send_failures = counters.failures.load(std::memory_order_relaxed);
+        stats->send_time_ns = counters.send_time_ns.load(std::memory_order_relaxed);
+        stats->max_send_ns = counters.send_latency.max();
+        stats->p99_send_ns = counters.send_latency.percentile(0.99);
+        stats->queue_pending = writer ? writer->pending() : 0;
+        stats->queue_completed = writer ? writer->completed() : 0;
+        stats->queue_failed = writer ? writer->failed() : 0;
+        stats->queue_overflows = writer ? writer->overflows() : 0;
+    }
+
+private:
+    // How early the scheduler hands messages to the ALSA sequencer queue,
+    // which then delivers them on time in the kernel
+    static constexpr int64_t kNativeLookaheadNs = 10'000'000;
+
+    // One message, past the optimizer
+    int32_t sendDirect(const uint8_t* data, size_t length) {
+        if (writer) return writer->push(data, length, false);
+        return sendNow(data, length);
+    }
+
+    int32_t sendNow(const uint8_t* data, size_t length) {
+        const bool sysex = length > 0 && data[0] == 0xF0;
+        return transmit(data, length, 1, sysex ? 1 : 0) ? LRM_OK : LRM_ERR_SEND_FAILED;
+    }
+
+    // `at` is set for messages coming from the scheduler: their due time, or
+    // 0 to send them as soon as what is already queued has gone out.
+    int32_t sendStream(const uint8_t* data, size_t length, const int64_t* at) {
+        if (length > INT32_MAX) return LRM_ERR_INVALID;
+
+        uint32_t messages = 0;
+        uint32_t sysex = 0;
+        for (size_t offset = 0; offset < length;) {
+            const size_t n = LrmMessageStream::messageLength(data + offset, length - offset);
+            if (n == 0) return LRM_ERR_INVALID;
+            if (data[offset] == 0xF0) sysex++;
+            offset += n;
+            messages++;
+        }
+        if (messages == 0) return 0;
+
+        if (sends_streams) {
+            return transmit(data, length, messages, sysex, at)
+                ? static_cast<int32_t>(messages) : LRM_ERR_SEND_FAILED;
+        }
+
+        int32_t sent = 0;
+        for (size_t offset = 0; offset < length; sent++) {
+            const size_t n = LrmMessageStream::messageLength(data + offset, length - offset);
+            if (!transmit(data + offset, n, 1, data[offset] == 0xF0 ? 1 : 0)) break;
+            offset += n;
+        }
+        return sent > 0 ? sent : LRM_ERR_SEND_FAILED;
+    }
+
+    // One backend call, accounting for time spent and failures
+    // sysex_piece: data is one piece of a SysEx sent by the transmitter
+    bool transmit(const uint8_t* data, size_t length, uint32_t messages, uint32_t sysex,
+                  const int64_t* at = nullptr, bool sysex_piece = false) {
+        std::lock_guard<std::mutex> lock(send_mutex);
+        const auto start = std::chrono::steady_clock::now();
+        bool ok = false;
+        try {
+            if (at && schedules_natively) {
+                // Never ahead of what is already queued, so flushed messages
+                // keep their order
+                const int64_t due = std::max(*at, queued_until);
+                ok = midi_out->schedule_message(due, data, length) == stdx::error{};
+                if (ok) queued_until = due;
+            } else if (sysex_piece) {
+                ok = midi_out->send_sysex_piece(data, length) == stdx::error{};
+            } else {
+                ok = midi_out->send_message(data, length) == stdx::error{};
+            }
+        } catch (...) {
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        counters.sent(messages, sysex, length, static_cast<uint64_t>(elapsed), ok);
+        return ok;
+    }
+};
+
+// Forwards one input's messages to an output, or holds the kernel connection
+// doing it
+struct LrmRoute {
+    LrmMidiIn* midi_in;
+    LrmMidiOut* midi_out;
+    LrmRouteTransformer transformer;
+#if defined(LIBREMIDI_ALSA)
+    std::unique_ptr<LrmAlsaConnection> connection;
+#endif
+    std::atomic<uint64_t> forwarded{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> send_failures{0};
+
+    LrmRoute(LrmMidiIn* in, LrmMidiOut* out, const LrmRouteTransform& transform)
+        : midi_in(in), midi_out(out), transformer(transform)
+    {
+#if defined(LIBREMIDI_ALSA)
+        if (LrmRouteTransformer::isIdentity(transform)
+            && in->midi_in->get_current_api() == libremidi::API::ALSA_SEQ
+            && out->midi_out->get_current_api() == libremidi::API::ALSA_SEQ) {
+            connection = LrmAlsaConnection::create(in->port_info.port, out->port_info.port);
+        }
+#endif
+        if (!isNative()) midi_in->addRoute(this);
+    }
+
+    ~LrmRoute() {
+        if (!isNative()) midi_in->removeRoute(this);
+    }
+
+    bool isNative() const {
+#if defined(LIBREMIDI_ALSA)
+        return connection != nullptr;
+#else
+        return false;
+#endif
+    }
+
+    // Input backend thread
+    void forward(const uint8_t* data, size_t length) {
+        uint8_t scratch[3];
+        const uint8_t* message = transformer.apply(data, length, scratch);
+        if (!message) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (midi_out->send(message, length) == LRM_OK) {
+            forwarded.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            send_failures.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void getStats(LrmRouteStats* stats) const {
+        stats->forwarded = forwarded.load(std::memory_order_relaxed);
+        stats->dropped = dropped.load(std::memory_order_relaxed);
+        stats->send_failures = send_failures.load(std::memory_order_relaxed);
+    }
+};
+
+inline void LrmMidiIn::forward(const uint8_t* data, size_t length) {
+    std::lock_guard<std::mutex> lock(routes_mutex);
+    for (auto* route : routes) route->forward(data, length);
+}
+
+// Clock generator and the outputs it drives
+struct LrmClock {
+    std::mutex outputs_mutex;
+    std::vector<LrmMidiOut*> outputs;
+    LrmClockGenerator generator;  // Last: its thread sends to outputs
+
+    explicit LrmClock(double bpm)
+        : generator(bpm, [this](const uint8_t* data, size_t length) {
+              std::lock_guard<std::mutex> lock(outputs_mutex);
+              for (auto* out : outputs) out->send(data, length);
+          })
+    {
+    }
+
+    bool addOutput(LrmMidiOut* out) {
+        std::lock_guard<std::mutex> lock(outputs_mutex);
+        if (std::find(outputs.begin(), outputs.end(), out) != outputs.end()) return false;
+        outputs.push_back(out);
+        return true;
+    }
+
+    // Returns once the clock thread no longer uses the output
+    bool removeOutput(LrmMidiOut* out) {
+        std::lock_guard<std::mutex> lock(outputs_mutex);
+        const auto it = std::find(outputs.begin(), outputs.end(), out);
+        if (it == outputs.end()) return false;
+        outputs.erase(it);
+        return true;
+    }
+};
+
+// Outputs sent the same messages by a single call
+struct LrmMidiOutGroup {
+    struct Member {
+        LrmMidiOut* out;
+        int8_t channel_map[16];
+        bool remaps;
+        bool fanned_out;  // Delivered by the kernel from the group's own port
+    };
+
+    std::mutex mutex;
+    std::vector<Member> members;
+    std::vector<uint8_t> remapped;  // Reused per remapping member
+    const bool kernel_fanout;
+#if defined(LIBREMIDI_ALSA)
+    std::unique_ptr<LrmAlsaFanout> fanout;
+#endif
+
+    explicit LrmMidiOutGroup(bool use_kernel_fanout) : kernel_fanout(use_kernel_fanout) {}
+
+    int32_t add(LrmMidiOut* out, const int8_t* channel_map) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& member : members) {
+            if (member.out == out) return LRM_ERR_INVALID;
+        }
+
+        Member member{out, {}, false, false};
+        for (int8_t channel = 0; channel < 16; channel++) {
+            member.channel_map[channel] = channel_map ? channel_map[channel] : channel;
+            if (member.channel_map[channel] > 15) member.channel_map[channel] = -1;
+            if (member.channel_map[channel] != channel) member.remaps = true;
+        }
+#if defined(LIBREMIDI_ALSA)
+        if (kernel_fanout && !member.remaps
+            && out->midi_out->get_current_api() == libremidi::API::ALSA_SEQ) {
+            if (!fanout) fanout = LrmAlsaFanout::create();
+            member.fanned_out = fanout && fanout->addDestination(out->port_info.port);
+        }
+#endif
+        members.push_back(member);
+        return LRM_OK;
+    }
+
+    int32_t remove(LrmMidiOut* out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = std::find_if(members.begin(), members.end(),
+                                     [out](const Member& member) { return member.out == out; });
+        if (it == members.end()) return LRM_ERR_NOT_FOUND;
+#if defined(LIBREMIDI_ALSA)
+        if (it->fanned_out) fanout->removeDestination(out->port_info.port);
+#endif
+        members.erase(it);
+        return LRM_OK;
+    }
+
+    int32_t kernelFanoutCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return static_cast<int32_t>(std::count_if(members.begin(), members.end(),
+                                                  [](const Member& member) { return member.fanned_out; }));
+    }
+
+    // Concatenated complete messages. Returns the number of members that
+    // accepted them.
+    int32_t send(const uint8_t* data, size_t length) {
+        if (length == 0 || length > INT32_MAX || !LrmMessageStream::isComplete(data, length)) {
+            return LRM_ERR_INVALID;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        int32_t accepted = 0;
+        int32_t fanned_out = 0;
+        for (const auto& member : members) {
+            if (member.fanned_out) {
+                fanned_out++;
+                continue;
+            }
+            if (!member.remaps) {
+                if (member.out->sendBatch(data, length) > 0) accepted++;
+                continue;
+            }
+            const size_t size = remap(member, data, length);
+            if (size == 0 || member.out->sendBatch(remapped.data(), size) > 0) accepted++;
+        }
+#if defined(LIBREMIDI_ALSA)
+        if (fanned_out > 0 && fanout->send(data, length)) accepted += fanned_out;
+#endif
+        return accepted;
+    }
+
+private:
+    // Copies data into remapped with the member's channels; messages on a
+    // dropped channel are left out. Returns the size of the copy.
+    size_t remap(const Member& member, const uint8_t* data, size_t length) {
+        remapped.resize(length);
+        size_t size = 0;
+        for (size_t offset = 0; offset < length;) {
+            const size_t n = LrmMessageStream::messageLength(data + offset, length - offset);
+            const uint8_t status = data[offset];
+            if (status >= 0xF0) {
+                std::memcpy(remapped.data() + size, data + offset, n);
+                size += n;
+            } else if (const int8_t channel = member.channel_map[status & 0x0F]; channel >= 0) {
+                std::memcpy(remapped.data() + size, data + offset, n);
+                remapped[size] = static_cast<uint8_t>((status & 0xF0) | channel);
+                size += n;
+            }
+            offset += n;
+        }
+        return size;
+    }
+};
+
+// =============================================================================
+// Timestamps
+// =============================================================================
+
+// libremidi stamps LRM_TIMESTAMP_MONOTONIC inputs with steady_clock on every
+// backend (CLOCK_MONOTONIC on Linux and Android, CLOCK_UPTIME_RAW on Apple)
+extern "C" FFI_PLUGIN_EXPORT int64_t lrm_now_ns(void) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// =============================================================================
+// MIDI Output API
+// =============================================================================
+
+extern "C" FFI_PLUGIN_EXPORT LrmMidiOut* lrm_midi_out_open(LrmObserver* observer, int32_t port_index) {
+    if (!observer) return nullptr;
+    if (port_index < 0) return nullptr;
+
+    libremidi::output_port port;
+    if (!observer->getOutputPort(static_cast<size_t>(port_index), port)) {
+        return nullptr;
+    }
+
+    try {
+        return new LrmMidiOut(port);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+extern "C" FFI_PLUGIN_EXPORT LrmMidiOut* lrm_midi_out_open_by_id(LrmObserver* observer, uint64_t port_id) {
+    if (!observer) return nullptr;
+
+    libremidi::output_port port;
+    if (!observer->getOutputPortById(port_id, port)) {
+        return nullptr;
+    }
+
+    try {
+        return new LrmMidiOut(port);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+extern "C" FFI_PLUGIN_EXPORT LrmMidiOut* lrm_midi_out_open_async(
+    LrmObserver* observer,
+    uint64_t port_id,
+    uint32_t queue_depth,
+    int32_t backpressure
+) {
+    if (!observer) return nullptr;
+    if (backpressure < LRM_BACKPRESSURE_BLOCK || backpressure > LRM_BACKPRESSURE_FAIL) return nullptr;
+
+    libremidi::output_port port;
+    if (!observer->getOutputPortById(port_id, port)) {
+        return nullptr;
+    }
+
+    try {
+        auto midi_out = std::make_unique<LrmMidiOut>(port);
+        midi_out->startWriter(queue_depth, backpressure);
+        return midi_out.release();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+extern "C" FFI_PLUGIN_EXPORT void lrm_midi_out_close(LrmMidiOut* midi_out) {
+    delete midi_out;
+}
+
+extern "C" FFI_PLUGIN_EXPORT bool lrm_midi_out_is_connected(LrmMidiOut* midi_out) {
+    if (!midi_out || !midi_out->midi_out) return false;
+    return midi_out->midi_out->is_port_connected();
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_send(LrmMidiOut* midi_out, const uint8_t* data, size_t length) {
+    if (!midi_out || !midi_out->midi_out || !data) return LRM_ERR_INVALID;
+
+    return midi_out->send(data, length);
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_send_batch(LrmMidiOut* midi_out, const uint8_t* data, size_t length) {
+    if (!midi_out || !midi_out->midi_out || !data) return LRM_ERR_INVALID;
+
+    return midi_out->sendBatch(data, length);
+}
+
+extern "C" FFI_PLUGIN_EXPORT uint8_t* lrm_midi_out_acquire(LrmMidiOut* midi_out, size_t size) {
+    if (!midi_out || !midi_out->midi_out) return nullptr;
+    return midi_out->acquire(size);
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_commit(LrmMidiOut* midi_out, size_t size) {
+    if (!midi_out || !midi_out->midi_out) return LRM_ERR_INVALID;
+    return midi_out->commit(size, false);
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_commit_batch(LrmMidiOut* midi_out, size_t size) {
+    if (!midi_out || !midi_out->midi_out) return LRM_ERR_INVALID;
+    return midi_out->commit(size, true);
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_schedule(
+    LrmMidiOut* midi_out,
+    int64_t timestamp_ns,
+    const uint8_t* data,
+    size_t length
+) {
+    if (!midi_out || !midi_out->midi_out || !data) return LRM_ERR_INVALID;
+
+    return midi_out->schedule(timestamp_ns, data, length);
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_cancel_scheduled(LrmMidiOut* midi_out) {
+    if (!midi_out) return LRM_ERR_INVALID;
+    auto scheduler = midi_out->existingScheduler();
+    if (!scheduler) return 0;
+    return static_cast<int32_t>(std::min<size_t>(scheduler->cancelAll(), INT32_MAX));
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_flush_scheduled(LrmMidiOut* midi_out) {
+    if (!midi_out) return LRM_ERR_INVALID;
+    auto scheduler = midi_out->existingScheduler();
+    if (!scheduler) return 0;
+    return static_cast<int32_t>(std::min<size_t>(scheduler->flush(), INT32_MAX));
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_get_scheduled_count(LrmMidiOut* midi_out) {
+    if (!midi_out) return LRM_ERR_INVALID;
+    auto scheduler = midi_out->existingScheduler();
+    if (!scheduler) return 0;
+    return static_cast<int32_t>(std::min<size_t>(scheduler->pending(), INT32_MAX));
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_get_stats(LrmMidiOut* midi_out, LrmMidiOutStats* stats) {
+    if (!midi_out || !stats) return LRM_ERR_INVALID;
+    midi_out->getStats(stats);
+    return LRM_OK;
+}
+
+extern "C" FFI_PLUGIN_EXPORT int64_t lrm_midi_out_send_sysex_paced(
+    LrmMidiOut* midi_out,
+    const uint8_t* data,
+    size_t length,
+    const LrmSysexPacing* pacing
+) {
+    if (!midi_out || !data || !pacing) return LRM_ERR_INVALID;
+    return midi_out->sendSysexPaced(data, length, *pacing);
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_get_sysex_transfer(
+    LrmMidiOut* midi_out,
+    int64_t transfer_id,
+    LrmSysexTransferStatus* status
+) {
+    if (!midi_out || !status || transfer_id <= 0) return LRM_ERR_INVALID;
+    auto transmitter = midi_out->existingSysexTransmitter();
+    if (!transmitter) return LRM_ERR_NOT_FOUND;
+    return transmitter->getStatus(static_cast<uint64_t>(transfer_id), status);
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_cancel_sysex(LrmMidiOut* midi_out, int64_t transfer_id) {
+    if (!midi_out || transfer_id < 0) return LRM_ERR_INVALID;
+    auto transmitter = midi_out->existingSysexTransmitter();
+    if (!transmitter) return LRM_ERR_NOT_FOUND;
+    return transmitter->cancel(static_cast<uint64_t>(transfer_id));
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_set_optimizer(LrmMidiOut* midi_out, const LrmMidiOptimizer* settings) {
+    if (!midi_out) return LRM_ERR_INVALID;
+    return midi_out->setOptimizer(settings);
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_get_optimizer_stats(LrmMidiOut* midi_out, LrmMidiOptimizerStats* stats) {
+    if (!midi_out || !stats) return LRM_ERR_INVALID;
+    midi_out->getOptimizerStats(stats);
+    return LRM_OK;
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_start_timecode(LrmMidiOut* midi_out, const LrmTimecode* position) {
+    if (!midi_out || !position || !LrmTimecodeFormat::valid(*position)) return LRM_ERR_INVALID;
+    return midi_out->startTimecode(*position);
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_stop_timecode(LrmMidiOut* midi_out) {
+    if (!midi_out) return LRM_ERR_INVALID;
+    auto generator = midi_out->existingTimecodeGenerator();
+    if (generator) generator->stop();
+    return LRM_OK;
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_get_timecode(LrmMidiOut* midi_out, LrmTimecode* position) {
+    if (!midi_out || !position) return LRM_ERR_INVALID;
+    auto generator = midi_out->existingTimecodeGenerator();
+    if (!generator) return LRM_ERR_INVALID;
+    generator->getState(position);
+    return LRM_OK;
+}
+
+extern "C" FFI_PLUGIN_EXPORT int64_t lrm_midi_out_automate(
+    LrmMidiOut* midi_out,
+    const LrmAutomation* settings,
+    const LrmAutomationPoint* points,
+    size_t count
+) {
+    if (!midi_out || !settings || !LrmAutomationRenderer::valid(*settings, points, count)) {
+        return LRM_ERR_INVALID;
+    }
+    try {
+        return midi_out->automate(*settings, points, count);
+    } catch (...) {
+        return LRM_ERR_INIT_FAILED;
+    }
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_cancel_automation(LrmMidiOut* midi_out, int64_t curve_id) {
+    if (!midi_out || curve_id < 0) return LRM_ERR_INVALID;
+    auto automation = midi_out->existingAutomation();
+    if (!automation || !automation->cancel(static_cast<uint64_t>(curve_id))) return LRM_ERR_NOT_FOUND;
+    return LRM_OK;
+}
+
+extern "C" FFI_PLUGIN_EXPORT bool lrm_midi_out_is_automating(LrmMidiOut* midi_out, int64_t curve_id) {
+    if (!midi_out || curve_id <= 0) return false;
+    auto automation = midi_out->existingAutomation();
+    return automation && automation->isRunning(static_cast<uint64_t>(curve_id));
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_get_automation_stats(LrmMidiOut* midi_out, LrmAutomationStats* stats) {
+    if (!midi_out || !stats) return LRM_ERR_INVALID;
+    auto automation = midi_out->existingAutomation();
+    if (automation) {
+        automation->getStats(stats);
+    } else {
+        *stats = LrmAutomationStats{};
+    }
+    return LRM_OK;
+}
+
+// =============================================================================
+// MIDI Input API
+// =============================================================================
+
+static LrmMidiInSetup make_callback_setup(
+    LrmMidiCallback callback,
+    void* context,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing
+) {
+    LrmMidiInSetup setup;
+    setup.callback = callback;
+    setup.context = context;
+    setup.receive_sysex = receive_sysex;
+    setup.receive_timing = receive_timing;
+    setup.receive_sensing = receive_sensing;
+    return setup;
+}
+
+static LrmMidiIn* open_midi_in_by_id(LrmObserver* observer, uint64_t port_id, const LrmMidiInSetup& setup) {
+    if (!observer) return nullptr;
+    if (setup.timestamp_mode < LRM_TIMESTAMP_ABSOLUTE || setup.timestamp_mode > LRM_TIMESTAMP_NONE) {
+        return nullptr;
+    }
+
+    libremidi::input_port port;
+    if (!observer->getInputPortById(port_id, port)) {
+        return nullptr;
+    }
+
+    try {
+        return new LrmMidiIn(port, setup);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+extern "C" FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open(
+    LrmObserver* observer,
+    int32_t port_index,
+    LrmMidiCallback callback,
+    void* context,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing
+) {
+    if (!observer) return nullptr;
+    if (port_index < 0) return nullptr;
+
+    libremidi::input_port port;
+    if (!observer->getInputPort(static_cast<size_t>(port_index), port)) {
+        return nullptr;
+    }
+
+    try {
+        return new LrmMidiIn(port, make_callback_setup(callback, context,
+                            receive_sysex, receive_timing, receive_sensing));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+extern "C" FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_by_id(
+    LrmObserver* observer,
+    uint64_t port_id,
+    LrmMidiCallback callback,
+    void* context,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing
+) {
+    return open_midi_in_by_id(observer, port_id, make_callback_setup(callback, context,
+                              receive_sysex, receive_timing, receive_sensing));
+}
+
+extern "C" FFI_PLUGIN_EXPORT void lrm_midi_in_close(LrmMidiIn* midi_in) {
+    delete midi_in;
+}
+
+extern "C" FFI_PLUGIN_EXPORT bool lrm_midi_in_is_connected(LrmMidiIn* midi_in) {
+    if (!midi_in || !midi_in->midi_in) return false;
+    return midi_in->midi_in->is_port_connected();
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_in_get_stats(LrmMidiIn* midi_in, LrmMidiInStats* stats) {
+    if (!midi_in || !stats) return LRM_ERR_INVALID;
+    midi_in->getStats(stats);
+    return LRM_OK;
+}
+
+extern "C" FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_timestamped(
+    LrmObserver* observer,
+    uint64_t port_id,
+    LrmMidiCallback callback,
+    void* context,
+    int32_t timestamp_mode,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing
+) {
+    LrmMidiInSetup setup = make_callback_setup(callback, context,
+                                               receive_sysex, receive_timing, receive_sensing);
+    setup.timestamp_mode = timestamp_mode;
+    return open_midi_in_by_id(observer, port_id, setup);
+}
+
+// =============================================================================
+// Buffered input API
+// =============================================================================
+
+extern "C" FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_ring(
+    LrmObserver* observer,
+    uint64_t port_id,
+    size_t capacity,
+    int32_t overflow_policy,
+    int32_t timestamp_mode,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing
+) {
+    if (overflow_policy != LRM_OVERFLOW_DROP_OLDEST &&
+        overflow_policy != LRM_OVERFLOW_DROP_NEWEST) {
+        return nullptr;
+    }
+
+    LrmMidiInSetup setup = make_callback_setup(nullptr, nullptr,
+                                               receive_sysex, receive_timing, receive_sensing);
+    setup.use_ring = true;
+    setup.ring_capacity = capacity;
+    setup.overflow_policy = overflow_policy;
+    setup.timestamp_mode = timestamp_mode;
+    return open_midi_in_by_id(observer, port_id, setup);
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_in_read_batch(LrmMidiIn* midi_in, uint8_t* buf, size_t capacity) {
+    if (!midi_in || !midi_in->ring || !buf) return LRM_ERR_INVALID;
+    return midi_in->ring->drain(buf, std::min<size_t>(capacity, INT32_MAX));
+}
+
+extern "C" FFI_PLUGIN_EXPORT size_t lrm_midi_in_get_ring_capacity(LrmMidiIn* midi_in) {
+    if (!midi_in || !midi_in->ring) return 0;
+    return midi_in->ring->capacity();
+}
+
+extern "C" FFI_PLUGIN_EXPORT uint64_t lrm_midi_in_get_dropped_count(LrmMidiIn* midi_in) {
+    if (!midi_in) return 0;
+    if (midi_in->batcher) return midi_in->batcher->dropped();
+    return midi_in->ring ? midi_in->ring->dropped() : 0;
+}
+
+extern "C" FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_batched(
+    LrmObserver* observer,
+    uint64_t port_id,
+    LrmMidiBatchCallback callback,
+    void* context,
+    uint32_t window_us,
+    uint32_t max_messages,
+    uint32_t max_bytes,
+    int32_t timestamp_mode,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing
+) {
+    if (!callback) return nullptr;
+
+    LrmMidiInSetup setup = make_callback_setup(nullptr, context,
+                                               receive_sysex, receive_timing, receive_sensing);
+    setup.batch_callback = callback;
+    setup.batch_window_us = window_us;
+    setup.batch_max_messages = max_messages;
+    setup.batch_max_bytes = max_bytes;
+    setup.timestamp_mode = timestamp_mode;
+    return open_midi_in_by_id(observer, port_id, setup);
+}
+
+extern "C" FFI_PLUGIN_EXPORT void lrm_midi_batch_free(uint8_t* data) {
+    std::free(data);
+}
+
+extern "C" FFI_PLUGIN_EXPORT void lrm_midi_filter_init(LrmMidiFilter* filter) {
+    if (!filter) return;
+    LrmInputFilter::initAcceptAll(filter);
+}
+
+extern "C" FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_filtered(
+    LrmObserver* observer,
+    uint64_t port_id,
+    LrmMidiCallback callback,
+    void* context,
+    const LrmMidiFilter* filter,
+    int32_t timestamp_mode,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing
+) {
+    if (!filter) return nullptr;
+
+    LrmMidiInSetup setup = make_callback_setup(callback, context,
+                                               receive_sysex, receive_timing, receive_sensing);
+    setup.filter = filter;
+    setup.timestamp_mode = timestamp_mode;
+    return open_midi_in_by_id(observer, port_id, setup);
+}
+
+extern "C" FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_decoded(
+    LrmObserver* observer,
+    uint64_t port_id,
+    LrmMidiCallback callback,
+    LrmParameterCallback param_callback,
+    void* context,
+    const LrmMidiFilter* filter,
+    uint32_t decode_flags,
+    uint32_t cc14_mask,
+    int32_t timestamp_mode,
+    bool receive_sysex,
+    bool receive_timing,
+    bool receive_sensing
+) {
+    if (!param_callback) return nullptr;
+
+    LrmMidiInSetup setup = make_callback_setup(callback, context,
+                                               receive_sysex, receive_timing, receive_sensing);
+    setup.filter = filter;
+    setup.param_callback = param_callback;
+    setup.decode_flags = decode_flags;
+    setup.cc14_mask = cc14_mask;
+    setup.timestamp_mode = timestamp_mode;
+    return open_midi_in_by_id(observer, port_id, setup);
+}
+
+extern "C" FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_sysex_stream(
+    LrmObserver* observer,
+    uint64_t port_id,
+    LrmMidiCallback callback,
+    LrmSysexChunkCallback chunk_callback,
+    void* context,
+    uint32_t chunk_size,
+    uint32_t max_sysex_size,
+    int32_t overflow_policy,
+    int32_t timestamp_mode,
+    bool receive_timing,
+    bool receive_sensing
+) {
+    if (!chunk_callback) return nullptr;
+    if (overflow_policy != LRM_SYSEX_OVERFLOW_ABORT &&
+        overflow_policy != LRM_SYSEX_OVERFLOW_TRUNCATE) {
+        return nullptr;
+    }
+
+    LrmMidiInSetup setup = make_callback_setup(callback, context,
+                                               true, receive_timing, receive_sensing);
+    setup.chunk_callback = chunk_callback;
+    setup.chunk_size = chunk_size;
+    setup.max_sysex_size = max_sysex_size;
+    setup.sysex_overflow_policy = overflow_policy;
+    setup.timestamp_mode = timestamp_mode;
+    return open_midi_in_by_id(observer, port_id, setup);
+}
+
+extern "C" FFI_PLUGIN_EXPORT uint64_t lrm_midi_in_get_sysex_aborted_count(LrmMidiIn* midi_in) {
+    if (!midi_in || !midi_in->sysex_stream) return 0;
+    return midi_in->sysex_stream->aborted();
+}
+
+extern "C" FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_clock(
+    LrmObserver* observer,
+    uint64_t port_id,
+    LrmMidiCallback callback,
+    void* context,
+    bool suppress_ticks,
+    int32_t timestamp_mode,
+    bool receive_sysex,
+    bool receive_sensing
+) {
+    LrmMidiInSetup setup = make_callback_setup(callback, context,
+                                               receive_sysex, true, receive_sensing);
+    setup.track_clock = true;
+    setup.suppress_clock_ticks = suppress_ticks;
+    setup.timestamp_mode = timestamp_mode;
+    return open_midi_in_by_id(observer, port_id, setup);
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_in_get_clock_state(LrmMidiIn* midi_in, LrmClockState* state) {
+    if (!midi_in || !midi_in->clock_tracker || !state) return LRM_ERR_INVALID;
+    midi_in->clock_tracker->getState(state);
+    return LRM_OK;
+}
+
+extern "C" FFI_PLUGIN_EXPORT LrmMidiIn* lrm_midi_in_open_timecode(
+    LrmObserver* observer,
+    uint64_t port_id,
+    LrmMidiCallback callback,
+    void* context,
+    bool suppress_quarter_frames,
+    int32_t timestamp_mode,
+    bool receive_sysex,
+    bool receive_sensing
+) {
+    LrmMidiInSetup setup = make_callback_setup(callback, context,
+                                               receive_sysex, true, receive_sensing);
+    setup.read_timecode = true;
+    setup.suppress_quarter_frames = suppress_quarter_frames;
+    setup.timestamp_mode = timestamp_mode;
+    return open_midi_in_by_id(observer, port_id, setup);
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_in_get_timecode(LrmMidiIn* midi_in, LrmTimecode* position) {
+    if (!midi_in || !midi_in->timecode_reader || !position) return LRM_ERR_INVALID;
+    midi_in->timecode_reader->getState(position);
+    return LRM_OK;
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_in_get_filter_stats(LrmMidiIn* midi_in, LrmMidiFilterStats* stats) {
+    if (!midi_in || !midi_in->filter || !stats) return LRM_ERR_INVALID;
+    midi_in->filter->getStats(stats);
+    return LRM_OK;
+}
+
+// =============================================================================
+// Routing API
+// =============================================================================
+
+extern "C" FFI_PLUGIN_EXPORT void lrm_route_transform_init(LrmRouteTransform* transform) {
+    if (!transform) return;
+    LrmRouteTransformer::init(transform);
+}
+
+extern "C" FFI_PLUGIN_EXPORT LrmRoute* lrm_route_create(
+    LrmMidiIn* midi_in,
+    LrmMidiOut* midi_out,
+    const LrmRouteTransform* transform
+) {
+    if (!midi_in || !midi_out) return nullptr;
+
+    LrmRouteTransform settings;
+    if (transform) {
+        settings = *transform;
+    } else {
+        LrmRouteTransformer::init(&settings);
+    }
+
+    try {
+        return new LrmRoute(midi_in, midi_out, settings);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+extern "C" FFI_PLUGIN_EXPORT bool lrm_route_is_native(LrmRoute* route) {
+    return route && route->isNative();
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_route_get_stats(LrmRoute* route, LrmRouteStats* stats) {
+    if (!route || !stats) return LRM_ERR_INVALID;
+    route->getStats(stats);
+    return LRM_OK;
+}
+
+extern "C" FFI_PLUGIN_EXPORT void lrm_route_destroy(LrmRoute* route) {
+    delete route;
+}
+
+// =============================================================================
+// Clock Generator API
+// =============================================================================
+
+extern "C" FFI_PLUGIN_EXPORT LrmClock* lrm_clock_create(double bpm) {
+    if (!LrmClockGenerator::validBpm(bpm)) return nullptr;
+    try {
+        return new LrmClock(bpm);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+extern "C" FFI_PLUGIN_EXPORT void lrm_clock_destroy(LrmClock* clock) {
+    delete clock;
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_clock_add_output(LrmClock* clock, LrmMidiOut* midi_out) {
+    if (!clock || !midi_out) return LRM_ERR_INVALID;
+    return clock->addOutput(midi_out) ? LRM_OK : LRM_ERR_INVALID;
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_clock_remove_output(LrmClock* clock, LrmMidiOut* midi_out) {
+    if (!clock || !midi_out) return LRM_ERR_INVALID;
+    return clock->removeOutput(midi_out) ? LRM_OK : LRM_ERR_NOT_FOUND;
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_clock_set_bpm(LrmClock* clock, double bpm) {
+    if (!clock || !LrmClockGenerator::validBpm(bpm)) return LRM_ERR_INVALID;
+    clock->generator.setBpm(bpm);
+    return LRM_OK;
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_clock_set_swing(LrmClock* clock, double swing) {
+    if (!clock || !LrmClockGenerator::validSwing(swing)) return LRM_ERR_INVALID;
+    clock->generator.setSwing(swing);
+    return LRM_OK;
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_clock_set_tick_when_stopped(LrmClock* clock, bool enabled) {
+    if (!clock) return LRM_ERR_INVALID;
+    clock->generator.setTickWhenStopped(enabled);
+    return LRM_OK;
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_clock_start(LrmClock* clock) {
+    if (!clock) return LRM_ERR_INVALID;
+    clock->generator.start();
+    return LRM_OK;
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_clock_stop(LrmClock* clock) {
+    if (!clock) return LRM_ERR_INVALID;
+    clock->generator.stop();
+    return LRM_OK;
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_clock_continue(LrmClock* clock) {
+    if (!clock) return LRM_ERR_INVALID;
+    clock->generator.resume();
+    return LRM_OK;
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_clock_set_song_position(LrmClock* clock, uint32_t sixteenths) {
+    if (!clock) return LRM_ERR_INVALID;
+    return clock->generator.setSongPosition(sixteenths) ? LRM_OK : LRM_ERR_INVALID;
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_clock_get_state(LrmClock* clock, LrmClockState* state) {
+    if (!clock || !state) return LRM_ERR_INVALID;
+    clock->generator.getState(state);
+    return LRM_OK;
+}
+
+// =============================================================================
+// Output Group API
+// =============================================================================
+
+extern "C" FFI_PLUGIN_EXPORT LrmMidiOutGroup* lrm_midi_out_group_create(bool kernel_fanout) {
+    try {
+        return new LrmMidiOutGroup(kernel_fanout);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+extern "C" FFI_PLUGIN_EXPORT void lrm_midi_out_group_destroy(LrmMidiOutGroup* group) {
+    delete group;
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_group_add(
+    LrmMidiOutGroup* group,
+    LrmMidiOut* midi_out,
+    const int8_t* channel_map
+) {
+    if (!group || !midi_out) return LRM_ERR_INVALID;
+    try {
+        return group->add(midi_out, channel_map);
+    } catch (...) {
+        return LRM_ERR_INIT_FAILED;
+    }
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_group_remove(LrmMidiOutGroup* group, LrmMidiOut* midi_out) {
+    if (!group || !midi_out) return LRM_ERR_INVALID;
+    return group->remove(midi_out);
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_group_send(
+    LrmMidiOutGroup* group,
+    const uint8_t* data,
+    size_t length
+) {
+    if (!group || !data) return LRM_ERR_INVALID;
+    return group->send(data, length);
+}
+
+extern "C" FFI_PLUGIN_EXPORT int32_t lrm_midi_out_group_kernel_fanout_count(LrmMidiOutGroup* group) {
+    if (!group) return LRM_ERR_INVALID;
+    return group->kernelFanoutCount();
+}
+
+#endif // LRM_MIDI_IO_HPP
@@ -0,0 +1,274 @@
+// Thins out and paces continuous controller traffic before it reaches the
+// backend.
+//
+// Control Change, Pitch Bend, Channel Pressure and Poly Pressure messages are
+// keyed by (status, controller or note). For each key the optimizer can:
+// - drop a message repeating the value last accepted for that key
+// - hold a message sent within coalesce_interval of the previous one for the
+//   same key, replacing it with any newer value until the interval is over
+// Everything leaves through a FIFO paced to max_bytes_per_second. A value for
+// a key that is still waiting in the FIFO is updated in place.
+//
+// Other messages (notes, program changes, SysEx, system messages) are never
+// dropped or reordered: held values are released into the FIFO ahead of them
+// and later values of the same key queue up behind them, so a pedal or volume
+// change never overtakes the notes sent after it.
+//
+// Sends happen on the calling thread when nothing is waiting, otherwise on a
+// small pacing thread. Whatever is still waiting at destruction is sent then
+// without pacing.
+
+#ifndef LRM_OUTPUT_OPTIMIZER_HPP
+#define LRM_OUTPUT_OPTIMIZER_HPP
+
+#include "libremidi_flutter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class LrmOutputOptimizer {
+public:
+    using clock = std::chrono::steady_clock;
+    using MessageSink = std::function<void(const uint8_t*, size_t)>;
+
+    LrmOutputOptimizer(const LrmMidiOptimizer& settings, MessageSink message_sink)
+        : drop_duplicates(settings.drop_duplicates),
+          interval(static_cast<int64_t>(settings.coalesce_interval_us) * 1000),
+          ns_per_byte(settings.max_bytes_per_second
+              ? 1000000000.0 / settings.max_bytes_per_second : 0.0),
+          sink(std::move(message_sink)),
+          keys(kKeyCount),
+          worker([this] { run(); })
+    {
+    }
+
+    ~LrmOutputOptimizer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_one();
+        worker.join();
+
+        releaseHeld(INT64_MAX);
+        for (const auto& slot : fifo) sink(slot.bytes.data(), slot.bytes.size());
+    }
+
+    // Any thread; data is one complete message
+    void submit(const uint8_t* data, size_t length) {
+        std::unique_lock<std::mutex> lock(mutex);
+        const int64_t now = nowNs();
+        const int key = keyOf(data, length);
+
+        if (key < 0) {
+            releaseHeld(INT64_MAX);
+        } else {
+            Key& state = keys[key];
+            const int32_t value = valueOf(data);
+            if (drop_duplicates && state.value == value) {
+                duplicates++;
+                return;
+            }
+            state.value = value;
+
+            if (state.held) {
+                std::memcpy(state.held_bytes, data, length);
+                coalesced++;
+                return;
+            }
+            if (state.queued && state.sequence >= barrier) {
+                fifo[state.sequence - front_sequence].bytes.assign(data, data + length);
+                coalesced++;
+                return;
+            }
+            if (interval > 0 && state.sent && now < state.last_sent + interval) {
+                state.held = true;
+                state.held_length = static_cast<uint8_t>(length);
+                std::memcpy(state.held_bytes, data, length);
+                state.due = state.last_sent + interval;
+                held_keys.push_back(key);
+                delayed++;
+                cv.notify_one();
+                return;
+            }
+        }
+
+        if (fifo.empty() && budgetAllows(now)) {
+            transmit(key, data, length, now);
+        } else {
+            delayed++;
+            enqueue(key, data, length);
+            pump(now);
+            cv.notify_one();
+        }
+        if (key < 0) barrier = next_sequence;
+    }
+
+    void getStats(LrmMidiOptimizerStats* stats) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats->duplicates = duplicates;
+        stats->coalesced = coalesced;
+        stats->delayed = delayed;
+        stats->pending = fifo.size() + held_keys.size();
+    }
+
+private:
+    // 16 channels x (128 controllers + 128 poly pressure notes + bend + pressure)
+    static constexpr int kKeyCount = 16 * 258;
+
+    struct Key {
+        int32_t value = -1;     // Last accepted value
+        bool sent = false;
+        int64_t last_sent = 0;
+        bool queued = false;
+        uint64_t sequence = 0;  // FIFO position while queued
+        bool held = false;      // Waiting for the coalescing interval
+        int64_t due = 0;
+        uint8_t held_length = 0;
+        uint8_t held_bytes[3] = {};
+    };
+
+    struct Slot {
+        int key;
+        std::vector<uint8_t> bytes;
+    };
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            clock::now().time_since_epoch()).count();
+    }
+
+    // Key of a continuous controller message, or -1 for any other message
+    static int keyOf(const uint8_t* data, size_t length) {
+        if (length == 0) return -1;
+        const int channel = data[0] & 0x0F;
+        switch (data[0] & 0xF0) {
+            case 0xB0:
+                return length == 3 ? channel * 258 + data[1] : -1;
+            case 0xA0:
+                return length == 3 ? channel * 258 + 128 + data[1] : -1;
+            case 0xE0:
+                return length == 3 ? channel * 258 + 256 : -1;
+            case 0xD0:
+                return length == 2 ? channel * 258 + 257 : -1;
+            default:
+                return -1;
+        }
+    }
+
+    static int32_t valueOf(const uint8_t* data) {
+        switch (data[0] & 0xF0) {
+            case 0xE0:
+                return data[1] | (data[2] << 7);
+            case 0xD0:
+                return data[1];
+            default:
+                return data[2];
+        }
+    }
+
+    bool budgetAllows(int64_t now) const {
+        return ns_per_byte == 0.0 || now >= next_free;
+    }
+
+    void enqueue(int key, const uint8_t* data, size_t length) {
+        fifo.push_back(Slot{key, std::vector<uint8_t>(data, data + length)});
+        if (key >= 0) {
+            keys[key].queued = true;
+            keys[key].sequence = next_sequence;
+        }
+        next_sequence++;
+    }
+
+    // Moves held values that are due into the FIFO
+    void releaseHeld(int64_t now) {
+        for (size_t i = 0; i < held_keys.size();) {
+            const int key = held_keys[i];
+            Key& state = keys[key];
+            if (state.due > now) {
+                i++;
+                continue;
+            }
+            state.held = false;
+            held_keys[i] = held_keys.back();
+            held_keys.pop_back();
+            enqueue(key, state.held_bytes, state.held_length);
+        }
+    }
+
+    void transmit(int key, const uint8_t* data, size_t length, int64_t now) {
+        if (key >= 0) {
+            Key& state = keys[key];
+            state.sent = true;
+            state.last_sent = now;
+        }
+        if (ns_per_byte != 0.0) {
+            next_free = std::max(next_free, now)
+                + static_cast<int64_t>(static_cast<double>(length) * ns_per_byte);
+        }
+        sink(data, length);
+    }
+
+    // Sends FIFO entries while the byte budget allows
+    void pump(int64_t now) {
+        while (!fifo.empty() && budgetAllows(now)) {
+            Slot slot = std::move(fifo.front());
+            fifo.pop_front();
+            front_sequence++;
+            if (slot.key >= 0) keys[slot.key].queued = false;
+            transmit(slot.key, slot.bytes.data(), slot.bytes.size(), now);
+        }
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            int64_t wake = INT64_MAX;
+            if (!fifo.empty()) wake = next_free;
+            for (int key : held_keys) wake = std::min(wake, keys[key].due);
+
+            if (wake == INT64_MAX) {
+                cv.wait(lock);
+            } else if (wake > nowNs()) {
+                cv.wait_until(lock, clock::time_point(std::chrono::nanoseconds(wake)));
+            }
+            if (stopping) break;
+
+            const int64_t now = nowNs();
+            releaseHeld(now);
+            pump(now);
+        }
+    }
+
+    const bool drop_duplicates;
+    const int64_t interval;
+    const double ns_per_byte;
+    const MessageSink sink;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<Key> keys;
+    std::vector<int> held_keys;
+    std::deque<Slot> fifo;
+    uint64_t front_sequence = 0;
+    uint64_t next_sequence = 0;
+    uint64_t barrier = 0;  // Values queued before this may not be updated
+    int64_t next_free = 0;
+    bool stopping = false;
+
+    uint64_t duplicates = 0;
+    uint64_t coalesced = 0;
+    uint64_t delayed = 0;
+
+    std::thread worker;  // Last: starts running in the constructor
+};
+
+#endif // LRM_OUTPUT_OPTIMIZER_HPP
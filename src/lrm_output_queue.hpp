@@ -0,0 +1,186 @@
+// Bounded multi-producer queue of outgoing MIDI messages, drained in order by
+// a dedicated writer thread so senders never wait on the backend.
+//
+// Slots follow Vyukov's bounded MPMC design used as MPSC: a sender claims a
+// position with a CAS, copies the message into the slot's buffer (reused, so
+// steady-state sends do not allocate) and publishes it by advancing the slot's
+// sequence number. The mutex is only touched to wake a sleeping writer or to
+// park a sender under LRM_BACKPRESSURE_BLOCK.
+//
+// Messages still queued when the queue is destroyed are sent first.
+
+#ifndef LRM_OUTPUT_QUEUE_HPP
+#define LRM_OUTPUT_QUEUE_HPP
+
+#include "libremidi_flutter.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class LrmOutputQueue {
+public:
+    static constexpr size_t kDefaultDepth = 256;
+    static constexpr size_t kMaxDepth = 65536;
+
+    // Sends one queued entry; batch entries hold several complete messages.
+    // Returns false if the backend rejected it.
+    using MessageSink = std::function<bool(const uint8_t*, size_t, bool batch)>;
+
+    LrmOutputQueue(size_t depth, int32_t backpressure, MessageSink message_sink)
+        : policy(backpressure), sink(std::move(message_sink))
+    {
+        size_t capacity = 2;
+        while (capacity < (depth ? depth : kDefaultDepth) && capacity < kMaxDepth) capacity <<= 1;
+        slots = std::make_unique<Slot[]>(capacity);
+        for (size_t i = 0; i < capacity; i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        mask = capacity - 1;
+        worker = std::thread([this] { run(); });
+    }
+
+    ~LrmOutputQueue() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_one();
+        space_cv.notify_all();
+        worker.join();
+    }
+
+    // Any thread. Returns LRM_OK once the entry is queued (or discarded under
+    // LRM_BACKPRESSURE_DROP), LRM_ERR_QUEUE_FULL under LRM_BACKPRESSURE_FAIL.
+    int32_t push(const uint8_t* data, size_t length, bool batch) {
+        if (!tryPush(data, length, batch)) {
+            if (policy != LRM_BACKPRESSURE_BLOCK) {
+                overflow_count.fetch_add(1, std::memory_order_relaxed);
+                return policy == LRM_BACKPRESSURE_FAIL ? LRM_ERR_QUEUE_FULL : LRM_OK;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            blocked_senders++;
+            bool queued = false;
+            while (!stopping && !(queued = tryPush(data, length, batch))) {
+                // The timeout covers a wakeup racing with the writer's check
+                space_cv.wait_for(lock, std::chrono::milliseconds(1));
+            }
+            blocked_senders--;
+            if (!queued) return LRM_ERR_SEND_FAILED;
+        }
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (writer_idle.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            cv.notify_one();
+        }
+        return LRM_OK;
+    }
+
+    uint64_t pending() const {
+        return enqueue_pos.load(std::memory_order_acquire) - dequeue_pos.load(std::memory_order_acquire);
+    }
+
+    uint64_t completed() const { return completed_count.load(std::memory_order_relaxed); }
+    uint64_t failed() const { return failed_count.load(std::memory_order_relaxed); }
+    uint64_t overflows() const { return overflow_count.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::vector<uint8_t> data;
+        bool batch = false;
+    };
+
+    bool tryPush(const uint8_t* data, size_t length, bool batch) {
+        uint64_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots[pos & mask];
+            const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<int64_t>(sequence - pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        slot->data.assign(data, data + length);
+        slot->batch = batch;
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool hasEntry() const {
+        const uint64_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        return slots[pos & mask].sequence.load(std::memory_order_acquire) == pos + 1;
+    }
+
+    // Writer thread
+    bool popOne() {
+        const uint64_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        Slot& slot = slots[pos & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+
+        bool ok = false;
+        try {
+            ok = sink(slot.data.data(), slot.data.size(), slot.batch);
+        } catch (...) {
+        }
+        (ok ? completed_count : failed_count).fetch_add(1, std::memory_order_relaxed);
+
+        slot.sequence.store(pos + mask + 1, std::memory_order_release);
+        dequeue_pos.store(pos + 1, std::memory_order_release);
+
+        if (blocked_senders.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            space_cv.notify_all();
+        }
+        return true;
+    }
+
+    void run() {
+        for (;;) {
+            if (popOne()) continue;
+
+            std::unique_lock<std::mutex> lock(mutex);
+            writer_idle.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            while (!hasEntry() && !stopping) cv.wait(lock);
+            writer_idle.store(false, std::memory_order_relaxed);
+            if (stopping && !hasEntry()) return;
+        }
+    }
+
+    const int32_t policy;
+    const MessageSink sink;
+    std::unique_ptr<Slot[]> slots;
+    size_t mask = 0;
+
+    alignas(64) std::atomic<uint64_t> enqueue_pos{0};
+    alignas(64) std::atomic<uint64_t> dequeue_pos{0};  // Written by the writer only
+    alignas(64) std::atomic<bool> writer_idle{false};
+    std::atomic<uint32_t> blocked_senders{0};
+
+    std::atomic<uint64_t> completed_count{0};
+    std::atomic<uint64_t> failed_count{0};
+    std::atomic<uint64_t> overflow_count{0};
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::condition_variable space_cv;
+    bool stopping = false;
+
+    std::thread worker;  // Last: starts running in the constructor
+};
+
+#endif // LRM_OUTPUT_QUEUE_HPP
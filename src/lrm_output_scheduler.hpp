@@ -0,0 +1,144 @@
+// Sends MIDI messages at a requested time on the lrm_now_ns() clock.
+//
+// Pending messages are kept in a priority queue ordered by timestamp (ties
+// keep submission order) and dispatched by a dedicated thread, which sleeps
+// on an LrmDeadlineTimer (an absolute timerfd on Linux and Android). A
+// message whose time has already passed is sent immediately.
+//
+// With a lookahead, messages are handed to the sink that much before they
+// are due, together with their timestamp, for backends that can queue them
+// and deliver them on time themselves (the ALSA sequencer). Such messages can
+// no longer be cancelled.
+//
+// Dispatch is serialized with flush(), so messages never overtake each other
+// even when a flush races with the scheduler thread.
+
+#ifndef LRM_OUTPUT_SCHEDULER_HPP
+#define LRM_OUTPUT_SCHEDULER_HPP
+
+#include "lrm_deadline_timer.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+class LrmOutputScheduler {
+public:
+    // Receives the due time, or 0 for messages that should go out now
+    using MessageSink = std::function<void(int64_t, const uint8_t*, size_t)>;
+
+    explicit LrmOutputScheduler(MessageSink message_sink, int64_t lookahead_ns = 0)
+        : sink(std::move(message_sink)), lookahead(lookahead_ns)
+    {
+        worker = std::thread([this] { run(); });
+    }
+
+    ~LrmOutputScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        timer.wake();
+        worker.join();
+    }
+
+    void schedule(int64_t timestamp_ns, const uint8_t* data, size_t length) {
+        bool earliest;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            earliest = queue.empty() || timestamp_ns < queue.top().timestamp;
+            queue.push(Event{timestamp_ns, next_sequence++, std::vector<uint8_t>(data, data + length)});
+        }
+        if (earliest) timer.wake();
+    }
+
+    // Drops all pending messages and returns how many there were
+    size_t cancelAll() {
+        size_t dropped;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            dropped = queue.size();
+            queue = Queue();
+        }
+        timer.wake();
+        return dropped;
+    }
+
+    // Sends all pending messages now, in timestamp order, on the calling
+    // thread. Returns how many were sent.
+    size_t flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        std::vector<Event> events;
+        events.reserve(queue.size());
+        while (!queue.empty()) {
+            events.push_back(queue.top());
+            queue.pop();
+        }
+        std::lock_guard<std::mutex> ordered(dispatch_mutex);
+        lock.unlock();
+        for (const auto& event : events) {
+            sink(0, event.data.data(), event.data.size());
+        }
+        return events.size();
+    }
+
+    size_t pending() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return queue.size();
+    }
+
+private:
+    struct Event {
+        int64_t timestamp;
+        uint64_t sequence;
+        std::vector<uint8_t> data;
+    };
+
+    struct Later {
+        bool operator()(const Event& a, const Event& b) const {
+            return a.timestamp != b.timestamp ? a.timestamp > b.timestamp : a.sequence > b.sequence;
+        }
+    };
+
+    using Queue = std::priority_queue<Event, std::vector<Event>, Later>;
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            if (queue.empty()) {
+                timer.waitUntil(lock, nullptr);
+                continue;
+            }
+            const int64_t due = queue.top().timestamp - lookahead;
+            if (due > LrmDeadlineTimer::now()) {
+                timer.waitUntil(lock, &due);
+                continue;
+            }
+
+            Event event = queue.top();
+            queue.pop();
+            std::unique_lock<std::mutex> ordered(dispatch_mutex);
+            lock.unlock();
+            sink(event.timestamp, event.data.data(), event.data.size());
+            ordered.unlock();
+            lock.lock();
+        }
+    }
+
+    const MessageSink sink;
+    const int64_t lookahead;
+
+    mutable std::mutex mutex;
+    std::mutex dispatch_mutex;
+    LrmDeadlineTimer timer;
+    Queue queue;
+    uint64_t next_sequence = 0;
+    bool stopping = false;
+
+    std::thread worker;  // Last: starts running in the constructor
+};
+
+#endif // LRM_OUTPUT_SCHEDULER_HPP
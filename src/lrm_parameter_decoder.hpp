@@ -0,0 +1,160 @@
+// Per-channel decoder for RPN/NRPN sequences and paired 14-bit controllers.
+//
+// Mirrors RpnNrpnParser in the Dart package: CC 101/100 and 99/98 select a
+// parameter, Data Entry (CC 6/38) and Data Increment/Decrement (CC 96/97)
+// produce events, and the 127/127 null function deselects. Controllers 0-31
+// enabled in the 14-bit mask are paired with their LSB (controller + 32).
+//
+// Runs on the backend thread only, so the state needs no synchronization.
+
+#ifndef LRM_PARAMETER_DECODER_HPP
+#define LRM_PARAMETER_DECODER_HPP
+
+#include "libremidi_flutter.h"
+
+#include <array>
+#include <cstdint>
+
+class LrmParameterDecoder {
+public:
+    LrmParameterDecoder(LrmParameterCallback cb, void* ctx, uint32_t decode_flags, uint32_t cc14)
+        : callback(cb), context(ctx), flags(decode_flags), cc14_mask(cc14)
+    {
+    }
+
+    // Returns true if the message was consumed by the decoder and should not
+    // be delivered raw (only when LRM_DECODE_SUPPRESS_RAW is set).
+    bool process(const uint8_t* data, size_t length, int64_t timestamp) {
+        if (length < 3 || (data[0] & 0xF0) != 0xB0) return false;
+
+        const int32_t channel = data[0] & 0x0F;
+        const uint8_t controller = data[1];
+        const uint8_t value = data[2];
+        const bool consumed = decode(states[channel], channel, controller, value, timestamp);
+        return consumed && (flags & LRM_DECODE_SUPPRESS_RAW);
+    }
+
+private:
+    static constexpr int16_t kUnset = -1;
+
+    enum class Selected : uint8_t { None, Rpn, Nrpn };
+
+    struct ChannelState {
+        Selected selected = Selected::None;
+        int16_t rpn_msb = kUnset;
+        int16_t rpn_lsb = kUnset;
+        int16_t nrpn_msb = kUnset;
+        int16_t nrpn_lsb = kUnset;
+        int16_t data_msb = kUnset;
+        std::array<int16_t, 32> cc_msb;
+
+        ChannelState() { cc_msb.fill(kUnset); }
+
+        int32_t parameter() const {
+            if (selected == Selected::Rpn && rpn_msb != kUnset && rpn_lsb != kUnset) {
+                return (rpn_msb << 7) | rpn_lsb;
+            }
+            if (selected == Selected::Nrpn && nrpn_msb != kUnset && nrpn_lsb != kUnset) {
+                return (nrpn_msb << 7) | nrpn_lsb;
+            }
+            return -1;
+        }
+
+        int32_t kind() const {
+            return selected == Selected::Rpn ? LRM_PARAM_RPN : LRM_PARAM_NRPN;
+        }
+    };
+
+    bool decode(ChannelState& state, int32_t channel, uint8_t controller,
+                uint8_t value, int64_t timestamp) {
+        if (flags & LRM_DECODE_RPN) {
+            switch (controller) {
+                case 101:
+                case 100:
+                    if (state.selected != Selected::Rpn) {
+                        state.nrpn_msb = state.nrpn_lsb = kUnset;
+                    }
+                    state.selected = Selected::Rpn;
+                    state.data_msb = kUnset;
+                    (controller == 101 ? state.rpn_msb : state.rpn_lsb) = value;
+                    if (state.rpn_msb == 127 && state.rpn_lsb == 127) {
+                        state.selected = Selected::None;
+                        state.rpn_msb = state.rpn_lsb = kUnset;
+                    }
+                    return true;
+                case 99:
+                case 98:
+                    if (state.selected != Selected::Nrpn) {
+                        state.rpn_msb = state.rpn_lsb = kUnset;
+                    }
+                    state.selected = Selected::Nrpn;
+                    state.data_msb = kUnset;
+                    (controller == 99 ? state.nrpn_msb : state.nrpn_lsb) = value;
+                    if (state.nrpn_msb == 127 && state.nrpn_lsb == 127) {
+                        state.selected = Selected::None;
+                        state.nrpn_msb = state.nrpn_lsb = kUnset;
+                    }
+                    return true;
+                default:
+                    break;
+            }
+
+            const int32_t parameter = state.parameter();
+            if (parameter >= 0) {
+                switch (controller) {
+                    case 6:
+                        state.data_msb = value;
+                        if (!(flags & LRM_DECODE_WAIT_FOR_LSB)) {
+                            emit(state.kind(), 0, channel, parameter, value, timestamp);
+                        }
+                        return true;
+                    case 38:
+                        if (state.data_msb == kUnset) return false;
+                        emit(state.kind(), LRM_PARAM_FLAG_14BIT, channel, parameter,
+                             (state.data_msb << 7) | value, timestamp);
+                        return true;
+                    case 96:
+                        emit(state.kind(), LRM_PARAM_FLAG_INCREMENT, channel, parameter, value, timestamp);
+                        return true;
+                    case 97:
+                        emit(state.kind(), LRM_PARAM_FLAG_DECREMENT, channel, parameter, value, timestamp);
+                        return true;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        if (controller < 32 && (cc14_mask & (1u << controller))) {
+            // A new MSB resets the LSB to zero
+            state.cc_msb[controller] = value;
+            if (!(flags & LRM_DECODE_WAIT_FOR_LSB)) {
+                emit(LRM_PARAM_CC14, LRM_PARAM_FLAG_14BIT, channel, controller, value << 7, timestamp);
+            }
+            return true;
+        }
+        if (controller >= 32 && controller < 64 && (cc14_mask & (1u << (controller - 32)))) {
+            const int16_t msb = state.cc_msb[controller - 32];
+            if (msb == kUnset) return false;
+            emit(LRM_PARAM_CC14, LRM_PARAM_FLAG_14BIT, channel, controller - 32,
+                 (msb << 7) | value, timestamp);
+            return true;
+        }
+        return false;
+    }
+
+    void emit(int32_t kind, int32_t event_flags, int32_t channel,
+              int32_t parameter, int32_t value, int64_t timestamp) {
+        if (callback) {
+            callback(context, kind, event_flags, channel, parameter, value, timestamp);
+        }
+    }
+
+    const LrmParameterCallback callback;
+    void* const context;
+    const uint32_t flags;
+    const uint32_t cc14_mask;
+    std::array<ChannelState, 16> states;
+};
+
+#endif // LRM_PARAMETER_DECODER_HPP
@@ -0,0 +1,123 @@
+// Enumerated ports of one direction, indexed by public port id and stable id.
+//
+// Both ids are computed once, when a port enters the list, so looking a port
+// up never hashes its name again. The hash indexes map an id to the port's
+// position and are rebuilt from the stored ids whenever positions shift.
+// Stable ids are not necessarily unique (two identical devices without a
+// serial number share one); lookup by stable id finds the first such port.
+//
+// Not synchronised: the observer guards it with its ports mutex.
+
+#ifndef LRM_PORT_LIST_HPP
+#define LRM_PORT_LIST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+template <typename PortType>
+class LrmPortList {
+public:
+    using IdFunction = uint64_t (*)(const PortType&);
+
+    LrmPortList(IdFunction port_id_of, IdFunction stable_id_of)
+        : port_id_of(port_id_of), stable_id_of(stable_id_of)
+    {
+    }
+
+    void assign(std::vector<PortType> new_ports) {
+        ports = std::move(new_ports);
+        port_ids.clear();
+        stable_ids.clear();
+        port_ids.reserve(ports.size());
+        stable_ids.reserve(ports.size());
+        for (const auto& port : ports) {
+            port_ids.push_back(port_id_of(port));
+            stable_ids.push_back(stable_id_of(port));
+        }
+        reindex();
+    }
+
+    // A port that is already known (same port id) is replaced in place
+    void add(const PortType& port) {
+        const uint64_t port_id = port_id_of(port);
+        const uint64_t stable_id = stable_id_of(port);
+        const auto it = by_port_id.find(port_id);
+        if (it != by_port_id.end()) {
+            ports[it->second] = port;
+            if (stable_ids[it->second] != stable_id) {
+                stable_ids[it->second] = stable_id;
+                reindex();
+            }
+            return;
+        }
+        ports.push_back(port);
+        port_ids.push_back(port_id);
+        stable_ids.push_back(stable_id);
+        by_port_id.emplace(port_id, ports.size() - 1);
+        by_stable_id.emplace(stable_id, ports.size() - 1);
+    }
+
+    bool remove(uint64_t port_id) {
+        const auto it = by_port_id.find(port_id);
+        if (it == by_port_id.end()) return false;
+        const size_t index = it->second;
+        ports.erase(ports.begin() + static_cast<std::ptrdiff_t>(index));
+        port_ids.erase(port_ids.begin() + static_cast<std::ptrdiff_t>(index));
+        stable_ids.erase(stable_ids.begin() + static_cast<std::ptrdiff_t>(index));
+        reindex();
+        return true;
+    }
+
+    size_t size() const { return ports.size(); }
+
+    const PortType* at(size_t index) const {
+        return index < ports.size() ? &ports[index] : nullptr;
+    }
+
+    uint64_t portIdAt(size_t index) const { return port_ids[index]; }
+
+    uint64_t stableIdAt(size_t index) const { return stable_ids[index]; }
+
+    bool contains(uint64_t port_id) const { return by_port_id.count(port_id) != 0; }
+
+    // Returns the port and stores its position in index, or nullptr
+    const PortType* find(uint64_t port_id, size_t* index = nullptr) const {
+        return lookup(by_port_id, port_id, index);
+    }
+
+    const PortType* findStable(uint64_t stable_id, size_t* index = nullptr) const {
+        return lookup(by_stable_id, stable_id, index);
+    }
+
+private:
+    using Index = std::unordered_map<uint64_t, size_t>;
+
+    void reindex() {
+        by_port_id.clear();
+        by_stable_id.clear();
+        for (size_t i = 0; i < ports.size(); i++) {
+            by_port_id.emplace(port_ids[i], i);
+            by_stable_id.emplace(stable_ids[i], i);  // Keeps the first
+        }
+    }
+
+    const PortType* lookup(const Index& index_map, uint64_t id, size_t* index) const {
+        const auto it = index_map.find(id);
+        if (it == index_map.end()) return nullptr;
+        if (index) *index = it->second;
+        return &ports[it->second];
+    }
+
+    IdFunction port_id_of;
+    IdFunction stable_id_of;
+    std::vector<PortType> ports;
+    std::vector<uint64_t> port_ids;
+    std::vector<uint64_t> stable_ids;
+    Index by_port_id;
+    Index by_stable_id;
+};
+
+#endif // LRM_PORT_LIST_HPP
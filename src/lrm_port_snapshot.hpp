@@ -0,0 +1,95 @@
+// Packs the observer's port lists into a single LrmPortSnapshot allocation:
+// the LrmPortSnapshot header, then one LrmPortRecord per port (inputs first),
+// then the string table. Each distinct string is stored once, NUL-terminated,
+// and records refer to it by offset; offset 0 is the empty string.
+//
+// The allocation is released with std::free() (lrm_port_snapshot_free).
+//
+// Included by each platform's libremidi_flutter.cpp after libremidi.hpp.
+
+#ifndef LRM_PORT_SNAPSHOT_HPP
+#define LRM_PORT_SNAPSHOT_HPP
+
+#include "libremidi_flutter.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class LrmPortSnapshotBuilder {
+public:
+    LrmPortSnapshotBuilder() {
+        strings.push_back('\0');
+    }
+
+    // list is an LrmPortList; its ports must outlive the builder
+    template <typename PortList>
+    void addPorts(const PortList& list, bool is_input) {
+        records.reserve(records.size() + list.size());
+        for (size_t i = 0; i < list.size(); i++) {
+            const auto& port = *list.at(i);
+            LrmPortRecord record{};
+            record.stable_id = list.stableIdAt(i);
+            record.port_id = list.portIdAt(i);
+            record.client_handle = static_cast<uint64_t>(port.client);
+            record.index = static_cast<int32_t>(i);
+            record.display_name = intern(port.display_name);
+            record.port_name = intern(port.port_name);
+            record.device_name = intern(port.device_name);
+            record.manufacturer = intern(port.manufacturer);
+            record.product = intern(port.product);
+            record.serial = intern(port.serial);
+            record.transport_type = static_cast<uint8_t>(port.type);
+            record.is_input = is_input;
+            record.is_virtual = (port.type == libremidi::transport_type::software ||
+                                 port.type == libremidi::transport_type::loopback);
+            records.push_back(record);
+            (is_input ? input_count : output_count)++;
+        }
+    }
+
+    // Returns nullptr if the allocation fails
+    LrmPortSnapshot* build(uint64_t generation) const {
+        const size_t records_size = records.size() * sizeof(LrmPortRecord);
+        auto* block = static_cast<char*>(std::malloc(kRecordsOffset + records_size + strings.size()));
+        if (!block) return nullptr;
+
+        auto* snapshot = reinterpret_cast<LrmPortSnapshot*>(block);
+        auto* ports = reinterpret_cast<LrmPortRecord*>(block + kRecordsOffset);
+        char* table = block + kRecordsOffset + records_size;
+        if (!records.empty()) std::memcpy(ports, records.data(), records_size);
+        std::memcpy(table, strings.data(), strings.size());
+
+        snapshot->generation = generation;
+        snapshot->input_count = input_count;
+        snapshot->output_count = output_count;
+        snapshot->strings_size = static_cast<uint32_t>(strings.size());
+        snapshot->ports = ports;
+        snapshot->strings = table;
+        return snapshot;
+    }
+
+private:
+    // Records follow the header at their own alignment
+    static constexpr size_t kRecordsOffset =
+        (sizeof(LrmPortSnapshot) + alignof(LrmPortRecord) - 1) / alignof(LrmPortRecord) * alignof(LrmPortRecord);
+
+    uint32_t intern(const std::string& value) {
+        if (value.empty()) return 0;
+        const auto [it, inserted] = offsets.emplace(value, static_cast<uint32_t>(strings.size()));
+        if (inserted) strings.insert(strings.end(), value.c_str(), value.c_str() + value.size() + 1);
+        return it->second;
+    }
+
+    std::vector<LrmPortRecord> records;
+    std::vector<char> strings;
+    std::unordered_map<std::string_view, uint32_t> offsets;  // Views into the ports
+    uint32_t input_count = 0;
+    uint32_t output_count = 0;
+};
+
+#endif // LRM_PORT_SNAPSHOT_HPP
@@ -0,0 +1,83 @@
+// Per-route message transformation for native input-to-output routing.
+//
+// Messages are first matched against the route's filter, then channel
+// messages are remapped: channel_map moves (or drops) each channel, notes are
+// transposed, and Note On velocities are scaled. System messages, including
+// SysEx, are forwarded unchanged.
+
+#ifndef LRM_ROUTE_TRANSFORM_HPP
+#define LRM_ROUTE_TRANSFORM_HPP
+
+#include "libremidi_flutter.h"
+
+#include "lrm_input_filter.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+class LrmRouteTransformer {
+public:
+    explicit LrmRouteTransformer(const LrmRouteTransform& settings)
+        : transform(settings), filter(settings.filter)
+    {
+    }
+
+    // Backend thread. Returns the message to forward, which is either data
+    // or scratch (holding at most 3 bytes), or nullptr to drop it.
+    const uint8_t* apply(const uint8_t* data, size_t length, uint8_t* scratch) {
+        if (length == 0 || !filter.accept(data, length)) return nullptr;
+
+        const uint8_t status = data[0];
+        if (status < 0x80 || status >= 0xF0 || length > 3) return data;
+
+        const int8_t channel = transform.channel_map[status & 0x0F];
+        if (channel < 0 || channel > 15) return nullptr;
+        std::memcpy(scratch, data, length);
+        scratch[0] = static_cast<uint8_t>((status & 0xF0) | channel);
+
+        switch (status & 0xF0) {
+            case 0x90:
+                if (length == 3 && scratch[2] != 0 && transform.velocity_scale != 1.0f) {
+                    const long velocity = std::lround(scratch[2] * transform.velocity_scale);
+                    scratch[2] = static_cast<uint8_t>(velocity < 1 ? 1 : velocity > 127 ? 127 : velocity);
+                }
+                [[fallthrough]];
+            case 0x80:
+            case 0xA0:
+                if (length >= 2 && transform.transpose != 0) {
+                    const int note = scratch[1] + transform.transpose;
+                    if (note < 0 || note > 127) return nullptr;
+                    scratch[1] = static_cast<uint8_t>(note);
+                }
+                break;
+            default:
+                break;
+        }
+        return scratch;
+    }
+
+    // Whether messages pass unchanged, so the route can be made by the backend
+    static bool isIdentity(const LrmRouteTransform& settings) {
+        for (int8_t channel = 0; channel < 16; channel++) {
+            if (settings.channel_map[channel] != channel) return false;
+        }
+        return LrmInputFilter::acceptsAll(settings.filter)
+            && settings.transpose == 0
+            && settings.velocity_scale == 1.0f;
+    }
+
+    static void init(LrmRouteTransform* settings) {
+        std::memset(settings, 0, sizeof(*settings));
+        LrmInputFilter::initAcceptAll(&settings->filter);
+        for (int8_t channel = 0; channel < 16; channel++) settings->channel_map[channel] = channel;
+        settings->transpose = 0;
+        settings->velocity_scale = 1.0f;
+    }
+
+private:
+    const LrmRouteTransform transform;
+    LrmInputFilter filter;
+};
+
+#endif // LRM_ROUTE_TRANSFORM_HPP
@@ -0,0 +1,115 @@
+// Counters and latency gauges for inputs and outputs.
+//
+// Every update is a relaxed atomic operation so the MIDI hot path pays
+// little more than an uncontended increment. Readers get a snapshot that is
+// consistent per field but not across fields, which is fine for monitoring.
+
+#ifndef LRM_STATS_HPP
+#define LRM_STATS_HPP
+
+#include "libremidi_flutter.h"
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+
+// Log-linear histogram of durations in nanoseconds: each power of two is
+// split into four buckets, so percentiles are reported within 25%.
+class LrmLatencyHistogram {
+public:
+    void record(uint64_t ns) {
+        buckets[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+        uint64_t current = max_ns.load(std::memory_order_relaxed);
+        while (ns > current &&
+               !max_ns.compare_exchange_weak(current, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t max() const { return max_ns.load(std::memory_order_relaxed); }
+
+    // Upper bound of the bucket holding the given quantile (0 if empty)
+    uint64_t percentile(double quantile) const {
+        uint64_t counts[kBuckets];
+        uint64_t total = 0;
+        for (size_t i = 0; i < kBuckets; i++) {
+            counts[i] = buckets[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+        if (total == 0) return 0;
+
+        const auto rank = static_cast<uint64_t>(quantile * static_cast<double>(total - 1));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; i++) {
+            seen += counts[i];
+            if (seen > rank) {
+                const uint64_t bound = upperBound(i);
+                const uint64_t highest = max();
+                return bound < highest ? bound : highest;
+            }
+        }
+        return max();
+    }
+
+private:
+    static constexpr size_t kSubBuckets = 4;
+    static constexpr size_t kBuckets = 64 * kSubBuckets;
+
+    static size_t bucketOf(uint64_t ns) {
+        if (ns < kSubBuckets) return static_cast<size_t>(ns);
+        const int octave = std::bit_width(ns) - 1;  // >= 2
+        const auto sub = static_cast<size_t>((ns >> (octave - 2)) & (kSubBuckets - 1));
+        return static_cast<size_t>(octave) * kSubBuckets + sub;
+    }
+
+    static uint64_t upperBound(size_t bucket) {
+        if (bucket < kSubBuckets) return bucket;
+        const size_t octave = bucket / kSubBuckets;
+        const uint64_t sub = bucket % kSubBuckets;
+        const uint64_t step = uint64_t(1) << (octave - 2);
+        return (uint64_t(1) << octave) + (sub + 1) * step - 1;
+    }
+
+    std::atomic<uint64_t> buckets[kBuckets] = {};
+    std::atomic<uint64_t> max_ns{0};
+};
+
+struct LrmInputCounters {
+    std::atomic<uint64_t> messages{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> sysex{0};
+    std::atomic<uint64_t> filtered{0};
+    LrmLatencyHistogram latency;
+
+    void received(const uint8_t* data, size_t length) {
+        messages.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(length, std::memory_order_relaxed);
+        if (length > 0 && data[0] == 0xF0) {
+            sysex.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+};
+
+struct LrmOutputCounters {
+    std::atomic<uint64_t> messages{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> sysex{0};
+    std::atomic<uint64_t> failures{0};
+    std::atomic<uint64_t> send_time_ns{0};
+    LrmLatencyHistogram send_latency;
+
+    // One backend call that carried message_count messages
+    void sent(uint64_t message_count, uint64_t sysex_count, size_t length,
+              uint64_t elapsed_ns, bool ok) {
+        if (ok) {
+            messages.fetch_add(message_count, std::memory_order_relaxed);
+            bytes.fetch_add(length, std::memory_order_relaxed);
+            if (sysex_count) sysex.fetch_add(sysex_count, std::memory_order_relaxed);
+        } else {
+            failures.fetch_add(message_count, std::memory_order_relaxed);
+        }
+        send_time_ns.fetch_add(elapsed_ns, std::memory_order_relaxed);
+        send_latency.record(elapsed_ns);
+    }
+};
+
+#endif // LRM_STATS_HPP
@@ -0,0 +1,203 @@
+// Streams SysEx as fixed-size chunks instead of reassembling whole messages.
+//
+// Consumes the raw MIDI 1 byte stream of a port. Channel and system messages
+// are segmented and passed on to the regular input path; SysEx bytes are
+// collected into a single chunk buffer that is handed to the
+// LrmSysexChunkCallback whenever it fills up or the message ends, so memory
+// use stays bounded by the chunk size however large a dump is. Real-time
+// bytes interleaved within SysEx are delivered immediately.
+//
+// Ownership of each delivered chunk passes to the callback, which releases
+// it with lrm_midi_batch_free(). Runs on the backend thread only.
+
+#ifndef LRM_SYSEX_STREAM_HPP
+#define LRM_SYSEX_STREAM_HPP
+
+#include "libremidi_flutter.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+class LrmSysexStreamer {
+public:
+    using MessageSink = std::function<void(const uint8_t*, size_t, int64_t)>;
+
+    LrmSysexStreamer(LrmSysexChunkCallback cb, void* ctx,
+                     uint32_t chunk_size, uint32_t max_size, int32_t policy,
+                     bool receive_timing, bool receive_sensing, MessageSink sink)
+        : callback(cb), context(ctx),
+          chunk_limit(chunk_size ? chunk_size : kDefaultChunkSize),
+          max_sysex_size(max_size),
+          truncate(policy == LRM_SYSEX_OVERFLOW_TRUNCATE),
+          timing(receive_timing), sensing(receive_sensing),
+          on_message(std::move(sink))
+    {
+        chunk.reserve(chunk_limit);
+    }
+
+    // Number of SysEx chunks delivered
+    uint64_t chunks() const { return chunk_count.load(std::memory_order_relaxed); }
+
+    // Number of SysEx messages cut short by the size cap or left unterminated
+    uint64_t aborted() const { return aborted_count.load(std::memory_order_relaxed); }
+
+    void onBytes(const uint8_t* data, size_t length, int64_t timestamp) {
+        for (size_t i = 0; i < length; i++) {
+            onByte(data[i], timestamp);
+        }
+    }
+
+private:
+    static constexpr uint32_t kDefaultChunkSize = 4096;
+
+    enum class State : uint8_t { Main, Sysex, Discard };
+
+    void onByte(uint8_t b, int64_t timestamp) {
+        if (b >= 0xF8) {
+            if ((b == 0xF8 && !timing) || (b == 0xFE && !sensing)) return;
+            on_message(&b, 1, timestamp);
+            return;
+        }
+
+        if (state != State::Main) {
+            if (b < 0x80) {
+                appendSysex(b);
+                return;
+            }
+            if (b == 0xF7) {
+                if (state == State::Sysex) {
+                    chunk.push_back(b);
+                    flushChunk(LRM_SYSEX_CHUNK_END);
+                }
+                state = State::Main;
+                return;
+            }
+            // Any other status byte ends an unterminated SysEx
+            if (state == State::Sysex) {
+                flushChunk(LRM_SYSEX_CHUNK_END | LRM_SYSEX_CHUNK_ABORTED);
+                aborted_count.fetch_add(1, std::memory_order_relaxed);
+            }
+            state = State::Main;
+        }
+
+        if (b == 0xF0) {
+            state = State::Sysex;
+            sysex_size = 0;
+            sysex_timestamp = timestamp;
+            next_flags = LRM_SYSEX_CHUNK_BEGIN;
+            running_status = 0;
+            pending = 0;
+            appendSysex(b);
+            return;
+        }
+
+        if (b >= 0x80) {
+            if (b == 0xF7) return;  // Stray end of SysEx
+            running_status = b < 0xF0 ? b : 0;
+            message[0] = b;
+            pending = 1;
+            expected = messageLength(b);
+            if (pending == expected) emitMessage(timestamp);
+            return;
+        }
+
+        if (pending == 0) {
+            if (!running_status) return;  // Stray data byte
+            message[0] = running_status;
+            pending = 1;
+            expected = messageLength(running_status);
+        }
+        message[pending++] = b;
+        if (pending == expected) emitMessage(timestamp);
+    }
+
+    void emitMessage(int64_t timestamp) {
+        const size_t length = pending;
+        pending = 0;
+        if (message[0] == 0xF1 && !timing) return;
+        on_message(message, length, timestamp);
+    }
+
+    void appendSysex(uint8_t b) {
+        if (state == State::Discard) return;
+
+        if (max_sysex_size != 0 && ++sysex_size > max_sysex_size) {
+            aborted_count.fetch_add(1, std::memory_order_relaxed);
+            flushChunk(LRM_SYSEX_CHUNK_END
+                       | (truncate ? LRM_SYSEX_CHUNK_TRUNCATED : LRM_SYSEX_CHUNK_ABORTED));
+            state = State::Discard;
+            return;
+        }
+
+        chunk.push_back(b);
+        if (chunk.size() == chunk_limit) {
+            flushChunk(0);
+        }
+    }
+
+    void flushChunk(int32_t end_flags) {
+        const int32_t flags = next_flags | end_flags;
+        next_flags = LRM_SYSEX_CHUNK_CONTINUE;
+
+        // An aborted message may end without any bytes left to deliver
+        auto copy = static_cast<uint8_t*>(std::malloc(chunk.empty() ? 1 : chunk.size()));
+        if (!copy) {
+            chunk.clear();
+            return;
+        }
+        if (!chunk.empty()) std::memcpy(copy, chunk.data(), chunk.size());
+        const size_t length = chunk.size();
+        chunk.clear();
+        chunk_count.fetch_add(1, std::memory_order_relaxed);
+        callback(context, copy, length, flags, sysex_timestamp);
+    }
+
+    static uint8_t messageLength(uint8_t status) {
+        switch (status & 0xF0) {
+            case 0xC0:
+            case 0xD0:
+                return 2;
+            case 0xF0:
+                switch (status) {
+                    case 0xF1:
+                    case 0xF3:
+                        return 2;
+                    case 0xF2:
+                        return 3;
+                    default:
+                        return 1;
+                }
+            default:
+                return 3;
+        }
+    }
+
+    const LrmSysexChunkCallback callback;
+    void* const context;
+    const size_t chunk_limit;
+    const uint32_t max_sysex_size;
+    const bool truncate;
+    const bool timing;
+    const bool sensing;
+    const MessageSink on_message;
+
+    State state = State::Main;
+    std::vector<uint8_t> chunk;
+    size_t sysex_size = 0;
+    int64_t sysex_timestamp = 0;
+    int32_t next_flags = LRM_SYSEX_CHUNK_BEGIN;
+
+    uint8_t message[3] = {};
+    uint8_t pending = 0;
+    uint8_t expected = 0;
+    uint8_t running_status = 0;
+
+    std::atomic<uint64_t> chunk_count{0};
+    std::atomic<uint64_t> aborted_count{0};
+};
+
+#endif // LRM_SYSEX_STREAM_HPP
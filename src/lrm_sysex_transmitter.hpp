@@ -0,0 +1,236 @@
+// Sends large SysEx transfers in paced pieces from its own thread, for
+// devices that lose data when a dump arrives at full speed.
+//
+// A transfer is one or more complete SysEx messages (e.g. the contents of a
+// .syx file). Each message is cut into pieces of at most chunk_size bytes; a
+// piece never spans two messages. After each piece the thread waits for
+// chunk_delay and for the byte budget of max_bytes_per_second, whichever is
+// later. Transfers are sent one after the other in the order they were
+// started, and their state can be polled by id.
+//
+// A message interrupted by cancellation or destruction is closed with F7 so
+// the receiver does not stay in SysEx mode.
+
+#ifndef LRM_SYSEX_TRANSMITTER_HPP
+#define LRM_SYSEX_TRANSMITTER_HPP
+
+#include "libremidi_flutter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class LrmSysexTransmitter {
+public:
+    using clock = std::chrono::steady_clock;
+
+    // Sends one piece; `last` is set on the piece ending a message.
+    // Returns false if the backend rejected it.
+    using ChunkSink = std::function<bool(const uint8_t*, size_t, bool last)>;
+
+    explicit LrmSysexTransmitter(ChunkSink chunk_sink)
+        : sink(std::move(chunk_sink)),
+          worker([this] { run(); })
+    {
+    }
+
+    ~LrmSysexTransmitter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            for (auto& transfer : transfers) transfer.cancelled = true;
+        }
+        cv.notify_one();
+        worker.join();
+    }
+
+    // Any thread. data must be one or more complete SysEx messages. Returns
+    // the transfer id (> 0).
+    int64_t start(const uint8_t* data, size_t length, const LrmSysexPacing& pacing) {
+        Transfer transfer;
+        transfer.data.assign(data, data + length);
+        transfer.chunk_size = pacing.chunk_size ? pacing.chunk_size : SIZE_MAX;
+        transfer.delay_ns = static_cast<int64_t>(pacing.chunk_delay_us) * 1000;
+        transfer.ns_per_byte = pacing.max_bytes_per_second
+            ? 1000000000.0 / pacing.max_bytes_per_second : 0.0;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        transfer.id = ++last_id;
+        transfers.push_back(std::move(transfer));
+        cv.notify_one();
+        return static_cast<int64_t>(last_id);
+    }
+
+    // LRM_OK, or LRM_ERR_NOT_FOUND for an unknown or long finished transfer
+    int32_t getStatus(uint64_t id, LrmSysexTransferStatus* status) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& transfer : transfers) {
+            if (transfer.id != id) continue;
+            status->bytes_sent = transfer.sent;
+            status->bytes_total = transfer.data.size();
+            status->state = transfer.sent > 0 || &transfer == &transfers.front()
+                ? LRM_SYSEX_TX_SENDING : LRM_SYSEX_TX_QUEUED;
+            return LRM_OK;
+        }
+        for (const auto& result : finished) {
+            if (result.id != id) continue;
+            *status = result.status;
+            return LRM_OK;
+        }
+        return LRM_ERR_NOT_FOUND;
+    }
+
+    // Cancels one transfer, or all of them for id 0. Returns LRM_OK, or
+    // LRM_ERR_NOT_FOUND if no such transfer is queued or being sent.
+    int32_t cancel(uint64_t id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        bool found = false;
+        for (auto it = transfers.begin(); it != transfers.end();) {
+            if (id != 0 && it->id != id) {
+                ++it;
+                continue;
+            }
+            found = true;
+            if (it == transfers.begin()) {
+                // The worker may be sending from it; it finishes it
+                it->cancelled = true;
+                ++it;
+            } else {
+                finish(*it, LRM_SYSEX_TX_CANCELLED);
+                it = transfers.erase(it);
+            }
+        }
+        if (found) cv.notify_one();
+        return found ? LRM_OK : LRM_ERR_NOT_FOUND;
+    }
+
+private:
+    // Finished transfers whose state can still be read
+    static constexpr size_t kHistory = 64;
+
+    struct Transfer {
+        uint64_t id = 0;
+        std::vector<uint8_t> data;
+        size_t chunk_size = 0;
+        int64_t delay_ns = 0;
+        double ns_per_byte = 0.0;
+        size_t sent = 0;
+        size_t message_end = 0;  // End of the message being sent
+        bool cancelled = false;
+    };
+
+    struct Result {
+        uint64_t id;
+        LrmSysexTransferStatus status;
+    };
+
+    void finish(const Transfer& transfer, int32_t state) {
+        Result result{transfer.id, {}};
+        result.status.bytes_sent = transfer.sent;
+        result.status.bytes_total = transfer.data.size();
+        result.status.state = state;
+        finished.push_back(result);
+        if (finished.size() > kHistory) finished.pop_front();
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        int64_t next_send = 0;  // Earliest time for the next piece
+        int64_t rate_free = 0;  // When the byte budget allows the next piece
+
+        while (!(stopping && transfers.empty())) {
+            if (transfers.empty()) {
+                cv.wait(lock);
+                continue;
+            }
+
+            Transfer& transfer = transfers.front();
+            const bool mid_message = transfer.sent != transfer.message_end;
+            if (transfer.cancelled) {
+                if (mid_message) {
+                    static const uint8_t kEox = 0xF7;
+                    lock.unlock();
+                    sink(&kEox, 1, true);
+                    lock.lock();
+                }
+                finish(transfer, LRM_SYSEX_TX_CANCELLED);
+                transfers.pop_front();
+                continue;
+            }
+
+            const int64_t now = nowNs();
+            if (now < next_send) {
+                cv.wait_until(lock, clock::time_point(std::chrono::nanoseconds(next_send)));
+                continue;
+            }
+
+            if (!mid_message) {
+                const auto eox = std::find(transfer.data.begin() + transfer.sent,
+                                           transfer.data.end(), 0xF7);
+                transfer.message_end = std::min<size_t>(
+                    eox - transfer.data.begin() + 1, transfer.data.size());
+            }
+            const size_t offset = transfer.sent;
+            const size_t length = std::min(transfer.chunk_size, transfer.message_end - offset);
+            const bool last = offset + length == transfer.message_end;
+
+            // Only the worker modifies the front transfer's data, so it can
+            // be read without the lock
+            lock.unlock();
+            bool ok = false;
+            try {
+                ok = sink(transfer.data.data() + offset, length, last);
+            } catch (...) {
+            }
+            lock.lock();
+
+            if (transfer.ns_per_byte != 0.0) {
+                rate_free = std::max(rate_free, now)
+                    + static_cast<int64_t>(static_cast<double>(length) * transfer.ns_per_byte);
+            }
+            next_send = std::max(nowNs() + transfer.delay_ns, rate_free);
+
+            if (!ok) {
+                if (!last) {
+                    static const uint8_t kEox = 0xF7;
+                    lock.unlock();
+                    sink(&kEox, 1, true);
+                    lock.lock();
+                }
+                finish(transfer, LRM_SYSEX_TX_FAILED);
+                transfers.pop_front();
+                continue;
+            }
+            transfer.sent += length;
+            if (transfer.sent == transfer.data.size()) {
+                finish(transfer, LRM_SYSEX_TX_DONE);
+                transfers.pop_front();
+            }
+        }
+    }
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            clock::now().time_since_epoch()).count();
+    }
+
+    const ChunkSink sink;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::list<Transfer> transfers;  // Front is being sent; a list keeps it in place
+    std::deque<Result> finished;
+    uint64_t last_id = 0;
+    bool stopping = false;
+
+    std::thread worker;  // Last: starts running in the constructor
+};
+
+#endif // LRM_SYSEX_TRANSMITTER_HPP
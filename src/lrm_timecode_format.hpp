@@ -0,0 +1,141 @@
+// SMPTE positions as used by MIDI Time Code: conversion between
+// hours:minutes:seconds:frames and a frame count, and the quarter-frame and
+// full-frame encodings.
+//
+// 29.97 fps is drop-frame: frame numbers 0 and 1 are skipped at the start of
+// every minute except each tenth, so the timecode keeps pace with the clock.
+
+#ifndef LRM_TIMECODE_FORMAT_HPP
+#define LRM_TIMECODE_FORMAT_HPP
+
+#include "libremidi_flutter.h"
+
+#include <cstdint>
+
+class LrmTimecodeFormat {
+public:
+    static bool validRate(int32_t rate) {
+        return rate >= LRM_MTC_24FPS && rate <= LRM_MTC_30FPS;
+    }
+
+    // Nominal frames per second, as counted by the frames field
+    static int32_t nominalFps(int32_t rate) {
+        switch (rate) {
+            case LRM_MTC_24FPS: return 24;
+            case LRM_MTC_25FPS: return 25;
+            default: return 30;
+        }
+    }
+
+    // Actual frames per second
+    static double realFps(int32_t rate) {
+        return rate == LRM_MTC_30FPS_DROP ? 30000.0 / 1001.0 : nominalFps(rate);
+    }
+
+    static int64_t framesPerDay(int32_t rate) {
+        return rate == LRM_MTC_30FPS_DROP ? 24 * 6 * kDropFramesPer10Min
+                                          : int64_t{86400} * nominalFps(rate);
+    }
+
+    static bool valid(const LrmTimecode& tc) {
+        if (!validRate(tc.rate)) return false;
+        if (tc.hours < 0 || tc.hours > 23 || tc.minutes < 0 || tc.minutes > 59
+            || tc.seconds < 0 || tc.seconds > 59 || tc.frames < 0
+            || tc.frames >= nominalFps(tc.rate)) {
+            return false;
+        }
+        // Frames 0 and 1 do not exist in dropped minutes
+        return !(tc.rate == LRM_MTC_30FPS_DROP && tc.seconds == 0 && tc.frames < 2
+                 && tc.minutes % 10 != 0);
+    }
+
+    static int64_t toFrames(const LrmTimecode& tc) {
+        const int64_t fps = nominalFps(tc.rate);
+        int64_t frames = ((int64_t{tc.hours} * 3600 + tc.minutes * 60 + tc.seconds) * fps) + tc.frames;
+        if (tc.rate == LRM_MTC_30FPS_DROP) {
+            const int64_t minutes = int64_t{tc.hours} * 60 + tc.minutes;
+            frames -= 2 * (minutes - minutes / 10);
+        }
+        return frames;
+    }
+
+    // Fills the position fields of tc (its rate must be set)
+    static void fromFrames(int64_t frames, LrmTimecode* tc) {
+        const int64_t per_day = framesPerDay(tc->rate);
+        frames %= per_day;
+        if (frames < 0) frames += per_day;
+        if (tc->rate == LRM_MTC_30FPS_DROP) {
+            // Add back the frame numbers skipped so far
+            const int64_t tens = frames / kDropFramesPer10Min;
+            int64_t rest = frames % kDropFramesPer10Min;
+            if (rest < 2) rest += 2;
+            frames += 18 * tens + 2 * ((rest - 2) / kDropFramesPerMinute);
+        }
+        const int64_t fps = nominalFps(tc->rate);
+        tc->frames = static_cast<int32_t>(frames % fps);
+        const int64_t seconds = frames / fps;
+        tc->seconds = static_cast<int32_t>(seconds % 60);
+        tc->minutes = static_cast<int32_t>((seconds / 60) % 60);
+        tc->hours = static_cast<int32_t>(seconds / 3600);
+    }
+
+    // Data byte of quarter-frame piece 0-7 (the message is F1 <byte>)
+    static uint8_t quarterFrame(const LrmTimecode& tc, int32_t piece) {
+        int32_t nibble = 0;
+        switch (piece) {
+            case 0: nibble = tc.frames & 0x0F; break;
+            case 1: nibble = (tc.frames >> 4) & 0x01; break;
+            case 2: nibble = tc.seconds & 0x0F; break;
+            case 3: nibble = (tc.seconds >> 4) & 0x03; break;
+            case 4: nibble = tc.minutes & 0x0F; break;
+            case 5: nibble = (tc.minutes >> 4) & 0x03; break;
+            case 6: nibble = tc.hours & 0x0F; break;
+            default: nibble = ((tc.hours >> 4) & 0x01) | (tc.rate << 1); break;
+        }
+        return static_cast<uint8_t>((piece << 4) | nibble);
+    }
+
+    // The low nibbles of pieces 0-7, in order
+    static void fromQuarterFrames(const uint8_t nibbles[8], LrmTimecode* tc) {
+        tc->frames = nibbles[0] | ((nibbles[1] & 0x01) << 4);
+        tc->seconds = nibbles[2] | ((nibbles[3] & 0x03) << 4);
+        tc->minutes = nibbles[4] | ((nibbles[5] & 0x03) << 4);
+        tc->hours = nibbles[6] | ((nibbles[7] & 0x01) << 4);
+        tc->rate = (nibbles[7] >> 1) & 0x03;
+    }
+
+    // Full-frame SysEx (F0 7F 7F 01 01 hh mm ss ff F7), sent to locate
+    static constexpr size_t kFullFrameSize = 10;
+
+    static void fullFrame(const LrmTimecode& tc, uint8_t* out) {
+        out[0] = 0xF0;
+        out[1] = 0x7F;
+        out[2] = 0x7F;  // All devices
+        out[3] = 0x01;
+        out[4] = 0x01;
+        out[5] = static_cast<uint8_t>((tc.rate << 5) | tc.hours);
+        out[6] = static_cast<uint8_t>(tc.minutes);
+        out[7] = static_cast<uint8_t>(tc.seconds);
+        out[8] = static_cast<uint8_t>(tc.frames);
+        out[9] = 0xF7;
+    }
+
+    static bool parseFullFrame(const uint8_t* data, size_t length, LrmTimecode* tc) {
+        if (length != kFullFrameSize || data[0] != 0xF0 || data[1] != 0x7F
+            || data[3] != 0x01 || data[4] != 0x01 || data[9] != 0xF7) {
+            return false;
+        }
+        tc->rate = (data[5] >> 5) & 0x03;
+        tc->hours = data[5] & 0x1F;
+        tc->minutes = data[6] & 0x3F;
+        tc->seconds = data[7] & 0x3F;
+        tc->frames = data[8] & 0x1F;
+        return valid(*tc);
+    }
+
+private:
+    static constexpr int64_t kDropFramesPerMinute = 30 * 60 - 2;
+    static constexpr int64_t kDropFramesPer10Min = 10 * kDropFramesPerMinute + 2;
+};
+
+#endif // LRM_TIMECODE_FORMAT_HPP
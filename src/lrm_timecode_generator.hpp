@@ -0,0 +1,116 @@
+// Sends MIDI Time Code quarter frames from its own thread.
+//
+// Four quarter frames go out per frame (96 to 120 per second), each due at
+// an absolute time computed from the start, start + n / (4 * fps), so the
+// timecode does not drift from the wall clock; 29.97 fps drop-frame runs at
+// 30000/1001 frames per second. Each sequence of eight pieces carries the
+// frame at its first piece. Starting sends a full-frame message first so
+// receivers locate before the quarter frames arrive.
+
+#ifndef LRM_TIMECODE_GENERATOR_HPP
+#define LRM_TIMECODE_GENERATOR_HPP
+
+#include "libremidi_flutter.h"
+
+#include "lrm_deadline_timer.hpp"
+#include "lrm_timecode_format.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+class LrmTimecodeGenerator {
+public:
+    using MessageSink = std::function<void(const uint8_t*, size_t)>;
+
+    explicit LrmTimecodeGenerator(MessageSink message_sink)
+        : sink(std::move(message_sink)),
+          worker([this] { run(); })
+    {
+    }
+
+    ~LrmTimecodeGenerator() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        timer.wake();
+        worker.join();
+    }
+
+    // from must be valid (LrmTimecodeFormat::valid)
+    void start(const LrmTimecode& from) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            rate = from.rate;
+            start_position = LrmTimecodeFormat::toFrames(from) * 4;
+            sent = 0;
+            interval_ns = 1e9 / (LrmTimecodeFormat::realFps(rate) * 4);
+            uint8_t locate[LrmTimecodeFormat::kFullFrameSize];
+            LrmTimecodeFormat::fullFrame(from, locate);
+            sink(locate, sizeof(locate));
+            start_ns = LrmDeadlineTimer::now();
+            running = true;
+        }
+        timer.wake();
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+
+    void getState(LrmTimecode* state) {
+        std::lock_guard<std::mutex> lock(mutex);
+        state->rate = rate;
+        LrmTimecodeFormat::fromFrames((start_position + sent) / 4, state);
+        state->locked = running;
+        state->quarter_frames = quarter_frames;
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            if (!running) {
+                timer.waitUntil(lock, nullptr);
+                continue;
+            }
+            const int64_t due = start_ns + std::llround(static_cast<double>(sent) * interval_ns);
+            if (due > LrmDeadlineTimer::now()) {
+                timer.waitUntil(lock, &due);
+                continue;
+            }
+
+            const int32_t piece = static_cast<int32_t>(sent % 8);
+            if (piece == 0) {
+                sequence.rate = rate;
+                LrmTimecodeFormat::fromFrames((start_position + sent) / 4, &sequence);
+            }
+            const uint8_t message[2] = {0xF1, LrmTimecodeFormat::quarterFrame(sequence, piece)};
+            sink(message, sizeof(message));
+            sent++;
+            quarter_frames++;
+        }
+    }
+
+    const MessageSink sink;
+
+    std::mutex mutex;
+    LrmDeadlineTimer timer;
+    int32_t rate = LRM_MTC_25FPS;
+    double interval_ns = 0.0;
+    int64_t start_ns = 0;
+    int64_t start_position = 0;  // In quarter frames
+    int64_t sent = 0;            // Quarter frames since start
+    LrmTimecode sequence{};      // Position carried by the current sequence
+    uint64_t quarter_frames = 0;
+    bool running = false;
+    bool stopping = false;
+
+    std::thread worker;  // Last: starts running in the constructor
+};
+
+#endif // LRM_TIMECODE_GENERATOR_HPP
@@ -0,0 +1,101 @@
+// Follows incoming MIDI Time Code and keeps the current SMPTE position.
+//
+// Quarter-frame messages (F1) carry the position in eight pieces spread over
+// two frames. Once a complete sequence 0-7 has arrived in order the reader is
+// locked; from then on every quarter frame advances the position by a
+// quarter of a frame, and each completed sequence re-synchronises it. The
+// two frames the sequence took to arrive are accounted for, so the reported
+// frame is the one currently playing. A piece out of order (the source
+// jumped or plays backwards) or no quarter frame for kTimeout unlocks it.
+//
+// Full-frame SysEx messages locate the position without locking.
+// Updated on the backend thread and polled from any thread.
+
+#ifndef LRM_TIMECODE_READER_HPP
+#define LRM_TIMECODE_READER_HPP
+
+#include "libremidi_flutter.h"
+
+#include "lrm_timecode_format.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+class LrmTimecodeReader {
+public:
+    using clock = std::chrono::steady_clock;
+
+    // Backend thread. Returns true for quarter-frame messages.
+    bool process(const uint8_t* data, size_t length) {
+        if (length == 2 && data[0] == 0xF1) {
+            onQuarterFrame(data[1], clock::now());
+            return true;
+        }
+        if (length == LrmTimecodeFormat::kFullFrameSize && data[0] == 0xF0) {
+            LrmTimecode located{};
+            if (LrmTimecodeFormat::parseFullFrame(data, length, &located)) {
+                std::lock_guard<std::mutex> lock(mutex);
+                rate = located.rate;
+                position = LrmTimecodeFormat::toFrames(located) * 4;
+                locked = false;
+                sequence_valid = false;
+            }
+        }
+        return false;
+    }
+
+    void getState(LrmTimecode* state) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        state->rate = rate;
+        LrmTimecodeFormat::fromFrames(position / 4, state);
+        state->locked = locked && clock::now() - last_quarter_frame < kTimeout;
+        state->quarter_frames = quarter_frames;
+    }
+
+private:
+    // About ten quarter frames at 24 fps
+    static constexpr auto kTimeout = std::chrono::milliseconds(100);
+
+    void onQuarterFrame(uint8_t value, clock::time_point now) {
+        const int32_t piece = (value >> 4) & 0x07;
+        std::lock_guard<std::mutex> lock(mutex);
+        quarter_frames++;
+
+        const bool in_order = piece == next_piece && now - last_quarter_frame < kTimeout;
+        last_quarter_frame = now;
+        if (!in_order) locked = false;
+        if (piece == 0) {
+            sequence_valid = true;
+        } else if (!in_order) {
+            sequence_valid = false;
+        }
+        next_piece = (piece + 1) & 0x07;
+        nibbles[piece] = value & 0x0F;
+        if (locked) position++;
+
+        if (piece == 7 && sequence_valid) {
+            // The sequence encodes the frame at piece 0; piece 7 is the last
+            // quarter of the frame after it
+            LrmTimecode received{};
+            LrmTimecodeFormat::fromQuarterFrames(nibbles, &received);
+            if (LrmTimecodeFormat::valid(received)) {
+                rate = received.rate;
+                position = LrmTimecodeFormat::toFrames(received) * 4 + 7;
+                locked = true;
+            }
+        }
+    }
+
+    mutable std::mutex mutex;
+    clock::time_point last_quarter_frame{};
+    uint8_t nibbles[8] = {};
+    int32_t next_piece = 0;
+    bool sequence_valid = false;
+    bool locked = false;
+    int32_t rate = LRM_MTC_25FPS;
+    int64_t position = 0;  // In quarter frames
+    uint64_t quarter_frames = 0;
+};
+
+#endif // LRM_TIMECODE_READER_HPP
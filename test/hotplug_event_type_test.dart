@@ -29,4 +29,31 @@ void main() {
       expect(HotplugEventType.fromValue(99), HotplugEventType.unknown);
     });
   });
+
+  group('HotplugEvent', () {
+    test('hasPort is false without a port id', () {
+      expect(
+        const HotplugEvent(HotplugEventType.setupChanged, 0).hasPort,
+        isFalse,
+      );
+      expect(
+        const HotplugEvent(HotplugEventType.inputAdded, 42).hasPort,
+        isTrue,
+      );
+    });
+
+    test('fromNative keeps the type and port id', () {
+      final event = HotplugEvent.fromNative(2, 17)!;
+      expect(event.type, HotplugEventType.outputAdded);
+      expect(event.portId, 17);
+    });
+
+    test('fromNative consumes the startAsync ready notification', () {
+      expect(HotplugEvent.fromNative(5, 0), isNull);
+    });
+
+    test('fromNative maps other values to unknown', () {
+      expect(HotplugEvent.fromNative(99, 3)!.type, HotplugEventType.unknown);
+    });
+  });
 }
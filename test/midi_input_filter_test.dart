@@ -0,0 +1,57 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:libremidi_flutter/libremidi_flutter.dart';
+
+void main() {
+  group('MidiMessageKind', () {
+    test('native values follow the LRM_FILTER_* bit order', () {
+      expect(MidiMessageKind.noteOff.nativeValue, 1);
+      expect(MidiMessageKind.noteOn.nativeValue, 2);
+      expect(MidiMessageKind.polyAftertouch.nativeValue, 4);
+      expect(MidiMessageKind.controlChange.nativeValue, 8);
+      expect(MidiMessageKind.programChange.nativeValue, 16);
+      expect(MidiMessageKind.channelPressure.nativeValue, 32);
+      expect(MidiMessageKind.pitchBend.nativeValue, 64);
+      expect(MidiMessageKind.sysEx.nativeValue, 128);
+      expect(MidiMessageKind.systemCommon.nativeValue, 256);
+      expect(MidiMessageKind.realtime.nativeValue, 512);
+    });
+  });
+
+  group('MidiInputFilter', () {
+    test('default filter accepts everything', () {
+      const filter = MidiInputFilter();
+      expect(filter.channelMask, 0xFFFF);
+      expect(filter.statusMask, 1023);
+    });
+
+    test('channel mask sets one bit per channel', () {
+      const filter = MidiInputFilter(channels: {0, 9, 15});
+      expect(filter.channelMask, 0x8201);
+    });
+
+    test('invalid channel throws', () {
+      const filter = MidiInputFilter(channels: {16});
+      expect(() => filter.channelMask, throwsArgumentError);
+    });
+
+    test('status mask combines kinds', () {
+      const filter = MidiInputFilter(
+        kinds: {MidiMessageKind.noteOn, MidiMessageKind.noteOff},
+      );
+      expect(filter.statusMask, 3);
+    });
+  });
+
+  group('MidiFilterStats', () {
+    test('total sums all criteria', () {
+      const stats = MidiFilterStats(
+        rejectedKind: 1,
+        rejectedChannel: 2,
+        rejectedNote: 3,
+        rejectedController: 4,
+        rejectedSize: 5,
+      );
+      expect(stats.total, 15);
+    });
+  });
+}
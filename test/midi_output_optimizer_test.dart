@@ -0,0 +1,59 @@
+import 'dart:ffi';
+
+import 'package:ffi/ffi.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:libremidi_flutter/libremidi_flutter.dart';
+import 'package:libremidi_flutter/libremidi_flutter_bindings_generated.dart';
+
+void main() {
+  group('MidiOutputOptimizer.fill', () {
+    late Pointer<LrmMidiOptimizer> settings;
+
+    setUp(() => settings = calloc<LrmMidiOptimizer>());
+    tearDown(() => calloc.free(settings));
+
+    test('default drops duplicates without coalescing or pacing', () {
+      const MidiOutputOptimizer().fill(settings.ref);
+      expect(settings.ref.drop_duplicates, isTrue);
+      expect(settings.ref.coalesce_interval_us, 0);
+      expect(settings.ref.max_bytes_per_second, 0);
+    });
+
+    test('coalescing interval is written in microseconds', () {
+      const MidiOutputOptimizer(
+        dropDuplicates: false,
+        coalesceInterval: Duration(milliseconds: 5),
+        maxBytesPerSecond: 3125,
+      ).fill(settings.ref);
+      expect(settings.ref.drop_duplicates, isFalse);
+      expect(settings.ref.coalesce_interval_us, 5000);
+      expect(settings.ref.max_bytes_per_second, 3125);
+    });
+
+    test('values too large for the native fields are clamped', () {
+      const MidiOutputOptimizer(
+        coalesceInterval: Duration(hours: 2),
+        maxBytesPerSecond: 1 << 40,
+      ).fill(settings.ref);
+      expect(settings.ref.coalesce_interval_us, 0xFFFFFFFF);
+      expect(settings.ref.max_bytes_per_second, 0xFFFFFFFF);
+    });
+
+    test('negative byte rate throws', () {
+      expect(
+        () => const MidiOutputOptimizer(maxBytesPerSecond: -1)
+            .fill(settings.ref),
+        throwsArgumentError,
+      );
+    });
+
+    test('negative coalescing interval throws', () {
+      expect(
+        () => const MidiOutputOptimizer(
+          coalesceInterval: Duration(milliseconds: -1),
+        ).fill(settings.ref),
+        throwsArgumentError,
+      );
+    });
+  });
+}
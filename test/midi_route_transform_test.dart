@@ -0,0 +1,102 @@
+import 'dart:ffi';
+
+import 'package:ffi/ffi.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:libremidi_flutter/libremidi_flutter.dart';
+import 'package:libremidi_flutter/libremidi_flutter_bindings_generated.dart';
+
+void main() {
+  group('MidiRouteTransform.fill', () {
+    late Pointer<LrmRouteTransform> settings;
+
+    setUp(() {
+      // Same defaults as lrm_route_transform_init
+      settings = calloc<LrmRouteTransform>();
+      settings.ref
+        ..filter.status_mask = LRM_FILTER_ALL
+        ..filter.channel_mask = 0xFFFF
+        ..transpose = 0
+        ..velocity_scale = 1.0;
+      for (var channel = 0; channel < 16; channel++) {
+        settings.ref.channel_map[channel] = channel;
+      }
+    });
+
+    tearDown(() => calloc.free(settings));
+
+    test('default transform keeps the defaults', () {
+      const MidiRouteTransform().fill(settings.ref);
+      for (var channel = 0; channel < 16; channel++) {
+        expect(settings.ref.channel_map[channel], channel);
+      }
+      expect(settings.ref.transpose, 0);
+      expect(settings.ref.velocity_scale, 1.0);
+      expect(settings.ref.filter.status_mask, LRM_FILTER_ALL);
+    });
+
+    test('remaps only the listed channels', () {
+      const MidiRouteTransform(channelMap: {0: 9, 15: 3}).fill(settings.ref);
+      expect(settings.ref.channel_map[0], 9);
+      expect(settings.ref.channel_map[15], 3);
+      expect(settings.ref.channel_map[1], 1);
+      expect(settings.ref.channel_map[14], 14);
+    });
+
+    test('writes transpose, velocity scale and filter', () {
+      const MidiRouteTransform(
+        filter: MidiInputFilter(
+          channels: {2},
+          kinds: {MidiMessageKind.noteOn, MidiMessageKind.noteOff},
+          minNote: 36,
+          maxNote: 72,
+        ),
+        transpose: -12,
+        velocityScale: 0.5,
+      ).fill(settings.ref);
+
+      expect(settings.ref.transpose, -12);
+      expect(settings.ref.velocity_scale, 0.5);
+      expect(settings.ref.filter.channel_mask, 1 << 2);
+      expect(
+        settings.ref.filter.status_mask,
+        LRM_FILTER_NOTE_ON | LRM_FILTER_NOTE_OFF,
+      );
+      expect(settings.ref.filter.note_min, 36);
+      expect(settings.ref.filter.note_max, 72);
+    });
+
+    test('transpose outside -127..127 throws', () {
+      expect(
+        () => const MidiRouteTransform(transpose: 128).fill(settings.ref),
+        throwsRangeError,
+      );
+      expect(
+        () => const MidiRouteTransform(transpose: -128).fill(settings.ref),
+        throwsRangeError,
+      );
+    });
+
+    test('negative or NaN velocity scale throws', () {
+      expect(
+        () => const MidiRouteTransform(velocityScale: -1).fill(settings.ref),
+        throwsArgumentError,
+      );
+      expect(
+        () => const MidiRouteTransform(velocityScale: double.nan)
+            .fill(settings.ref),
+        throwsArgumentError,
+      );
+    });
+
+    test('channels outside 0-15 throw', () {
+      expect(
+        () => const MidiRouteTransform(channelMap: {16: 0}).fill(settings.ref),
+        throwsRangeError,
+      );
+      expect(
+        () => const MidiRouteTransform(channelMap: {0: -1}).fill(settings.ref),
+        throwsRangeError,
+      );
+    });
+  });
+}
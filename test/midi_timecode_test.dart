@@ -0,0 +1,93 @@
+import 'dart:ffi';
+
+import 'package:ffi/ffi.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:libremidi_flutter/libremidi_flutter.dart';
+import 'package:libremidi_flutter/libremidi_flutter_bindings_generated.dart';
+
+void main() {
+  group('MidiTimecodeRate', () {
+    test('native values follow the MTC rate bits', () {
+      expect(MidiTimecodeRate.fps24.nativeValue, LRM_MTC_24FPS);
+      expect(MidiTimecodeRate.fps25.nativeValue, LRM_MTC_25FPS);
+      expect(MidiTimecodeRate.fps2997Drop.nativeValue, LRM_MTC_30FPS_DROP);
+      expect(MidiTimecodeRate.fps30.nativeValue, LRM_MTC_30FPS);
+    });
+
+    test('fromNative round-trips every rate', () {
+      for (final rate in MidiTimecodeRate.values) {
+        expect(MidiTimecodeRate.fromNative(rate.nativeValue), rate);
+      }
+    });
+
+    test('drop-frame counts 30 frames per second', () {
+      expect(MidiTimecodeRate.fps24.framesPerSecond, 24);
+      expect(MidiTimecodeRate.fps25.framesPerSecond, 25);
+      expect(MidiTimecodeRate.fps2997Drop.framesPerSecond, 30);
+      expect(MidiTimecodeRate.fps30.framesPerSecond, 30);
+    });
+  });
+
+  group('MidiTimecode', () {
+    test('formats as HH:MM:SS:FF', () {
+      const timecode = MidiTimecode(
+        hours: 1,
+        minutes: 2,
+        seconds: 3,
+        frames: 4,
+        rate: MidiTimecodeRate.fps25,
+      );
+      expect(timecode.toString(), '01:02:03:04');
+    });
+
+    test('drop-frame uses a semicolon before the frames', () {
+      const timecode = MidiTimecode(
+        hours: 23,
+        minutes: 59,
+        seconds: 59,
+        frames: 29,
+        rate: MidiTimecodeRate.fps2997Drop,
+      );
+      expect(timecode.toString(), '23:59:59;29');
+    });
+  });
+
+  group('MidiTimecode native conversion', () {
+    late Pointer<LrmTimecode> native;
+
+    setUp(() => native = calloc<LrmTimecode>());
+    tearDown(() => calloc.free(native));
+
+    test('fill writes the position and rate', () {
+      const MidiTimecode(
+        hours: 10,
+        minutes: 20,
+        seconds: 30,
+        frames: 23,
+        rate: MidiTimecodeRate.fps24,
+      ).fill(native.ref);
+      expect(native.ref.hours, 10);
+      expect(native.ref.minutes, 20);
+      expect(native.ref.seconds, 30);
+      expect(native.ref.frames, 23);
+      expect(native.ref.rate, LRM_MTC_24FPS);
+    });
+
+    test('fromNative reads lock state and quarter frames', () {
+      native.ref
+        ..hours = 5
+        ..minutes = 6
+        ..seconds = 7
+        ..frames = 8
+        ..rate = LRM_MTC_30FPS_DROP
+        ..locked = true
+        ..quarter_frames = 1234;
+
+      final timecode = MidiTimecode.fromNative(native.ref);
+      expect(timecode.toString(), '05:06:07;08');
+      expect(timecode.rate, MidiTimecodeRate.fps2997Drop);
+      expect(timecode.isLocked, isTrue);
+      expect(timecode.quarterFrames, 1234);
+    });
+  });
+}
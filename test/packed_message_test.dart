@@ -0,0 +1,77 @@
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:libremidi_flutter/libremidi_flutter.dart';
+
+/// Builds packed records the same way the native ring buffer does.
+Uint8List pack(List<(int, List<int>)> records) {
+  final builder = BytesBuilder();
+  for (final (timestamp, data) in records) {
+    final header = ByteData(12)
+      ..setInt64(0, timestamp, Endian.host)
+      ..setUint32(8, data.length, Endian.host);
+    builder.add(header.buffer.asUint8List());
+    builder.add(data);
+  }
+  return builder.toBytes();
+}
+
+void main() {
+  group('MidiMessage.decodePacked', () {
+    test('empty buffer yields no messages', () {
+      expect(MidiMessage.decodePacked(Uint8List(0)), isEmpty);
+    });
+
+    test('decodes consecutive records with timestamps', () {
+      final packed = pack([
+        (100, [0x90, 60, 100]),
+        (200, [0xC0, 5]),
+        (300, [0xF8]),
+      ]);
+
+      final messages = MidiMessage.decodePacked(packed);
+      expect(messages, hasLength(3));
+      expect(messages[0].data, [0x90, 60, 100]);
+      expect(messages[0].timestamp, 100);
+      expect(messages[1].data, [0xC0, 5]);
+      expect(messages[1].timestamp, 200);
+      expect(messages[2].data, [0xF8]);
+      expect(messages[2].timestamp, 300);
+    });
+
+    test('decodes SysEx records of arbitrary length', () {
+      final sysex = [0xF0, ...List.filled(300, 0x11), 0xF7];
+      final messages = MidiMessage.decodePacked(pack([(7, sysex)]));
+      expect(messages.single.isSysEx, isTrue);
+      expect(messages.single.data, sysex);
+    });
+
+    test('ignores a truncated trailing record', () {
+      final packed = pack([
+        (1, [0xB0, 7, 64]),
+        (2, [0xB0, 7, 65]),
+      ]);
+      final truncated = Uint8List.sublistView(packed, 0, packed.length - 1);
+
+      final messages = MidiMessage.decodePacked(truncated);
+      expect(messages, hasLength(1));
+      expect(messages.single.value, 64);
+    });
+
+    test('decoded data does not alias the packed buffer', () {
+      final packed = pack([
+        (1, [0x90, 60, 100]),
+      ]);
+      final message = MidiMessage.decodePacked(packed).single;
+      packed.fillRange(0, packed.length, 0);
+      expect(message.data, [0x90, 60, 100]);
+    });
+  });
+
+  group('MidiOverflowPolicy', () {
+    test('maps to native constants', () {
+      expect(MidiOverflowPolicy.dropOldest.nativeValue, 0);
+      expect(MidiOverflowPolicy.dropNewest.nativeValue, 1);
+    });
+  });
+}
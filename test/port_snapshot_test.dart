@@ -0,0 +1,168 @@
+import 'dart:convert';
+import 'dart:ffi';
+import 'dart:typed_data';
+
+import 'package:ffi/ffi.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:libremidi_flutter/libremidi_flutter.dart';
+import 'package:libremidi_flutter/libremidi_flutter_bindings_generated.dart';
+
+/// Builds a string table the way the native snapshot does: offset 0 is the
+/// empty string and each distinct string is stored once.
+(Uint8List, Map<String, int>) stringTable(List<String> strings) {
+  final builder = BytesBuilder()..addByte(0);
+  final offsets = <String, int>{'': 0};
+  for (final string in strings) {
+    if (offsets.containsKey(string)) continue;
+    offsets[string] = builder.length;
+    builder
+      ..add(utf8.encode(string))
+      ..addByte(0);
+  }
+  return (builder.toBytes(), offsets);
+}
+
+/// Names of one record, looked up in the string table.
+typedef PortNames = ({
+  String displayName,
+  String manufacturer,
+  String serial,
+});
+
+void main() {
+  group('MidiPortSnapshot.fromNative', () {
+    late Pointer<LrmPortSnapshot> snapshot;
+    late Pointer<LrmPortRecord> records;
+    late Pointer<Uint8> strings;
+
+    /// Lays out a snapshot in calloc'd memory, inputs first.
+    LrmPortSnapshot build({
+      required int generation,
+      required List<PortNames> inputs,
+      required List<PortNames> outputs,
+    }) {
+      final ports = [...inputs, ...outputs];
+      final (table, offsets) = stringTable([
+        for (final names in ports) ...[
+          names.displayName,
+          names.manufacturer,
+          names.serial,
+        ],
+      ]);
+
+      strings = calloc<Uint8>(table.length);
+      strings.asTypedList(table.length).setAll(0, table);
+      records = calloc<LrmPortRecord>(ports.length);
+      for (var i = 0; i < ports.length; i++) {
+        final isInput = i < inputs.length;
+        records[i]
+          ..stable_id = 1000 + i
+          ..port_id = 10 + i
+          ..client_handle = 7
+          ..display_name = offsets[ports[i].displayName]!
+          ..manufacturer = offsets[ports[i].manufacturer]!
+          ..serial = offsets[ports[i].serial]!
+          ..index = isInput ? i : i - inputs.length
+          ..transport_type = 16
+          ..is_input = isInput
+          ..is_virtual = false;
+      }
+      snapshot = calloc<LrmPortSnapshot>();
+      snapshot.ref
+        ..generation = generation
+        ..input_count = inputs.length
+        ..output_count = outputs.length
+        ..strings_size = table.length
+        ..ports = records
+        ..strings = strings.cast();
+      return snapshot.ref;
+    }
+
+    tearDown(() {
+      calloc.free(snapshot);
+      calloc.free(records);
+      calloc.free(strings);
+    });
+
+    test('splits records into inputs and outputs', () {
+      final decoded = MidiPortSnapshot.fromNative(build(
+        generation: 42,
+        inputs: [
+          (displayName: 'Keys In', manufacturer: 'Acme', serial: 'A1'),
+          (displayName: 'Pads In', manufacturer: 'Acme', serial: 'B2'),
+        ],
+        outputs: [
+          (displayName: 'Keys Out', manufacturer: 'Acme', serial: 'A1'),
+        ],
+      ));
+
+      expect(decoded.generation, 42);
+      expect(decoded.inputs.map((port) => port.displayName),
+          ['Keys In', 'Pads In']);
+      expect(decoded.outputs.single.displayName, 'Keys Out');
+      expect(decoded.inputs.every((port) => port.isInput), isTrue);
+      expect(decoded.outputs.single.isInput, isFalse);
+      expect(decoded.outputs.single.index, 0);
+      expect(decoded.outputs.single.portId, 12);
+      expect(decoded.inputs[1].stableId, 1001);
+      expect(decoded.inputs[1].transportType, MidiTransportType.usb);
+    });
+
+    test('offset 0 decodes as the empty string', () {
+      final decoded = MidiPortSnapshot.fromNative(build(
+        generation: 1,
+        inputs: [(displayName: 'Synth', manufacturer: '', serial: '')],
+        outputs: [],
+      ));
+
+      final port = decoded.inputs.single;
+      expect(port.manufacturer, isEmpty);
+      expect(port.serial, isEmpty);
+      expect(port.portName, isEmpty);
+      expect(port.product, isEmpty);
+    });
+
+    test('shared offsets decode to the same string', () {
+      final decoded = MidiPortSnapshot.fromNative(build(
+        generation: 3,
+        inputs: [
+          (displayName: 'Keys In', manufacturer: 'Acme', serial: 'A1'),
+        ],
+        outputs: [
+          (displayName: 'Keys Out', manufacturer: 'Acme', serial: 'A1'),
+        ],
+      ));
+
+      final input = decoded.inputs.single;
+      final output = decoded.outputs.single;
+      expect(records[0].manufacturer, records[1].manufacturer);
+      expect(identical(input.manufacturer, output.manufacturer), isTrue);
+      expect(identical(input.serial, output.serial), isTrue);
+      expect(input.serial, 'A1');
+    });
+
+    test('decodes UTF-8 names', () {
+      final decoded = MidiPortSnapshot.fromNative(build(
+        generation: 5,
+        inputs: [],
+        outputs: [
+          (displayName: 'Flügel Ωmega', manufacturer: 'Ÿamaha', serial: ''),
+        ],
+      ));
+
+      expect(decoded.inputs, isEmpty);
+      expect(decoded.outputs.single.displayName, 'Flügel Ωmega');
+      expect(decoded.outputs.single.manufacturer, 'Ÿamaha');
+    });
+
+    test('port lists are unmodifiable', () {
+      final decoded = MidiPortSnapshot.fromNative(build(
+        generation: 1,
+        inputs: [(displayName: 'In', manufacturer: '', serial: '')],
+        outputs: [],
+      ));
+
+      expect(() => decoded.inputs.clear(), throwsUnsupportedError);
+    });
+  });
+}
@@ -187,4 +187,33 @@ void main() {
           parser.process(MidiMessage(Uint8List.fromList([0xB0, 6]))), isNull);
     });
   });
+
+  group('MidiParameterDecoding', () {
+    test('default decodes RPN/NRPN and suppresses raw CCs', () {
+      const decoding = MidiParameterDecoding();
+      expect(decoding.flags, 1 | 2);
+      expect(decoding.fourteenBitMask, 0);
+    });
+
+    test('waitForLsb sets its flag', () {
+      const decoding = MidiParameterDecoding(
+        rpnNrpn: false,
+        suppressRaw: false,
+        waitForLsb: true,
+      );
+      expect(decoding.flags, 4);
+    });
+
+    test('fourteen-bit controllers map to mask bits', () {
+      const decoding = MidiParameterDecoding(
+        fourteenBitControllers: {1, 7, 11},
+      );
+      expect(decoding.fourteenBitMask, (1 << 1) | (1 << 7) | (1 << 11));
+    });
+
+    test('controllers above 31 are rejected', () {
+      const decoding = MidiParameterDecoding(fourteenBitControllers: {32});
+      expect(() => decoding.fourteenBitMask, throwsArgumentError);
+    });
+  });
 }
@@ -0,0 +1,41 @@
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:libremidi_flutter/libremidi_flutter.dart';
+
+void main() {
+  group('SysExChunk', () {
+    test('single chunk message is first and last', () {
+      final chunk = SysExChunk(
+        Uint8List.fromList([0xF0, 0x7E, 0xF7]),
+        flags: 1 | 4,
+      );
+      expect(chunk.isFirst, isTrue);
+      expect(chunk.isLast, isTrue);
+      expect(chunk.isAborted, isFalse);
+      expect(chunk.isTruncated, isFalse);
+    });
+
+    test('continuation chunk is neither first nor last', () {
+      final chunk = SysExChunk(Uint8List.fromList([1, 2, 3]), flags: 2);
+      expect(chunk.isFirst, isFalse);
+      expect(chunk.isLast, isFalse);
+    });
+
+    test('aborted and truncated end chunks', () {
+      final aborted = SysExChunk(Uint8List(0), flags: 2 | 4 | 8);
+      final truncated = SysExChunk(Uint8List(0), flags: 2 | 4 | 16);
+      expect(aborted.isLast, isTrue);
+      expect(aborted.isAborted, isTrue);
+      expect(truncated.isTruncated, isTrue);
+      expect(truncated.isAborted, isFalse);
+    });
+  });
+
+  group('MidiSysExOverflowPolicy', () {
+    test('native values', () {
+      expect(MidiSysExOverflowPolicy.abort.nativeValue, 0);
+      expect(MidiSysExOverflowPolicy.truncate.nativeValue, 1);
+    });
+  });
+}
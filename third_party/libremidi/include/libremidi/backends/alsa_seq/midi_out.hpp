@@ -3,6 +3,8 @@
 #include <libremidi/backends/alsa_seq/helpers.hpp>
 #include <libremidi/detail/midi_out.hpp>
 
+#include <chrono>
+
 NAMESPACE_LIBREMIDI::alsa_seq
 {
 
@@ -48,6 +50,8 @@ public:
     // Cleanup.
     if (this->vport >= 0)
       snd.seq.delete_port(this->seq, this->vport);
+    if (this->queue_id >= 0)
+      snd.seq.free_queue(this->seq, this->queue_id);
     if (this->coder)
       snd.midi.event_free(this->coder);
 
@@ -116,6 +120,121 @@ public:
   }
 
   stdx::error send_message(const unsigned char* message, std::size_t size) override
+  {
+    return output_events(message, size, nullptr);
+  }
+
+  int64_t current_time() const noexcept override
+  {
+    switch (configuration.timestamps)
+    {
+      case timestamp_mode::Absolute:
+        return this->queue_id >= 0 ? system_time() - this->queue_origin : 0;
+      default:
+        return system_time();
+    }
+  }
+
+  // The event encoder rejects a SysEx without its F7, so a piece is passed
+  // as a variable-length event, as the sequencer splits SysEx itself
+  stdx::error send_sysex_piece(const unsigned char* message, std::size_t size) override
+  {
+    snd_seq_event_t ev;
+    snd_seq_ev_clear(&ev);
+    snd_seq_ev_set_source(&ev, this->vport);
+    snd_seq_ev_set_subs(&ev);
+    snd_seq_ev_set_direct(&ev);
+    snd_seq_ev_set_sysex(&ev, (unsigned int)size, const_cast<unsigned char*>(message));
+
+    if (snd.seq.event_output(this->seq, &ev) < 0)
+    {
+      libremidi_handle_warning(this->configuration, "error sending MIDI message to port.");
+      return std::errc::io_error;
+    }
+    snd.seq.drain_output(this->seq);
+    return stdx::error{};
+  }
+
+  // Future events are stamped with a real-time timestamp on a queue owned by
+  // this client, so the kernel delivers them without waking us up.
+  // - Absolute: nanoseconds since the output queue was started
+  // - SystemMonotonic: nanoseconds on std::chrono::steady_clock
+  // - Relative: nanoseconds from now
+  // Other modes, and timestamps that are already due, are sent directly.
+  stdx::error schedule_message(int64_t ts, const unsigned char* message, std::size_t size) override
+  {
+    if (!start_queue())
+      return send_message(message, size);
+
+    int64_t queue_time{};
+    switch (configuration.timestamps)
+    {
+      case timestamp_mode::Absolute:
+        queue_time = ts;
+        break;
+      case timestamp_mode::SystemMonotonic:
+        queue_time = ts - this->queue_origin;
+        break;
+      case timestamp_mode::Relative:
+        queue_time = system_time() - this->queue_origin + ts;
+        break;
+      default:
+        return send_message(message, size);
+    }
+
+    if (queue_time <= system_time() - this->queue_origin)
+      return send_message(message, size);
+
+    const snd_seq_real_time_t when{
+        .tv_sec = static_cast<unsigned int>(queue_time / 1'000'000'000),
+        .tv_nsec = static_cast<unsigned int>(queue_time % 1'000'000'000)};
+    return output_events(message, size, &when);
+  }
+
+private:
+  static int64_t system_time() noexcept
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  // Allocates and starts the output queue on first use, and records the
+  // steady_clock time at which its real-time clock was zero.
+  bool start_queue()
+  {
+    if (this->queue_id >= 0)
+      return true;
+
+    const int queue = snd.seq.alloc_queue(this->seq);
+    if (queue < 0)
+      return false;
+    snd.seq.control_queue(this->seq, queue, SND_SEQ_EVENT_START, 0, nullptr);
+    snd.seq.drain_output(this->seq);
+
+    snd_seq_queue_status_t* status{};
+    snd_seq_queue_status_alloca(&status);
+    const int64_t before = system_time();
+    const int err = snd.seq.get_queue_status(this->seq, queue, status);
+    const int64_t after = system_time();
+    if (err < 0)
+    {
+      this->queue_origin = after;
+    }
+    else
+    {
+      const snd_seq_real_time_t* rt = snd.seq.queue_status_get_real_time(status);
+      this->queue_origin
+          = before + (after - before) / 2 - (int64_t(rt->tv_sec) * 1'000'000'000 + rt->tv_nsec);
+    }
+    this->queue_id = queue;
+    return true;
+  }
+
+  // Encodes the byte stream and outputs it either directly or, if `when` is
+  // set, scheduled at that real time on the output queue.
+  stdx::error
+  output_events(const unsigned char* message, std::size_t size, const snd_seq_real_time_t* when)
   {
     int64_t result{};
     if (size > this->m_bufferSize)
@@ -139,8 +258,16 @@ public:
       snd_seq_ev_clear(&ev);
       snd_seq_ev_set_source(&ev, this->vport);
       snd_seq_ev_set_subs(&ev);
-      // FIXME direct is set but snd_seq_event_output_direct is not used...
-      snd_seq_ev_set_direct(&ev);
+      // Scheduled events wait on the output queue; the others bypass it and
+      // are delivered as soon as event_output's buffer is drained
+      if (when)
+      {
+        snd_seq_ev_schedule_real(&ev, this->queue_id, 0, when);
+      }
+      else
+      {
+        snd_seq_ev_set_direct(&ev);
+      }
 
       const int64_t n_bytes = size; // signed to avoir potential overflow with size - offset below
       result = snd.midi.event_encode(this->coder, message + offset, (long)(n_bytes - offset), &ev);
@@ -169,7 +296,8 @@ public:
     return stdx::error{};
   }
 
-private:
   uint64_t m_bufferSize{32};
+  int queue_id{-1};
+  int64_t queue_origin{};
 };
 }
@@ -192,7 +192,7 @@ public:
 #if LIBREMIDI_HAS_UDEV
     if (p.card)
     {
-      auto res = get_udev_soundcard_info(m_udev, *p.card);
+      auto res = m_cards.get(m_udev, *p.card);
       container = res.container;
       device = res.path;
       type = res.type;
@@ -362,6 +362,7 @@ private:
 
 #if LIBREMIDI_HAS_UDEV
   udev_helper m_udev{};
+  mutable udev_soundcard_cache m_cards;
 #endif
 };
 
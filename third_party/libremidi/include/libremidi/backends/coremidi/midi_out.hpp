@@ -99,7 +99,8 @@ public:
       return std::errc::invalid_argument;
     }
 
-    if (message[0] != 0xF0 && nBytes > 3)
+    // Data bytes and F7 can only start the continuation of a split SysEx
+    if (message[0] != 0xF0 && message[0] != 0xF7 && message[0] >= 0x80 && nBytes > 3)
     {
       libremidi_handle_warning(
           configuration,
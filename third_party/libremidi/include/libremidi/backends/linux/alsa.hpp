@@ -262,6 +262,7 @@ struct libasound
       LIBREMIDI_SYMBOL_INIT(snd_seq, get_any_client_info)
       LIBREMIDI_SYMBOL_INIT(snd_seq, get_any_port_info)
       LIBREMIDI_SYMBOL_INIT(snd_seq, get_port_info)
+      LIBREMIDI_SYMBOL_INIT(snd_seq, get_queue_status)
       LIBREMIDI_SYMBOL_INIT(snd_seq, open)
       LIBREMIDI_SYMBOL_INIT(snd_seq, poll_descriptors)
       LIBREMIDI_SYMBOL_INIT(snd_seq, poll_descriptors_count)
@@ -289,6 +290,8 @@ struct libasound
       LIBREMIDI_SYMBOL_INIT(snd_seq, port_subscribe_set_time_update)
       LIBREMIDI_SYMBOL_INIT(snd_seq, query_next_client)
       LIBREMIDI_SYMBOL_INIT(snd_seq, query_next_port)
+      LIBREMIDI_SYMBOL_INIT(snd_seq, queue_status_get_real_time)
+      LIBREMIDI_SYMBOL_INIT(snd_seq, queue_status_sizeof)
       LIBREMIDI_SYMBOL_INIT(snd_seq, queue_tempo_set_ppq)
       LIBREMIDI_SYMBOL_INIT(snd_seq, queue_tempo_set_tempo)
       LIBREMIDI_SYMBOL_INIT(snd_seq, queue_tempo_sizeof)
@@ -327,6 +330,7 @@ struct libasound
     LIBREMIDI_SYMBOL_DEF(snd_seq, get_any_client_info)
     LIBREMIDI_SYMBOL_DEF(snd_seq, get_any_port_info)
     LIBREMIDI_SYMBOL_DEF(snd_seq, get_port_info)
+    LIBREMIDI_SYMBOL_DEF(snd_seq, get_queue_status)
     LIBREMIDI_SYMBOL_DEF(snd_seq, open)
     LIBREMIDI_SYMBOL_DEF(snd_seq, poll_descriptors)
     LIBREMIDI_SYMBOL_DEF(snd_seq, poll_descriptors_count)
@@ -354,6 +358,8 @@ struct libasound
     LIBREMIDI_SYMBOL_DEF(snd_seq, port_subscribe_set_time_update)
     LIBREMIDI_SYMBOL_DEF(snd_seq, query_next_client)
     LIBREMIDI_SYMBOL_DEF(snd_seq, query_next_port)
+    LIBREMIDI_SYMBOL_DEF(snd_seq, queue_status_get_real_time)
+    LIBREMIDI_SYMBOL_DEF(snd_seq, queue_status_sizeof)
     LIBREMIDI_SYMBOL_DEF(snd_seq, queue_tempo_set_ppq)
     LIBREMIDI_SYMBOL_DEF(snd_seq, queue_tempo_set_tempo)
     LIBREMIDI_SYMBOL_DEF(snd_seq, queue_tempo_sizeof)
@@ -527,6 +533,8 @@ struct libasound
 #define snd_seq_port_info_alloca(ptr) snd_dylib_alloca(ptr, seq, port_info)
 #undef snd_seq_port_subscribe_alloca
 #define snd_seq_port_subscribe_alloca(ptr) snd_dylib_alloca(ptr, seq, port_subscribe)
+#undef snd_seq_queue_status_alloca
+#define snd_seq_queue_status_alloca(ptr) snd_dylib_alloca(ptr, seq, queue_status)
 #undef snd_seq_queue_tempo_alloca
 #define snd_seq_queue_tempo_alloca(ptr) snd_dylib_alloca(ptr, seq, queue_tempo)
 
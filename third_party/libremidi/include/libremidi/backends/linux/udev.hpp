@@ -6,7 +6,11 @@
 #include <libudev.h>
 
 #include <cassert>
+#include <cstdlib>
+#include <map>
+#include <mutex>
 #include <optional>
+#include <string_view>
 
 NAMESPACE_LIBREMIDI
 {
@@ -226,4 +230,63 @@ inline udev_soundcard_info get_udev_soundcard_info(const udev_helper& helper, in
   }
   return {};
 }
+
+// Caches get_udev_soundcard_info per card, so that enumerating ports costs one
+// udev walk per new card instead of one per port and enumeration.
+// udev events of the sound subsystem pending on the helper's monitor are
+// applied before each lookup: a card that was removed or changed is looked up
+// again, as its number can be reused by the next device that is plugged in.
+class udev_soundcard_cache
+{
+public:
+  udev_soundcard_info get(const udev_helper& helper, int card)
+  {
+    std::lock_guard lock{m_mutex};
+    apply_events(helper);
+
+    auto it = m_cards.find(card);
+    if (it == m_cards.end())
+      it = m_cards.emplace(card, get_udev_soundcard_info(helper, card)).first;
+    return it->second;
+  }
+
+private:
+  void apply_events(const udev_helper& helper)
+  {
+    auto& udev = helper.udev;
+    // The monitor socket is non-blocking: this returns nullptr once drained
+    while (auto dev = udev.monitor_receive_device(helper.monitor))
+    {
+      auto subsystem = udev.device_get_subsystem(dev);
+      if (subsystem && std::string_view{subsystem} == "sound")
+      {
+        if (auto card = card_of(udev.device_get_property_value(dev, "DEVPATH")))
+          m_cards.erase(*card);
+        else
+          m_cards.clear();
+      }
+      udev.device_unref(dev);
+    }
+  }
+
+  // e.g. /devices/pci0000:00/.../sound/card2/midiC2D0 -> 2
+  static std::optional<int> card_of(const char* devpath)
+  {
+    if (!devpath)
+      return std::nullopt;
+    std::string_view path{devpath};
+    const auto pos = path.find("/sound/card");
+    if (pos == std::string_view::npos)
+      return std::nullopt;
+    const char* digits = devpath + pos + 11;
+    char* end{};
+    const long card = std::strtol(digits, &end, 10);
+    if (end == digits)
+      return std::nullopt;
+    return static_cast<int>(card);
+  }
+
+  std::mutex m_mutex;
+  std::map<int, udev_soundcard_info> m_cards;
+};
 }
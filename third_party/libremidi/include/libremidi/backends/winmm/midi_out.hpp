@@ -90,8 +90,8 @@ public:
       return std::errc::invalid_argument;
     }
 
-    if (message[0] == 0xF0)
-    { // Sysex message
+    if (message[0] == 0xF0 || message[0] == 0xF7 || message[0] < 0x80)
+    { // Sysex message, or the continuation of one sent in pieces
 
       buffer.assign(message, message + size);
 
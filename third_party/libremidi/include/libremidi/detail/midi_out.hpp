@@ -32,6 +32,13 @@ public:
     return send_message(message, size);
   }
 
+  //! Part of a SysEx message sent in several pieces: the first piece starts
+  //! with F0 and only the last one ends with F7
+  virtual stdx::error send_sysex_piece(const unsigned char* message, std::size_t size)
+  {
+    return send_message(message, size);
+  }
+
   virtual stdx::error send_ump(const uint32_t* message, std::size_t size) = 0;
   virtual stdx::error schedule_ump(int64_t /*ts*/, const uint32_t* ump, std::size_t size)
   {
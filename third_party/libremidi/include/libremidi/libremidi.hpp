@@ -226,9 +226,14 @@ public:
   int64_t current_time();
 
   //! Try to schedule a message later in time if the underlying API supports it
-  //! (currently not implemented anywhere)
+  //! (currently the ALSA sequencer; other APIs send immediately)
   stdx::error schedule_message(int64_t timestamp, const unsigned char* message, size_t size) const;
 
+  //! Immediately send part of a SysEx message transmitted in several pieces:
+  //! the first piece starts with F0 and only the last one ends with F7.
+  //! APIs that cannot pass a SysEx through in pieces treat it as a message.
+  stdx::error send_sysex_piece(const unsigned char* message, size_t size) const;
+
   //! Immediately send a single UMP packet to an open MIDI output port.
   stdx::error send_ump(const uint32_t* message, size_t size) const;
   stdx::error send_ump(const libremidi::ump&) const;
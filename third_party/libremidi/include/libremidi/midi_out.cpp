@@ -250,6 +250,16 @@ stdx::error midi_out::schedule_message(int64_t ts, const unsigned char* message,
   return m_impl->schedule_message(ts, message, size);
 }
 
+LIBREMIDI_INLINE
+stdx::error midi_out::send_sysex_piece(const unsigned char* message, size_t size) const
+{
+#if defined(LIBREMIDI_ASSERTIONS)
+  assert(size > 0);
+#endif
+
+  return m_impl->send_sysex_piece(message, size);
+}
+
 LIBREMIDI_INLINE
 stdx::error midi_out::send_ump(const uint32_t* message, size_t size) const
 {